@@ -106,6 +106,15 @@ public:
    */
   explicit IndexSet(const size_type size);
 
+  /**
+   * Constructor that sets the overall size of the index range to @p size and
+   * adds all elements of @p indices to the set. This is equivalent to
+   * calling add_indices() on an empty index set of the given size, and is
+   * most efficient if @p indices is sorted, in which case the intervals of
+   * the index set are built in a single pass over the array.
+   */
+  IndexSet(const size_type size, const std::vector<size_type> &indices);
+
   /**
    * Copy constructor.
    */
@@ -355,6 +364,13 @@ public:
    * i.e. a set of indices that are elements of both index sets. The two index
    * sets must have the same size (though of course they do not have to have
    * the same number of indices).
+   *
+   * The cost of this operation is linear in the number of intervals of the
+   * index set with fewer intervals and logarithmic in the number of
+   * intervals of the other one, which makes the intersection of a set with
+   * few intervals (e.g., a locally owned range) with a set with many
+   * intervals cheap. If both sets consist of many intervals, the work is
+   * split among several threads.
    */
   IndexSet
   operator&(const IndexSet &is) const;
@@ -1590,6 +1606,18 @@ inline IndexSet::IndexSet(const size_type size)
 
 
 
+inline IndexSet::IndexSet(const size_type               size,
+                          const std::vector<size_type> &indices)
+  : is_compressed(true)
+  , index_space_size(size)
+  , largest_range(numbers::invalid_unsigned_int)
+{
+  add_indices(indices.begin(), indices.end());
+  compress();
+}
+
+
+
 inline IndexSet::IndexSet(IndexSet &&is) noexcept
   : ranges(std::move(is.ranges))
   , is_compressed(is.is_compressed)
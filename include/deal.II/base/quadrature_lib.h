@@ -957,6 +957,51 @@ public:
                                     const bool         use_odd_order = true);
 };
 
+/**
+ * Integration rule for simplex entities that is obtained by collapsing a
+ * tensor-product Gauss formula on the unit hypercube onto the simplex (also
+ * known as Duffy transformation). The collapsed coordinates
+ * $(\xi,\eta,\zeta) \in [0,1]^3$ are mapped to the reference tetrahedron
+ * by
+ * @f[
+ *   x = \xi (1-\eta) (1-\zeta), \quad y = \eta (1-\zeta), \quad
+ *   z = \zeta,
+ * @f]
+ * and analogously in 2d with $x = \xi (1-\eta)$, $y = \eta$. The
+ * quadrature weights contain the determinant $(1-\eta)$ in 2d and
+ * $(1-\eta)(1-\zeta)^2$ in 3d of the Jacobian of this transformation. With
+ * $n$ points per direction, the rule is exact for polynomials of degree
+ * $2n-2$ in 2d and $2n-3$ in 3d, and thus needs more points than
+ * QGaussSimplex for the same accuracy. The points are numbered
+ * lexicographically in the collapsed coordinates, with $\xi$ running
+ * fastest.
+ *
+ * Since a polynomial of total degree $k$ on the simplex is a polynomial of
+ * degree $k$ in each of the collapsed coordinates, this structure allows to
+ * evaluate gradients of FE_SimplexP and FE_SimplexDGP elements with sum
+ * factorization in the collapsed coordinates. MatrixFree detects this type
+ * of quadrature formula automatically and then uses sum factorization for
+ * the evaluation of gradients (see
+ * internal::MatrixFreeFunctions::ShapeInfo::n_q_points_1d_collapsed), which
+ * makes FEEvaluation considerably faster for higher polynomial degrees.
+ *
+ * For 1d, the quadrature rule degenerates to a
+ * `dealii::QGauss<1>(n_points_1d)`.
+ *
+ * Also see
+ * @ref simplex "Simplex support".
+ */
+template <int dim>
+class QGaussCollapsedSimplex : public QSimplex<dim>
+{
+public:
+  /**
+   * Constructor taking the number of quadrature points in each of the
+   * collapsed coordinate directions.
+   */
+  explicit QGaussCollapsedSimplex(const unsigned int n_points_1D);
+};
+
 /**
  * Iterated quadrature for simplices. Since simplex cannot be described as
  * tensor products the base quadrature has equal dimension.
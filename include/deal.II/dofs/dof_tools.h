@@ -417,6 +417,11 @@ namespace DoFTools
    * need to remember using SparsityPattern::compress() after generating the
    * pattern.
    *
+   * @note If the sparsity pattern is of type DynamicSparsityPattern and more
+   * than one thread is available (see MultithreadInfo), the rows of the
+   * sparsity pattern are split into ranges that are filled by different
+   * threads concurrently. The result is the same as with a single thread.
+   *
    * @ingroup constraints
    */
   template <int dim, int spacedim, typename number = double>
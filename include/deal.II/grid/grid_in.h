@@ -24,6 +24,7 @@
 #include <deal.II/base/smartpointer.h>
 
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,7 @@ DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
 class Triangulation;
 template <int dim>
 struct CellData;
+struct SubCellData;
 #endif
 
 /**
@@ -518,12 +520,77 @@ public:
    * Read grid data from an msh file. The %Gmsh formats are documented at
    * http://www.gmsh.info/.
    *
+   * The lines of the nodes and elements sections, which %Gmsh writes with
+   * one node or element per line, are read in chunks, and the numbers in
+   * each chunk are converted in parallel, see the
+   * @ref threads "Parallel computing with multiple processors"
+   * topic. Consequently, each node and each element has to be given on a
+   * single line, whereas empty lines between them are skipped. Parametric
+   * coordinates of the nodes are ignored.
+   *
    * Also see
    * @ref simplex "Simplex support".
    */
   void
   read_msh(std::istream &in);
 
+  /**
+   * Read the part with number @p slice out of @p n_slices equally sized
+   * parts of a mesh in the %Gmsh msh format, without setting up a
+   * triangulation. This is intended for meshes too large to be held by a
+   * single process: each process reads its slice of the file, and the
+   * result can be passed to
+   * TriangulationDescription::Utilities::create_description_from_distributed_coarse_mesh()
+   * to create a parallel::fullydistributed::Triangulation.
+   *
+   * @code
+   * std::vector<Point<dim>>    vertices;
+   * std::vector<CellData<dim>> cells;
+   * SubCellData                subcell_data;
+   * std::ifstream              in("mesh.msh");
+   * GridIn<dim>::read_msh_slice(in,
+   *                             Utilities::MPI::this_mpi_process(comm),
+   *                             Utilities::MPI::n_mpi_processes(comm),
+   *                             vertices,
+   *                             cells,
+   *                             subcell_data);
+   *
+   * parallel::fullydistributed::Triangulation<dim> tria(comm);
+   * tria.create_triangulation(
+   *   TriangulationDescription::Utilities::
+   *     create_description_from_distributed_coarse_mesh<dim, dim>(
+   *       vertices, cells, subcell_data, comm));
+   * @endcode
+   *
+   * The vertices are numbered in the order of the nodes in the file, and
+   * @p vertices contains the nodes with numbers in the range
+   * $[n_\text{nodes}\,\text{slice}/n_\text{slices},
+   * n_\text{nodes}\,(\text{slice}+1)/n_\text{slices})$. In the same way,
+   * the elements of the file (cells, faces, and lines) are split into
+   * ranges, and @p cells and @p subcell_data contain the elements of the
+   * respective range, with vertex indices referring to the global
+   * numbering of the nodes. The whole file is read, but only the numbers of
+   * the respective slice are converted and stored. The mapping from the
+   * node tags in the file to the vertex numbers is held by each process;
+   * it takes no memory if the nodes have consecutive tags in the order
+   * of the file, as %Gmsh writes them, and one integer per node
+   * otherwise.
+   *
+   * In contrast to read_msh(), the cells are returned as given in the file:
+   * GridTools::delete_unused_vertices(),
+   * GridTools::invert_cells_with_negative_measure(), and
+   * GridTools::consistently_order_cells(), which read_msh() applies to the
+   * mesh, need all of the cells. In 1d, the boundary ids given for vertices
+   * are ignored.
+   */
+  static void
+  read_msh_slice(std::istream                 &in,
+                 const unsigned int            slice,
+                 const unsigned int            n_slices,
+                 std::vector<Point<spacedim>> &vertices,
+                 std::vector<CellData<dim>>   &cells,
+                 SubCellData                  &subcell_data);
+
 #ifdef DEAL_II_GMSH_WITH_API
   /**
    * Read grid data using Gmsh API. Any file supported by Gmsh can be passed as
@@ -911,6 +978,23 @@ protected:
                     std::ostream                       &out);
 
 private:
+  /**
+   * Read the part with number @p slice out of @p n_slices parts of a mesh in
+   * the %Gmsh msh format, see read_msh_slice(). The maps
+   * @p boundary_ids_1d and @p vertex_counts are only filled in 1d, with the
+   * boundary ids given for vertices and the number of cells each vertex is
+   * part of, respectively.
+   */
+  static void
+  read_msh_data(std::istream                               &in,
+                const unsigned int                          slice,
+                const unsigned int                          n_slices,
+                std::vector<Point<spacedim>>               &vertices,
+                std::vector<CellData<dim>>                 &cells,
+                SubCellData                                &subcell_data,
+                std::map<unsigned int, types::boundary_id> &boundary_ids_1d,
+                std::map<unsigned int, unsigned int>       &vertex_counts);
+
   /**
    * Skip empty lines in the input stream, i.e. lines that contain either
    * nothing or only whitespace.
@@ -531,6 +531,42 @@ namespace GridTools
   void
   consistently_order_cells(std::vector<CellData<dim>> &cells);
 
+  /**
+   * Rebuild the given triangulation such that the cells on each level are
+   * stored in the order of a space-filling curve. The coarse cells are
+   * sorted along the Hilbert curve through their centers, and the cells on
+   * the finer levels follow the order of their parents, with the children of
+   * each cell in the order of their child indices, i.e., the same ordering
+   * p4est uses for parallel::distributed::Triangulation. The vertices are
+   * renumbered in the order in which they are first used by the cells.
+   *
+   * After several cycles of adaptive refinement and coarsening, the cells of
+   * a Triangulation are stored in the order in which they were created,
+   * which is essentially random. Loops over the active cells, as well as the
+   * accesses to the vertices and neighbors of the cells in such loops, then
+   * jump through memory. With the ordering created by this function, cells
+   * that are close in space are also close in memory, which gives better
+   * cache reuse in assembly loops. Since the refinement history is
+   * recreated, the resulting mesh is identical to the input: the cells, the
+   * locations of the vertices, the material, manifold, boundary, and
+   * subdomain ids, and the attached manifolds are preserved. Only the order
+   * of the cells and the indices of cells and vertices change.
+   *
+   * The triangulation is cleared and recreated, so all objects that depend on
+   * it, such as DoFHandler objects, need to be re-initialized, and user flags,
+   * user indices and user pointers are not preserved. The function is meant
+   * to be called after refinement, e.g., once the final mesh of an adaptive
+   * cycle has been created and before DoFHandler::distribute_dofs().
+   *
+   * @note This function is only implemented for serial triangulations
+   * without periodic faces. The cells of
+   * parallel::distributed::Triangulation are already ordered along a
+   * space-filling curve by p4est.
+   */
+  template <int dim, int spacedim>
+  void
+  order_cells_along_space_filling_curve(Triangulation<dim, spacedim> &tria);
+
   /** @} */
   /**
    * @name Rotating, stretching and otherwise transforming meshes
@@ -3605,16 +3605,33 @@ public:
 
 
   /**
-   * Save the triangulation into the given file. Internally, this
-   * function calls the save function which uses BOOST archives. This
-   * is a placeholder implementation that, in the near future, will also
-   * attach the data associated with the triangulation
+   * Save the triangulation into the given file. The same information as in
+   * the save() function for BOOST archives is written, but in a flat binary
+   * format: after a header with a version number and the dimensions, each
+   * of the internal arrays of the triangulation (the vertices and, for all
+   * levels and faces, the connectivity, the refinement and orientation
+   * flags, the ids, the user flags, and the user indices) is written as one
+   * contiguous block of bytes. This avoids the overhead of the text format
+   * of BOOST archives, which makes a difference for large meshes.
+   *
+   * The file uses the byte order and the sizes of the integer types of the
+   * current machine and configuration, so it is meant for checkpointing and
+   * restarting on the same machine rather than for exchanging meshes.
+   *
+   * This is a placeholder implementation that, in the near future, will also
+   * attach the data associated with the triangulation.
    */
   virtual void
   save(const std::string &filename) const;
 
   /**
-   * Load the triangulation saved with save() back in.
+   * Load the triangulation saved with save() back in. Each of the internal
+   * arrays is read with a single copy from the file, and only the caches
+   * that are not stored in the file, such as the active cell indices, are
+   * rebuilt; in particular, no cells have to be created or refined.
+   *
+   * Files written by earlier versions of save(), which contain a text
+   * archive of BOOST, can also be read.
    */
   virtual void
   load(const std::string &filename);
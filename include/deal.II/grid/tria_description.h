@@ -650,6 +650,94 @@ namespace TriangulationDescription
       const TriangulationDescription::Settings setting =
         TriangulationDescription::Settings::default_setting);
 
+    /**
+     * Construct a TriangulationDescription::Description for a coarse mesh
+     * of which each process only knows a slice, without ever creating a
+     * serial triangulation of the whole mesh on any process. This allows to
+     * set up a parallel::fullydistributed::Triangulation from a coarse mesh
+     * that is too large to fit into the memory of a single node, e.g., from
+     * a mesh file that has been read in parallel by each process reading a
+     * part of the vertices and of the cells.
+     *
+     * The vertices of all processes, concatenated in the order of the ranks,
+     * form the global vertex array, i.e., the first vertex in @p vertices has
+     * the global index equal to the number of vertices given on the
+     * processes with lower rank. The cells in @p cells can be distributed
+     * arbitrarily among the processes and refer to vertices by their global
+     * index. The same is true for the boundary and manifold ids of faces
+     * (and, in 3d, the manifold ids of lines) given in @p subcell_data.
+     *
+     * The function proceeds as follows:
+     * - The centers of the cells are computed, which requires to fetch the
+     *   vertices of the cells from the processes storing them.
+     * - The cells are sorted along a Hilbert space-filling curve through
+     *   their centers, and the curve is cut into pieces with (up to cells
+     *   with the same index on the curve) the same number of cells. The
+     *   piece number $p$ is owned by the process with rank $p$. The cuts
+     *   are determined by a bisection of the index space of the curve,
+     *   so that no process ever needs to know all cells.
+     * - The cells are sent to their owners, and each process sends its
+     *   locally owned cells to all processes that own a cell sharing a
+     *   vertex with them, which form the ghost layer on the receiving
+     *   process. The processes that share a vertex are determined by the
+     *   process storing the vertex.
+     * - The vertices, boundary ids, and manifold ids of the locally
+     *   relevant cells are requested from the processes storing them.
+     *
+     * All of the communication is done via the algorithms in
+     * Utilities::MPI::ConsensusAlgorithms, such that the communication and
+     * memory cost on each process only depends on the size of its slice of
+     * the mesh and of the locally relevant part of the mesh. The coarse
+     * cells are numbered along the space-filling curve, i.e., the
+     * @ref GlossCoarseCellId "coarse-cell ids" of the cells owned by a
+     * process form a contiguous range, and those of processes with lower
+     * rank come first.
+     *
+     * @code
+     * // each process reads its part of the vertices and cells (not shown)
+     * std::vector<Point<dim>>    vertices;
+     * std::vector<CellData<dim>> cells;
+     *
+     * // partition the mesh and create the description
+     * const TriangulationDescription::Description<dim, dim> description =
+     *   TriangulationDescription::Utilities::
+     *     create_description_from_distributed_coarse_mesh<dim, dim>(
+     *       vertices, cells, SubCellData(), comm);
+     *
+     * // create triangulation
+     * parallel::fullydistributed::Triangulation<dim> tria_pft(comm);
+     * tria_pft.create_triangulation(description);
+     * @endcode
+     *
+     * @param vertices The slice of the global vertex array stored on this
+     *   process.
+     * @param cells The cells given on this process, with vertex indices
+     *   referring to the global vertex array.
+     * @param subcell_data Boundary ids and manifold ids of faces and lines
+     *   given on this process, with vertex indices referring to the global
+     *   vertex array. Faces not listed here are assigned the default
+     *   boundary id zero and the flat manifold id.
+     * @param comm MPI communicator.
+     * @param smoothing Mesh smoothing type.
+     * @param settings See the description of the Settings enumerator.
+     * @return Description to be used to set up a Triangulation.
+     *
+     * @note Periodic boundaries are not taken into account when determining
+     *   the ghost layer. In 1d, boundary ids cannot be prescribed and the
+     *   boundary vertices have the default boundary ids.
+     */
+    template <int dim, int spacedim = dim>
+    Description<dim, spacedim>
+    create_description_from_distributed_coarse_mesh(
+      const std::vector<Point<spacedim>>       &vertices,
+      const std::vector<dealii::CellData<dim>> &cells,
+      const SubCellData                        &subcell_data,
+      const MPI_Comm                            comm,
+      const typename Triangulation<dim, spacedim>::MeshSmoothing smoothing =
+        dealii::Triangulation<dim, spacedim>::none,
+      const TriangulationDescription::Settings settings =
+        TriangulationDescription::Settings::default_setting);
+
   } // namespace Utilities
 
 
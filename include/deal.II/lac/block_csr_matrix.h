@@ -0,0 +1,736 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_block_csr_matrix_h
+#define dealii_block_csr_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/exceptions.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Matrix1
+ * @{
+ */
+
+/**
+ * A sparse matrix in the block compressed sparse row (BSR) format with dense
+ * blocks of a size @p block_size that is fixed at compile time.
+ *
+ * The rows and columns of the matrix are grouped into consecutive sets of
+ * @p block_size indices, and the matrix stores a dense
+ * <tt>block_size x block_size</tt> block for every pair of such sets in
+ * which the underlying sparsity pattern has at least one entry. This is the
+ * natural structure of matrices stemming from vector-valued finite elements
+ * like <tt>FESystem<dim>(FE_Q<dim>(degree), dim)</tt> if the degrees of
+ * freedom of all components located at the same support point are numbered
+ * consecutively, which can be achieved by DoFRenumbering::support_point_wise().
+ * Compared to SparseMatrix, only one column index needs to be stored per
+ * block, i.e., the index storage is reduced by a factor of
+ * <tt>block_size*block_size</tt>, and the matrix-vector products work on
+ * small dense blocks whose loops are fully unrolled by the compiler. On the
+ * other hand, entries inside a block that are not in the sparsity pattern
+ * are stored explicitly as zeros. Unlike ChunkSparseMatrix, whose chunk size
+ * is a run-time parameter, the block size is a template argument so that
+ * the kernels are specialized for it.
+ *
+ * The matrix can be filled in through the add() functions, which means that
+ * it can be passed to AffineConstraints::distribute_local_to_global() like
+ * a SparseMatrix:
+ * @code
+ * DoFRenumbering::support_point_wise(dof_handler);
+ * DynamicSparsityPattern dsp(dof_handler.n_dofs());
+ * DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+ *
+ * BlockCSRMatrix<double, dim> system_matrix(dsp);
+ * for (const auto &cell : dof_handler.active_cell_iterators())
+ *   {
+ *     // ... compute cell_matrix ...
+ *     cell->get_dof_indices(local_dof_indices);
+ *     constraints.distribute_local_to_global(cell_matrix,
+ *                                            local_dof_indices,
+ *                                            system_matrix);
+ *   }
+ * @endcode
+ * Since AffineConstraints only provides precompiled instantiations for the
+ * matrix types of the library, programs using this class together with
+ * AffineConstraints::distribute_local_to_global() need to include the file
+ * <tt>deal.II/lac/affine_constraints.templates.h</tt>.
+ *
+ * The vectors used in the matrix-vector products need to store their
+ * elements contiguously in memory with direct access through
+ * <tt>begin()</tt>, which is the case for Vector and serial
+ * LinearAlgebra::distributed::Vector objects.
+ *
+ * @tparam number The number type of the matrix entries.
+ * @tparam block_size The number of rows and columns of each dense block.
+ */
+template <typename number, int block_size>
+class BlockCSRMatrix : public Subscriptor
+{
+public:
+  static_assert(block_size > 0, "The block size must be positive.");
+
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = number;
+
+  /**
+   * Default constructor. The object needs to be initialized with reinit()
+   * before it can be used.
+   */
+  BlockCSRMatrix();
+
+  /**
+   * Constructor. Equivalent to calling reinit() with the given sparsity
+   * pattern.
+   */
+  template <typename SparsityPatternType>
+  explicit BlockCSRMatrix(const SparsityPatternType &sparsity);
+
+  /**
+   * Set up the block structure from the given (scalar) sparsity pattern and
+   * set all entries to zero. A block is stored whenever at least one of its
+   * entries is part of @p sparsity. The number of rows and columns of
+   * @p sparsity must be multiples of @p block_size.
+   *
+   * @p SparsityPatternType may be SparsityPattern or DynamicSparsityPattern,
+   * or any other class providing the functions <tt>n_rows()</tt>,
+   * <tt>n_cols()</tt>, and iterators over the entries of a row through
+   * <tt>begin(row)</tt> and <tt>end(row)</tt>.
+   */
+  template <typename SparsityPatternType>
+  void
+  reinit(const SparsityPatternType &sparsity);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of rows of the matrix.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the number of columns of the matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of rows of blocks, i.e., m()/block_size.
+   */
+  size_type
+  n_row_blocks() const;
+
+  /**
+   * Return the number of columns of blocks, i.e., n()/block_size.
+   */
+  size_type
+  n_col_blocks() const;
+
+  /**
+   * Return the number of stored blocks.
+   */
+  std::size_t
+  n_nonzero_blocks() const;
+
+  /**
+   * Return the number of stored entries, i.e., the number of blocks times
+   * <tt>block_size*block_size</tt>.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Set all entries of the matrix to the given value, which must be zero.
+   */
+  BlockCSRMatrix &
+  operator=(const number d);
+
+  /**
+   * Add @p value to the entry <tt>(i,j)</tt>. The block containing the
+   * entry must be part of the block structure.
+   */
+  void
+  add(const size_type i, const size_type j, const number value);
+
+  /**
+   * Add the given values to the entries of row @p row with column indices
+   * @p col_indices. This is the interface used by
+   * AffineConstraints::distribute_local_to_global(). If the column indices
+   * are sorted, the blocks of the row are found by a single pass through
+   * the block row, otherwise by binary search.
+   */
+  template <typename number2>
+  void
+  add(const size_type  row,
+      const size_type  n_cols,
+      const size_type *col_indices,
+      const number2   *values,
+      const bool       elide_zero_values      = true,
+      const bool       col_indices_are_sorted = false);
+
+  /**
+   * Return the value of the entry <tt>(i,j)</tt>, or zero if the block
+   * containing the entry is not stored.
+   */
+  number
+  el(const size_type i, const size_type j) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M*src$ with $M$ being this
+   * matrix.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding matrix-vector multiplication: add $M*src$ to $dst$ with $M$ being
+   * this matrix.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <typename VectorType>
+  void
+  vmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M^T*src$ with $M$ being this
+   * matrix.
+   */
+  template <typename VectorType>
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding matrix-vector multiplication: add $M^T*src$ to $dst$ with $M$
+   * being this matrix.
+   */
+  template <typename VectorType>
+  void
+  Tvmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception
+   */
+  DeclException2(ExcInvalidIndex,
+                 size_type,
+                 size_type,
+                 << "You are trying to access the matrix entry with index <"
+                 << arg1 << ',' << arg2
+                 << ">, but the block containing this entry is not part of "
+                    "the block structure of the matrix.");
+
+  /**
+   * Exception
+   */
+  DeclException1(ExcSizeNotDivisible,
+                 size_type,
+                 << "The size " << arg1
+                 << " of the sparsity pattern is not a multiple of the block "
+                    "size.");
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcSourceEqualsDestination,
+                   "You are attempting an operation on two vectors that "
+                   "are the same object, but the operation requires that the "
+                   "two objects are in fact different.");
+
+private:
+  /**
+   * Apply the matrix to @p src on the block rows in the range
+   * [begin_block_row, end_block_row).
+   */
+  template <typename Number2>
+  void
+  vmult_on_subrange(const size_type begin_block_row,
+                    const size_type end_block_row,
+                    const Number2  *src,
+                    Number2        *dst,
+                    const bool      add) const;
+
+  /**
+   * Return the position of the block (block_row, block_col) in the arrays
+   * of this object, or numbers::invalid_size_type if it is not stored.
+   */
+  std::size_t
+  find_block(const size_type block_row, const size_type block_col) const;
+
+  /**
+   * Number of rows of blocks.
+   */
+  size_type n_block_rows;
+
+  /**
+   * Number of columns of blocks.
+   */
+  size_type n_block_cols;
+
+  /**
+   * The index of the first block of each block row in @p block_columns.
+   */
+  std::vector<std::size_t> rowstart;
+
+  /**
+   * The column index of each block, sorted within each block row.
+   */
+  std::vector<size_type> block_columns;
+
+  /**
+   * The entries of all blocks, with the entries of each block stored
+   * contiguously in row-major order.
+   */
+  AlignedVector<number> values;
+};
+
+/**
+ * @}
+ */
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+template <typename number, int block_size>
+inline BlockCSRMatrix<number, block_size>::BlockCSRMatrix()
+  : n_block_rows(0)
+  , n_block_cols(0)
+{}
+
+
+
+template <typename number, int block_size>
+template <typename SparsityPatternType>
+inline BlockCSRMatrix<number, block_size>::BlockCSRMatrix(
+  const SparsityPatternType &sparsity)
+  : BlockCSRMatrix()
+{
+  reinit(sparsity);
+}
+
+
+
+template <typename number, int block_size>
+template <typename SparsityPatternType>
+inline void
+BlockCSRMatrix<number, block_size>::reinit(const SparsityPatternType &sparsity)
+{
+  AssertThrow(sparsity.n_rows() % block_size == 0,
+              ExcSizeNotDivisible(sparsity.n_rows()));
+  AssertThrow(sparsity.n_cols() % block_size == 0,
+              ExcSizeNotDivisible(sparsity.n_cols()));
+
+  n_block_rows = sparsity.n_rows() / block_size;
+  n_block_cols = sparsity.n_cols() / block_size;
+
+  rowstart.resize(n_block_rows + 1);
+  rowstart[0] = 0;
+  block_columns.clear();
+
+  std::vector<size_type> columns_of_block_row;
+  for (size_type block_row = 0; block_row < n_block_rows; ++block_row)
+    {
+      columns_of_block_row.clear();
+      for (unsigned int r = 0; r < block_size; ++r)
+        {
+          const size_type row = block_row * block_size + r;
+          for (auto entry = sparsity.begin(row); entry != sparsity.end(row);
+               ++entry)
+            columns_of_block_row.push_back(entry->column() / block_size);
+        }
+      std::sort(columns_of_block_row.begin(), columns_of_block_row.end());
+      columns_of_block_row.erase(std::unique(columns_of_block_row.begin(),
+                                             columns_of_block_row.end()),
+                                 columns_of_block_row.end());
+
+      block_columns.insert(block_columns.end(),
+                           columns_of_block_row.begin(),
+                           columns_of_block_row.end());
+      rowstart[block_row + 1] = block_columns.size();
+    }
+
+  values.resize_fast(block_columns.size() * block_size * block_size);
+  values.fill(number());
+}
+
+
+
+template <typename number, int block_size>
+inline void
+BlockCSRMatrix<number, block_size>::clear()
+{
+  n_block_rows = 0;
+  n_block_cols = 0;
+  rowstart.clear();
+  block_columns.clear();
+  values.clear();
+}
+
+
+
+template <typename number, int block_size>
+inline typename BlockCSRMatrix<number, block_size>::size_type
+BlockCSRMatrix<number, block_size>::m() const
+{
+  return n_block_rows * block_size;
+}
+
+
+
+template <typename number, int block_size>
+inline typename BlockCSRMatrix<number, block_size>::size_type
+BlockCSRMatrix<number, block_size>::n() const
+{
+  return n_block_cols * block_size;
+}
+
+
+
+template <typename number, int block_size>
+inline typename BlockCSRMatrix<number, block_size>::size_type
+BlockCSRMatrix<number, block_size>::n_row_blocks() const
+{
+  return n_block_rows;
+}
+
+
+
+template <typename number, int block_size>
+inline typename BlockCSRMatrix<number, block_size>::size_type
+BlockCSRMatrix<number, block_size>::n_col_blocks() const
+{
+  return n_block_cols;
+}
+
+
+
+template <typename number, int block_size>
+inline std::size_t
+BlockCSRMatrix<number, block_size>::n_nonzero_blocks() const
+{
+  return block_columns.size();
+}
+
+
+
+template <typename number, int block_size>
+inline std::size_t
+BlockCSRMatrix<number, block_size>::n_nonzero_elements() const
+{
+  return values.size();
+}
+
+
+
+template <typename number, int block_size>
+inline BlockCSRMatrix<number, block_size> &
+BlockCSRMatrix<number, block_size>::operator=(const number d)
+{
+  (void)d;
+  Assert(d == number(), ExcScalarAssignmentOnlyForZeroValue());
+
+  values.fill(number());
+  return *this;
+}
+
+
+
+template <typename number, int block_size>
+inline std::size_t
+BlockCSRMatrix<number, block_size>::find_block(const size_type block_row,
+                                               const size_type block_col) const
+{
+  const auto begin = block_columns.begin() + rowstart[block_row];
+  const auto end   = block_columns.begin() + rowstart[block_row + 1];
+  const auto it    = std::lower_bound(begin, end, block_col);
+  if (it != end && *it == block_col)
+    return it - block_columns.begin();
+  else
+    return numbers::invalid_size_type;
+}
+
+
+
+template <typename number, int block_size>
+inline void
+BlockCSRMatrix<number, block_size>::add(const size_type i,
+                                        const size_type j,
+                                        const number    value)
+{
+  AssertIndexRange(i, m());
+  AssertIndexRange(j, n());
+
+  const std::size_t block = find_block(i / block_size, j / block_size);
+  Assert(block != numbers::invalid_size_type, ExcInvalidIndex(i, j));
+
+  values[(block * block_size + i % block_size) * block_size + j % block_size] +=
+    value;
+}
+
+
+
+template <typename number, int block_size>
+template <typename number2>
+inline void
+BlockCSRMatrix<number, block_size>::add(const size_type  row,
+                                        const size_type  n_cols,
+                                        const size_type *col_indices,
+                                        const number2   *input_values,
+                                        const bool       elide_zero_values,
+                                        const bool       col_indices_are_sorted)
+{
+  AssertIndexRange(row, m());
+
+  const size_type   block_row    = row / block_size;
+  const std::size_t row_in_block = row % block_size;
+
+  const auto row_begin = block_columns.begin() + rowstart[block_row];
+  const auto row_end   = block_columns.begin() + rowstart[block_row + 1];
+  auto       current_column = row_begin;
+
+  for (size_type k = 0; k < n_cols; ++k)
+    {
+      if (elide_zero_values && input_values[k] == number2())
+        continue;
+
+      const size_type col       = col_indices[k];
+      const size_type block_col = col / block_size;
+      AssertIndexRange(col, n());
+
+      // with sorted indices, the block of this column can only be at or
+      // behind the block of the previous column
+      if (col_indices_are_sorted)
+        {
+          while (current_column != row_end && *current_column < block_col)
+            ++current_column;
+        }
+      else
+        current_column = std::lower_bound(row_begin, row_end, block_col);
+
+      Assert(current_column != row_end && *current_column == block_col,
+             ExcInvalidIndex(row, col));
+
+      const std::size_t block = current_column - block_columns.begin();
+      values[(block * block_size + row_in_block) * block_size +
+             col % block_size] += input_values[k];
+    }
+}
+
+
+
+template <typename number, int block_size>
+inline number
+BlockCSRMatrix<number, block_size>::el(const size_type i,
+                                       const size_type j) const
+{
+  AssertIndexRange(i, m());
+  AssertIndexRange(j, n());
+
+  const std::size_t block = find_block(i / block_size, j / block_size);
+  if (block == numbers::invalid_size_type)
+    return number();
+  else
+    return values[(block * block_size + i % block_size) * block_size +
+                  j % block_size];
+}
+
+
+
+template <typename number, int block_size>
+template <typename Number2>
+inline void
+BlockCSRMatrix<number, block_size>::vmult_on_subrange(
+  const size_type begin_block_row,
+  const size_type end_block_row,
+  const Number2  *src,
+  Number2        *dst,
+  const bool      add) const
+{
+  for (size_type block_row = begin_block_row; block_row < end_block_row;
+       ++block_row)
+    {
+      std::array<Number2, block_size> sums;
+      for (unsigned int r = 0; r < block_size; ++r)
+        sums[r] = add ? dst[block_row * block_size + r] : Number2();
+
+      for (std::size_t block = rowstart[block_row];
+           block < rowstart[block_row + 1];
+           ++block)
+        {
+          const number *block_values =
+            values.data() + block * block_size * block_size;
+          const Number2 *src_values = src + block_columns[block] * block_size;
+
+          // the loops have compile-time bounds and get unrolled
+          for (unsigned int r = 0; r < block_size; ++r)
+            for (unsigned int c = 0; c < block_size; ++c)
+              sums[r] += Number2(block_values[r * block_size + c]) *
+                         src_values[c];
+        }
+
+      for (unsigned int r = 0; r < block_size; ++r)
+        dst[block_row * block_size + r] = sums[r];
+    }
+}
+
+
+
+template <typename number, int block_size>
+template <typename VectorType>
+inline void
+BlockCSRMatrix<number, block_size>::vmult(VectorType       &dst,
+                                          const VectorType &src) const
+{
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  using Number2 = typename VectorType::value_type;
+  const Number2 *src_ptr = src.begin();
+  Number2       *dst_ptr = dst.begin();
+  parallel::apply_to_subranges(
+    size_type(0),
+    n_block_rows,
+    [&](const size_type begin, const size_type end) {
+      vmult_on_subrange(begin, end, src_ptr, dst_ptr, false);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+        block_size +
+      1);
+}
+
+
+
+template <typename number, int block_size>
+template <typename VectorType>
+inline void
+BlockCSRMatrix<number, block_size>::vmult_add(VectorType       &dst,
+                                              const VectorType &src) const
+{
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  using Number2 = typename VectorType::value_type;
+  const Number2 *src_ptr = src.begin();
+  Number2       *dst_ptr = dst.begin();
+  parallel::apply_to_subranges(
+    size_type(0),
+    n_block_rows,
+    [&](const size_type begin, const size_type end) {
+      vmult_on_subrange(begin, end, src_ptr, dst_ptr, true);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+        block_size +
+      1);
+}
+
+
+
+template <typename number, int block_size>
+template <typename VectorType>
+inline void
+BlockCSRMatrix<number, block_size>::Tvmult(VectorType       &dst,
+                                           const VectorType &src) const
+{
+  dst = typename VectorType::value_type();
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename number, int block_size>
+template <typename VectorType>
+inline void
+BlockCSRMatrix<number, block_size>::Tvmult_add(VectorType       &dst,
+                                               const VectorType &src) const
+{
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), m());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  using Number2 = typename VectorType::value_type;
+  const Number2 *src_ptr = src.begin();
+  Number2       *dst_ptr = dst.begin();
+  for (size_type block_row = 0; block_row < n_block_rows; ++block_row)
+    {
+      const Number2 *src_values = src_ptr + block_row * block_size;
+      for (std::size_t block = rowstart[block_row];
+           block < rowstart[block_row + 1];
+           ++block)
+        {
+          const number *block_values =
+            values.data() + block * block_size * block_size;
+          Number2 *dst_values = dst_ptr + block_columns[block] * block_size;
+          for (unsigned int r = 0; r < block_size; ++r)
+            for (unsigned int c = 0; c < block_size; ++c)
+              dst_values[c] +=
+                Number2(block_values[r * block_size + c]) * src_values[r];
+        }
+    }
+}
+
+
+
+template <typename number, int block_size>
+inline std::size_t
+BlockCSRMatrix<number, block_size>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(rowstart) +
+         MemoryConsumption::memory_consumption(block_columns) +
+         values.memory_consumption();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
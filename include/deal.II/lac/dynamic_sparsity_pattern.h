@@ -27,6 +27,7 @@
 #include <deal.II/lac/sparsity_pattern_base.h>
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <vector>
 
@@ -318,6 +319,17 @@ namespace DynamicSparsityPatternIterators
  * SparsityPattern sp;
  * sp.copy_from (dynamic_pattern);
  * @endcode
+ *
+ *
+ * <h3>Thread safety</h3>
+ *
+ * The entries of each row are stored independently of the other rows. It is
+ * therefore safe to add entries to different rows from several threads
+ * concurrently through add(), add_entries(), and add_row_entries(), as long
+ * as no two threads add to the same row at the same time. This is used by
+ * DoFTools::make_sparsity_pattern() to build the sparsity pattern in
+ * parallel. Likewise, SparsityPattern::copy_from() reads the rows of this
+ * class in parallel.
  */
 class DynamicSparsityPattern : public SparsityPatternBase
 {
@@ -666,9 +678,11 @@ public:
 
 private:
   /**
-   * A flag that stores whether any entries have been added so far.
+   * A flag that stores whether any entries have been added so far. This flag
+   * is set by all functions adding entries, so it is an atomic variable to
+   * allow adding entries to different rows concurrently.
    */
-  bool have_entries;
+  std::atomic<bool> have_entries;
 
   /**
    * A set that contains the valid rows.
@@ -1008,7 +1022,8 @@ DynamicSparsityPattern::add(const size_type i, const size_type j)
   if (rowset.size() > 0 && !rowset.is_element(i))
     return;
 
-  have_entries = true;
+  if (!have_entries)
+    have_entries = true;
 
   const size_type rowindex =
     rowset.size() == 0 ? i : rowset.index_within_set(i);
@@ -0,0 +1,188 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_la_parallel_vector_fused_operations_h
+#define dealii_la_parallel_vector_fused_operations_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
+
+#include <array>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    /**
+     * @addtogroup Vectors
+     * @{
+     */
+
+    /**
+     * Run a fused vector operation on the locally owned elements of vectors
+     * with the same parallel layout as @p layout_vector, and return the
+     * results of up to @p n_results inner products or norms computed during
+     * the operation, summed over all MPI processes with a single reduction.
+     *
+     * Sequences of vector operations like <tt>x.add(alpha, p)</tt>,
+     * <tt>r.add(-alpha, v)</tt>, <tt>r.l2_norm()</tt> each load and store the
+     * full vectors from main memory, and each reduction needs a separate
+     * global communication step. This function instead runs the
+     * user-provided @p operation on chunks of the locally owned index range,
+     * so that all vector entries are loaded only once while they are in
+     * cache, and sums the partial results with a single call to
+     * Utilities::MPI::sum(). The chunks are processed in parallel by the
+     * threads of the task scheduler.
+     *
+     * @p operation is a function object with the signature
+     * @code
+     * void operation(const unsigned int begin,
+     *                const unsigned int end,
+     *                std::array<Number, n_results> &partial_results);
+     * @endcode
+     * that performs the operations on the local index range
+     * <tt>[begin,end)</tt> and adds its contributions to the partial results,
+     * which are initialized to zero. The operation typically accesses the
+     * vector entries through pointers obtained from
+     * LinearAlgebra::distributed::Vector::begin(). As an example, the update
+     * of the solution and residual vectors in the conjugate gradient method
+     * together with the computation of the norm of the updated residual can
+     * be written as
+     * @code
+     * Number       *x_ptr = x.begin();
+     * Number       *r_ptr = r.begin();
+     * const Number *p_ptr = p.begin();
+     * const Number *v_ptr = v.begin();
+     * const std::array<Number, 1> result =
+     *   LinearAlgebra::distributed::fused_operation<1>(
+     *     r,
+     *     [&](const unsigned int begin,
+     *         const unsigned int end,
+     *         std::array<Number, 1> &partial_results) {
+     *       for (unsigned int i = begin; i < end; ++i)
+     *         {
+     *           x_ptr[i] += alpha * p_ptr[i];
+     *           r_ptr[i] -= alpha * v_ptr[i];
+     *           partial_results[0] += r_ptr[i] * r_ptr[i];
+     *         }
+     *     });
+     * const Number residual_norm = std::sqrt(result[0]);
+     * @endcode
+     *
+     * The splitting into chunks only depends on the local size of the
+     * vector, not on the number of threads, so the results are reproducible
+     * for a given parallel layout. The order of summation differs from the
+     * one of the reduction functions of the vector class, so the results
+     * may differ from the ones computed by the vector class in the last
+     * digits.
+     *
+     * If @p n_results is zero, no communication takes place.
+     *
+     * @note The operation may not access ghost entries, which are not
+     * updated.
+     */
+    template <std::size_t n_results, typename Number, typename Operation>
+    std::array<Number, n_results>
+    fused_operation(
+      const Vector<Number, ::dealii::MemorySpace::Host> &layout_vector,
+      const Operation                                   &operation);
+
+    /** @} */
+  } // namespace distributed
+} // namespace LinearAlgebra
+
+
+/*--------------------------- Implementation ------------------------------*/
+
+#ifndef DOXYGEN
+
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <std::size_t n_results, typename Number, typename Operation>
+    std::array<Number, n_results>
+    fused_operation(
+      const Vector<Number, ::dealii::MemorySpace::Host> &layout_vector,
+      const Operation                                   &operation)
+    {
+      const unsigned int local_size = layout_vector.locally_owned_size();
+      const unsigned int chunk_size =
+        internal::VectorImplementation::minimum_parallel_grain_size;
+      const unsigned int n_chunks = (local_size + chunk_size - 1) / chunk_size;
+
+      std::array<Number, n_results> results = {};
+      if (n_chunks == 1)
+        operation(0, local_size, results);
+      else if (n_chunks > 1)
+        {
+          // compute the results of each chunk separately and sum them in a
+          // fixed order afterwards to make the result independent of the
+          // assignment of chunks to threads
+          std::vector<std::array<Number, n_results>> chunk_results(n_chunks);
+          parallel::apply_to_subranges(
+            0U,
+            n_chunks,
+            [&](const unsigned int begin_chunk, const unsigned int end_chunk) {
+              for (unsigned int chunk = begin_chunk; chunk < end_chunk;
+                   ++chunk)
+                {
+                  chunk_results[chunk] = {};
+                  operation(chunk * chunk_size,
+                            std::min(local_size, (chunk + 1) * chunk_size),
+                            chunk_results[chunk]);
+                }
+            },
+            1);
+          for (const auto &chunk_result : chunk_results)
+            for (std::size_t i = 0; i < n_results; ++i)
+              results[i] += chunk_result[i];
+        }
+
+      if constexpr (n_results > 0)
+        Utilities::MPI::sum(
+          ArrayView<const Number>(results.data(), n_results),
+          layout_vector.get_mpi_communicator(),
+          ArrayView<Number>(results.data(), n_results));
+
+      return results;
+    }
+  } // namespace distributed
+} // namespace LinearAlgebra
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -29,6 +29,7 @@
 #include <deal.II/lac/block_vector_base.h>
 #include <deal.II/lac/diagonal_matrix.h>
 #include <deal.II/lac/identity_matrix.h>
+#include <deal.II/lac/la_parallel_vector_fused_operations.h>
 #include <deal.II/lac/solver_cg.h>
 #include <deal.II/lac/vector_memory.h>
 
@@ -1924,6 +1925,15 @@ public:
  * set `dst` to zero, whereas the operation after the loop performs the
  * iteration leading to $x^{n+1}$ described above, modifying the `dst` and
  * `src` vectors.
+ *
+ * The operators derived from MatrixFreeOperators::Base, such as
+ * MatrixFreeOperators::LaplaceOperator and
+ * MatrixFreeOperators::MassOperator, provide this function, including the
+ * treatment of constrained degrees of freedom and of the refinement edge
+ * indices on multigrid levels. Together with the inverse diagonal returned
+ * by MatrixFreeOperators::Base::get_matrix_diagonal_inverse() as
+ * preconditioner, each step of the Chebyshev iteration in a multigrid
+ * smoother then runs with a single pass through the vectors.
  */
 template <typename MatrixType         = SparseMatrix<double>,
           typename VectorType         = Vector<double>,
@@ -2753,9 +2763,15 @@ namespace internal
           preconditioner.vmult(solution_old, rhs);
 
           // compute x^{n+1} = f_2 * t
-          DEAL_II_OPENMP_SIMD_PRAGMA
-          for (unsigned int i = 0; i < solution_old.locally_owned_size(); ++i)
-            solution_old_ptr[i] = solution_old_ptr[i] * factor2;
+          LinearAlgebra::distributed::fused_operation<0>(
+            solution_old,
+            [&](const unsigned int begin,
+                const unsigned int end,
+                std::array<Number, 0> &) {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (unsigned int i = begin; i < end; ++i)
+                solution_old_ptr[i] = solution_old_ptr[i] * factor2;
+            });
         }
       else if (iteration_index == 1)
         {
@@ -2768,10 +2784,16 @@ namespace internal
           preconditioner.vmult(solution_old, temp_vector1);
 
           // compute x^{n+1} = x^{n} + f_1 * x^{n} + f_2 * t
-          DEAL_II_OPENMP_SIMD_PRAGMA
-          for (unsigned int i = 0; i < solution_old.locally_owned_size(); ++i)
-            solution_old_ptr[i] =
-              factor1_plus_1 * solution_ptr[i] + solution_old_ptr[i] * factor2;
+          LinearAlgebra::distributed::fused_operation<0>(
+            solution_old,
+            [&](const unsigned int begin,
+                const unsigned int end,
+                std::array<Number, 0> &) {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (unsigned int i = begin; i < end; ++i)
+                solution_old_ptr[i] = factor1_plus_1 * solution_ptr[i] +
+                                      solution_old_ptr[i] * factor2;
+            });
         }
       else
         {
@@ -2785,11 +2807,17 @@ namespace internal
           preconditioner.vmult(temp_vector2, temp_vector1);
 
           // compute x^{n+1} = x^{n} + f_1 * (x^{n}-x^{n-1}) + f_2 * t
-          DEAL_II_OPENMP_SIMD_PRAGMA
-          for (unsigned int i = 0; i < solution_old.locally_owned_size(); ++i)
-            solution_old_ptr[i] = factor1_plus_1 * solution_ptr[i] -
-                                  factor1 * solution_old_ptr[i] +
-                                  temp_vector2_ptr[i] * factor2;
+          LinearAlgebra::distributed::fused_operation<0>(
+            solution_old,
+            [&](const unsigned int begin,
+                const unsigned int end,
+                std::array<Number, 0> &) {
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (unsigned int i = begin; i < end; ++i)
+                solution_old_ptr[i] = factor1_plus_1 * solution_ptr[i] -
+                                      factor1 * solution_old_ptr[i] +
+                                      temp_vector2_ptr[i] * factor2;
+            });
         }
 
       solution.swap(solution_old);
@@ -0,0 +1,738 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sliced_ellpack_matrix_h
+#define dealii_sliced_ellpack_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Matrix1
+ * @{
+ */
+
+/**
+ * A sparse matrix stored in the SELL-C-$\sigma$ (sliced ELLPACK) format,
+ * which is a layout of the entries of a SparseMatrix that allows the
+ * matrix-vector product to be computed with SIMD instructions.
+ *
+ * The rows of the matrix are grouped into chunks of $C$ consecutive rows,
+ * where $C$ is the template argument @p width that defaults to the number of
+ * lanes in VectorizedArray<number>. Inside a chunk, the entries are stored
+ * column by column, i.e., the first entries of the $C$ rows, then the second
+ * entries, and so on, which means that one iteration of the inner loop of a
+ * matrix-vector product loads a full VectorizedArray of matrix entries and
+ * gathers the $C$ corresponding entries of the source vector. Rows in a chunk
+ * that are shorter than the longest row of that chunk are padded by zero
+ * entries. To keep the padding small, the rows are sorted by decreasing row
+ * length within windows of $\sigma$ consecutive rows before they are grouped
+ * into chunks. $\sigma=1$ keeps the original row order and does not need a
+ * permutation of the destination vector, whereas a large $\sigma$ minimizes
+ * the number of padded entries at the cost of a less local access into the
+ * destination vector. A value of $\sigma$ that is a small multiple of $C$,
+ * like the default value of 32 rows, is usually a good compromise for
+ * matrices stemming from finite element discretizations.
+ *
+ * The matrix is set up from an existing SparseMatrix (or a SparsityPattern,
+ * with the values filled in later through copy_from()), i.e., the assembly
+ * is done with the usual classes and the SELL-C-$\sigma$ matrix is used to
+ * speed up the matrix-vector products inside iterative solvers. The matrix
+ * stores its column indices as <tt>unsigned int</tt>, which is what the
+ * gather instructions of VectorizedArray expect and which also reduces the
+ * memory traffic compared to SparseMatrix when deal.II is configured with
+ * 64-bit indices.
+ *
+ * The vector types used in the matrix-vector products need to store their
+ * elements contiguously in memory, with direct access through
+ * <tt>begin()</tt>, and need to have @p number as their value type. This is
+ * the case for Vector<number> and for serial
+ * LinearAlgebra::distributed::Vector<number> objects.
+ *
+ * @note Instantiations of this class are possible for all types for which
+ * VectorizedArray is defined, i.e., <tt>float</tt> and <tt>double</tt>.
+ */
+template <typename number,
+          std::size_t width =
+            internal::VectorizedArrayWidthSpecifier<number>::max_width>
+class SlicedEllpackMatrix : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = number;
+
+  /**
+   * The vectorized data type used to store the entries of a chunk.
+   */
+  using VectorizedArrayType = VectorizedArray<number, width>;
+
+  /**
+   * Default constructor. The object needs to be initialized with reinit()
+   * before it can be used.
+   */
+  SlicedEllpackMatrix();
+
+  /**
+   * Constructor that copies the structure and the values of the given
+   * @p matrix. See reinit() for the meaning of @p sigma.
+   */
+  template <typename number2>
+  explicit SlicedEllpackMatrix(const SparseMatrix<number2> &matrix,
+                               const unsigned int           sigma = 32);
+
+  /**
+   * Set up the chunk layout for the given sparsity pattern and set all
+   * entries to zero. The values can then be filled in by copy_from().
+   *
+   * @p sigma denotes the size of the window of rows that are sorted by their
+   * length. It is rounded up to a multiple of the chunk size @p width. A
+   * value of 1 (or 0) keeps the original order of rows.
+   */
+  void
+  reinit(const SparsityPattern &sparsity, const unsigned int sigma = 32);
+
+  /**
+   * Set up the chunk layout for the sparsity pattern of the given matrix and
+   * copy its values.
+   */
+  template <typename number2>
+  void
+  reinit(const SparseMatrix<number2> &matrix, const unsigned int sigma = 32);
+
+  /**
+   * Copy the values of the given matrix into this object. The matrix must be
+   * based on the same sparsity pattern as the one passed to reinit().
+   */
+  template <typename number2>
+  void
+  copy_from(const SparseMatrix<number2> &matrix);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of rows of the matrix.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the number of columns of the matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of nonzero entries of the matrix, excluding the
+   * entries added for padding.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of entries stored in the chunks, including the entries
+   * added for padding. The ratio of this number and n_nonzero_elements()
+   * measures the overhead of the format.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Return the value of $\sigma$ used to sort the rows.
+   */
+  unsigned int
+  get_sigma() const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M*src$ with $M$ being this
+   * matrix.
+   */
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M^T*src$ with $M$ being this
+   * matrix. Since several rows of a chunk can write into the same entry of
+   * @p dst, this operation is not vectorized and runs serially.
+   */
+  template <typename VectorType>
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding matrix-vector multiplication: add $M*src$ to $dst$ with $M$ being
+   * this matrix.
+   */
+  template <typename VectorType>
+  void
+  vmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding transposed matrix-vector multiplication: add $M^T*src$ to $dst$
+   * with $M$ being this matrix.
+   */
+  template <typename VectorType>
+  void
+  Tvmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Compute the residual of an equation <i>Mx=b</i>, where the residual is
+   * defined to be <i>r=b-Mx</i>, and return its $l_2$ norm.
+   */
+  template <typename VectorType>
+  number
+  residual(VectorType &dst, const VectorType &x, const VectorType &b) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcTooManyColumns,
+                   "The SlicedEllpackMatrix stores column indices as "
+                   "'unsigned int' and can hence only represent matrices "
+                   "with less than 2^32 columns.");
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcDifferentSparsityPattern,
+                   "The matrix passed to copy_from() is not based on the "
+                   "same sparsity pattern as the one this object has been "
+                   "initialized with.");
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcSourceEqualsDestination,
+                   "You are attempting an operation on two vectors that "
+                   "are the same object, but the operation requires that the "
+                   "two objects are in fact different.");
+
+private:
+  /**
+   * Number of rows of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * Number of columns of the matrix.
+   */
+  size_type n_cols;
+
+  /**
+   * The size of the window of rows that are sorted by their length.
+   */
+  unsigned int sigma;
+
+  /**
+   * The number of nonzero entries of the matrix without padding.
+   */
+  std::size_t n_nonzero;
+
+  /**
+   * The original index of the row stored in each lane of each chunk. Lanes of
+   * the last chunk that do not correspond to a row are set to
+   * numbers::invalid_size_type.
+   */
+  std::vector<size_type> row_index;
+
+  /**
+   * The position of each row within the chunk layout, i.e., the inverse of
+   * @p row_index.
+   */
+  std::vector<size_type> row_position;
+
+  /**
+   * The index of the first entry of each chunk in @p values and, multiplied
+   * by @p width, in @p column_indices. The length of chunk @p c is
+   * <tt>chunk_start[c+1]-chunk_start[c]</tt>. For an empty matrix, this
+   * array contains a single zero, such that there are no chunks.
+   */
+  std::vector<std::size_t> chunk_start;
+
+  /**
+   * The column indices of all stored entries, with @p width consecutive
+   * entries belonging to the lanes of one column of a chunk. Padded entries
+   * repeat the last valid column index of the row to not introduce
+   * additional cache misses in the gather operation.
+   */
+  std::vector<unsigned int> column_indices;
+
+  /**
+   * The matrix entries in the chunk layout.
+   */
+  AlignedVector<VectorizedArrayType> values;
+};
+
+/**
+ * @}
+ */
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+namespace internal
+{
+  namespace SlicedEllpackMatrixImplementation
+  {
+    /**
+     * Perform the matrix-vector product on the chunks in the range
+     * [begin_chunk, end_chunk). If the rows are not permuted, whole chunks
+     * are written with a single store operation.
+     */
+    template <typename number, std::size_t width>
+    void
+    vmult_on_subrange(const std::size_t                     begin_chunk,
+                      const std::size_t                     end_chunk,
+                      const std::size_t                    *chunk_start,
+                      const unsigned int                   *column_indices,
+                      const VectorizedArray<number, width> *values,
+                      const types::global_dof_index        *row_index,
+                      const types::global_dof_index         n_rows,
+                      const bool                            permuted,
+                      const number                         *src,
+                      number                               *dst,
+                      const bool                            add)
+    {
+      for (std::size_t c = begin_chunk; c < end_chunk; ++c)
+        {
+          VectorizedArray<number, width> sum = number();
+          VectorizedArray<number, width> src_values;
+          for (std::size_t k = chunk_start[c]; k < chunk_start[c + 1]; ++k)
+            {
+              src_values.gather(src, column_indices + k * width);
+              sum += values[k] * src_values;
+            }
+
+          if (permuted == false && (c + 1) * width <= n_rows)
+            {
+              if (add)
+                {
+                  VectorizedArray<number, width> old_values;
+                  old_values.load(dst + c * width);
+                  sum += old_values;
+                }
+              sum.store(dst + c * width);
+            }
+          else
+            for (unsigned int v = 0; v < width; ++v)
+              {
+                const types::global_dof_index row = row_index[c * width + v];
+                if (row == numbers::invalid_dof_index)
+                  break;
+                if (add)
+                  dst[row] += sum[v];
+                else
+                  dst[row] = sum[v];
+              }
+        }
+    }
+  } // namespace SlicedEllpackMatrixImplementation
+} // namespace internal
+
+
+
+template <typename number, std::size_t width>
+inline SlicedEllpackMatrix<number, width>::SlicedEllpackMatrix()
+  : n_rows(0)
+  , n_cols(0)
+  , sigma(1)
+  , n_nonzero(0)
+  , chunk_start(1, 0)
+{}
+
+
+
+template <typename number, std::size_t width>
+template <typename number2>
+inline SlicedEllpackMatrix<number, width>::SlicedEllpackMatrix(
+  const SparseMatrix<number2> &matrix,
+  const unsigned int           sigma)
+  : SlicedEllpackMatrix()
+{
+  reinit(matrix, sigma);
+}
+
+
+
+template <typename number, std::size_t width>
+inline void
+SlicedEllpackMatrix<number, width>::reinit(const SparsityPattern &sparsity,
+                                           const unsigned int     sigma_in)
+{
+  AssertThrow(sparsity.n_cols() <= static_cast<size_type>(
+                                     std::numeric_limits<unsigned int>::max()),
+              ExcTooManyColumns());
+  Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+
+  n_rows    = sparsity.n_rows();
+  n_cols    = sparsity.n_cols();
+  n_nonzero = sparsity.n_nonzero_elements();
+  sigma     = sigma_in <= 1 ? 1 : (sigma_in + width - 1) / width * width;
+
+  const std::size_t n_chunks = (n_rows + width - 1) / width;
+
+  // sort the rows by decreasing length within windows of sigma rows; use a
+  // stable sort to keep rows of the same length in their original order
+  row_index.clear();
+  row_index.resize(n_chunks * width, numbers::invalid_dof_index);
+  std::iota(row_index.begin(), row_index.begin() + n_rows, size_type(0));
+  if (sigma > 1)
+    for (size_type start = 0; start < n_rows; start += sigma)
+      std::stable_sort(row_index.begin() + start,
+                       row_index.begin() + std::min<size_type>(start + sigma,
+                                                               n_rows),
+                       [&sparsity](const size_type a, const size_type b) {
+                         return sparsity.row_length(a) >
+                                sparsity.row_length(b);
+                       });
+
+  row_position.resize(n_rows);
+  for (size_type i = 0; i < n_rows; ++i)
+    row_position[row_index[i]] = i;
+
+  chunk_start.resize(n_chunks + 1);
+  chunk_start[0] = 0;
+  for (std::size_t c = 0; c < n_chunks; ++c)
+    {
+      unsigned int max_length = 0;
+      for (unsigned int v = 0; v < width; ++v)
+        if (row_index[c * width + v] != numbers::invalid_dof_index)
+          max_length = std::max(max_length,
+                                sparsity.row_length(row_index[c * width + v]));
+      chunk_start[c + 1] = chunk_start[c] + max_length;
+    }
+
+  column_indices.resize(chunk_start.back() * width);
+  for (std::size_t c = 0; c < n_chunks; ++c)
+    for (unsigned int v = 0; v < width; ++v)
+      {
+        const size_type    row = row_index[c * width + v];
+        const unsigned int row_length =
+          row == numbers::invalid_dof_index ? 0 : sparsity.row_length(row);
+        unsigned int last_column = 0;
+        for (std::size_t k = chunk_start[c], j = 0; k < chunk_start[c + 1];
+             ++k, ++j)
+          {
+            if (j < row_length)
+              last_column = sparsity.column_number(row, j);
+            column_indices[k * width + v] = last_column;
+          }
+      }
+
+  values.resize_fast(chunk_start.back());
+  values.fill(VectorizedArrayType(number()));
+}
+
+
+
+template <typename number, std::size_t width>
+template <typename number2>
+inline void
+SlicedEllpackMatrix<number, width>::reinit(const SparseMatrix<number2> &matrix,
+                                           const unsigned int sigma)
+{
+  reinit(matrix.get_sparsity_pattern(), sigma);
+  copy_from(matrix);
+}
+
+
+
+template <typename number, std::size_t width>
+template <typename number2>
+inline void
+SlicedEllpackMatrix<number, width>::copy_from(
+  const SparseMatrix<number2> &matrix)
+{
+  AssertDimension(matrix.m(), m());
+  AssertDimension(matrix.n(), n());
+  Assert(matrix.n_nonzero_elements() == n_nonzero,
+         ExcDifferentSparsityPattern());
+
+  parallel::apply_to_subranges(
+    size_type(0),
+    n_rows,
+    [this, &matrix](const size_type begin_row, const size_type end_row) {
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          const size_type    position = row_position[row];
+          const std::size_t  c        = position / width;
+          const unsigned int v        = position % width;
+          std::size_t        k        = chunk_start[c];
+          for (auto entry = matrix.begin(row); entry != matrix.end(row);
+               ++entry, ++k)
+            {
+              Assert(k < chunk_start[c + 1] &&
+                       column_indices[k * width + v] == entry->column(),
+                     ExcDifferentSparsityPattern());
+              values[k][v] = entry->value();
+            }
+        }
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number, std::size_t width>
+inline void
+SlicedEllpackMatrix<number, width>::clear()
+{
+  n_rows    = 0;
+  n_cols    = 0;
+  sigma     = 1;
+  n_nonzero = 0;
+  row_index.clear();
+  row_position.clear();
+  chunk_start.assign(1, 0);
+  column_indices.clear();
+  values.clear();
+}
+
+
+
+template <typename number, std::size_t width>
+inline typename SlicedEllpackMatrix<number, width>::size_type
+SlicedEllpackMatrix<number, width>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename number, std::size_t width>
+inline typename SlicedEllpackMatrix<number, width>::size_type
+SlicedEllpackMatrix<number, width>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename number, std::size_t width>
+inline std::size_t
+SlicedEllpackMatrix<number, width>::n_nonzero_elements() const
+{
+  return n_nonzero;
+}
+
+
+
+template <typename number, std::size_t width>
+inline std::size_t
+SlicedEllpackMatrix<number, width>::n_stored_elements() const
+{
+  return values.size() * width;
+}
+
+
+
+template <typename number, std::size_t width>
+inline unsigned int
+SlicedEllpackMatrix<number, width>::get_sigma() const
+{
+  return sigma;
+}
+
+
+
+template <typename number, std::size_t width>
+template <typename VectorType>
+inline void
+SlicedEllpackMatrix<number, width>::vmult(VectorType       &dst,
+                                          const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, number>::value,
+                "The vector type must have the same value type as the matrix.");
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  const number *src_ptr  = src.begin();
+  number       *dst_ptr  = dst.begin();
+  const bool    permuted = sigma > 1;
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    chunk_start.size() - 1,
+    [&](const std::size_t begin_chunk, const std::size_t end_chunk) {
+      internal::SlicedEllpackMatrixImplementation::vmult_on_subrange(
+        begin_chunk,
+        end_chunk,
+        chunk_start.data(),
+        column_indices.data(),
+        values.data(),
+        row_index.data(),
+        n_rows,
+        permuted,
+        src_ptr,
+        dst_ptr,
+        false);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size / width +
+      1);
+}
+
+
+
+template <typename number, std::size_t width>
+template <typename VectorType>
+inline void
+SlicedEllpackMatrix<number, width>::vmult_add(VectorType       &dst,
+                                              const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, number>::value,
+                "The vector type must have the same value type as the matrix.");
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  const number *src_ptr  = src.begin();
+  number       *dst_ptr  = dst.begin();
+  const bool    permuted = sigma > 1;
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    chunk_start.size() - 1,
+    [&](const std::size_t begin_chunk, const std::size_t end_chunk) {
+      internal::SlicedEllpackMatrixImplementation::vmult_on_subrange(
+        begin_chunk,
+        end_chunk,
+        chunk_start.data(),
+        column_indices.data(),
+        values.data(),
+        row_index.data(),
+        n_rows,
+        permuted,
+        src_ptr,
+        dst_ptr,
+        true);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size / width +
+      1);
+}
+
+
+
+template <typename number, std::size_t width>
+template <typename VectorType>
+inline void
+SlicedEllpackMatrix<number, width>::Tvmult(VectorType       &dst,
+                                           const VectorType &src) const
+{
+  dst = number();
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename number, std::size_t width>
+template <typename VectorType>
+inline void
+SlicedEllpackMatrix<number, width>::Tvmult_add(VectorType       &dst,
+                                               const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, number>::value,
+                "The vector type must have the same value type as the matrix.");
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), m());
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  const number *src_ptr = src.begin();
+  number       *dst_ptr = dst.begin();
+  for (std::size_t c = 0; c < chunk_start.size() - 1; ++c)
+    for (unsigned int v = 0; v < width; ++v)
+      {
+        const size_type row = row_index[c * width + v];
+        if (row == numbers::invalid_dof_index)
+          break;
+        const number src_value = src_ptr[row];
+
+        // the padded entries are zero, so we can simply run through all
+        // entries of the chunk
+        for (std::size_t k = chunk_start[c]; k < chunk_start[c + 1]; ++k)
+          dst_ptr[column_indices[k * width + v]] += values[k][v] * src_value;
+      }
+}
+
+
+
+template <typename number, std::size_t width>
+template <typename VectorType>
+inline number
+SlicedEllpackMatrix<number, width>::residual(VectorType       &dst,
+                                             const VectorType &x,
+                                             const VectorType &b) const
+{
+  AssertDimension(b.size(), m());
+  Assert(&x != &dst, ExcSourceEqualsDestination());
+
+  vmult(dst, x);
+  dst.sadd(number(-1.), number(1.), b);
+  return dst.l2_norm();
+}
+
+
+
+template <typename number, std::size_t width>
+inline std::size_t
+SlicedEllpackMatrix<number, width>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(row_index) +
+         MemoryConsumption::memory_consumption(row_position) +
+         MemoryConsumption::memory_consumption(chunk_start) +
+         MemoryConsumption::memory_consumption(column_indices) +
+         values.memory_consumption();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -23,9 +23,11 @@
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/subscriptor.h>
 
+#include <deal.II/lac/la_parallel_vector_fused_operations.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 
+#include <array>
 #include <cmath>
 #include <limits>
 
@@ -209,6 +211,140 @@ private:
 #ifndef DOXYGEN
 
 
+namespace internal
+{
+  namespace SolverBicgstabImplementation
+  {
+    // The following functions combine the vector operations of the Bicgstab
+    // method that access the same vectors. The generic versions call the
+    // functions of the vector class one after another, whereas the versions
+    // for LinearAlgebra::distributed::Vector run them in a single pass over
+    // the vectors with a single reduction.
+
+    // compute p = beta * p + r - beta * omega * v
+    template <typename VectorType>
+    inline void
+    update_search_direction(VectorType                            &p,
+                            const typename VectorType::value_type  beta,
+                            const typename VectorType::value_type  omega,
+                            const VectorType                      &r,
+                            const VectorType                      &v)
+    {
+      p.sadd(beta, 1., r);
+      p.add(-beta * omega, v);
+    }
+
+
+
+    template <typename Number>
+    inline void
+    update_search_direction(
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &p,
+      const Number                                                   beta,
+      const Number                                                   omega,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &r,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &v)
+    {
+      Number       *p_ptr      = p.begin();
+      const Number *r_ptr      = r.begin();
+      const Number *v_ptr      = v.begin();
+      const Number  beta_omega = beta * omega;
+      LinearAlgebra::distributed::fused_operation<0>(
+        p,
+        [&](const unsigned int begin,
+            const unsigned int end,
+            std::array<Number, 0> &) {
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = begin; i < end; ++i)
+            p_ptr[i] = beta * p_ptr[i] + r_ptr[i] - beta_omega * v_ptr[i];
+        });
+    }
+
+
+
+    // compute the inner products t*r and t*t
+    template <typename VectorType>
+    inline std::array<typename VectorType::value_type, 2>
+    dot_and_norm_square(const VectorType &t, const VectorType &r)
+    {
+      return {{t * r, t * t}};
+    }
+
+
+
+    template <typename Number>
+    inline std::array<Number, 2>
+    dot_and_norm_square(
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &t,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &r)
+    {
+      const Number *t_ptr = t.begin();
+      const Number *r_ptr = r.begin();
+      return LinearAlgebra::distributed::fused_operation<2>(
+        t,
+        [&](const unsigned int     begin,
+            const unsigned int     end,
+            std::array<Number, 2> &sums) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              sums[0] +=
+                t_ptr[i] * numbers::NumberTraits<Number>::conjugate(r_ptr[i]);
+              sums[1] +=
+                t_ptr[i] * numbers::NumberTraits<Number>::conjugate(t_ptr[i]);
+            }
+        });
+    }
+
+
+
+    // compute r += a * t and return the inner products r*r and r*rbar of
+    // the updated vector r
+    template <typename VectorType>
+    inline std::array<typename VectorType::value_type, 2>
+    add_and_dots(VectorType                           &r,
+                 const typename VectorType::value_type a,
+                 const VectorType                     &t,
+                 const VectorType                     &rbar)
+    {
+      const typename VectorType::value_type r_dot_r = r.add_and_dot(a, t, r);
+      return {{r_dot_r, r * rbar}};
+    }
+
+
+
+    template <typename Number>
+    inline std::array<Number, 2>
+    add_and_dots(
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &r,
+      const Number                                                   a,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &t,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+        &rbar)
+    {
+      Number       *r_ptr    = r.begin();
+      const Number *t_ptr    = t.begin();
+      const Number *rbar_ptr = rbar.begin();
+      return LinearAlgebra::distributed::fused_operation<2>(
+        r,
+        [&](const unsigned int     begin,
+            const unsigned int     end,
+            std::array<Number, 2> &sums) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              const Number r_new = r_ptr[i] + a * t_ptr[i];
+              r_ptr[i]           = r_new;
+              sums[0] +=
+                r_new * numbers::NumberTraits<Number>::conjugate(r_new);
+              sums[1] +=
+                r_new * numbers::NumberTraits<Number>::conjugate(rbar_ptr[i]);
+            }
+        });
+    }
+  } // namespace SolverBicgstabImplementation
+} // namespace internal
+
+
+
 template <typename VectorType>
 SolverBicgstab<VectorType>::IterationResult::IterationResult(
   const bool                 breakdown,
@@ -320,11 +456,19 @@ SolverBicgstab<VectorType>::iterate(const MatrixType         &A,
   value_type rho   = 1.;
   value_type omega = 1.;
 
+  // the inner product r*rbar of the next iteration, if it was already
+  // computed together with the update of r
+  value_type next_rhobar      = 0.;
+  bool       have_next_rhobar = false;
+
   do
     {
       ++step;
 
-      const value_type rhobar = (step == 1 + last_step) ? res * res : r * rbar;
+      const value_type rhobar = (step == 1 + last_step) ? res * res :
+                                have_next_rhobar        ? next_rhobar :
+                                                          r * rbar;
+      have_next_rhobar        = false;
 
       if (std::fabs(rhobar) < additional_data.breakdown)
         {
@@ -339,8 +483,8 @@ SolverBicgstab<VectorType>::iterate(const MatrixType         &A,
         }
       else
         {
-          p.sadd(beta, 1., r);
-          p.add(-beta * omega, v);
+          internal::SolverBicgstabImplementation::update_search_direction(
+            p, beta, omega, r, v);
         }
 
       preconditioner.vmult(y, p);
@@ -370,8 +514,10 @@ SolverBicgstab<VectorType>::iterate(const MatrixType         &A,
 
       preconditioner.vmult(z, r);
       A.vmult(t, z);
-      const value_type t_dot_r   = t * r;
-      const real_type  t_squared = t * t;
+      const std::array<value_type, 2> t_dot_r_and_t_squared =
+        internal::SolverBicgstabImplementation::dot_and_norm_square(t, r);
+      const value_type t_dot_r   = t_dot_r_and_t_squared[0];
+      const real_type  t_squared = std::real(t_dot_r_and_t_squared[1]);
       if (t_squared < additional_data.breakdown)
         {
           return IterationResult(true, state, step, res);
@@ -385,7 +531,16 @@ SolverBicgstab<VectorType>::iterate(const MatrixType         &A,
           res = criterion(A, x, b, t);
         }
       else
-        res = std::sqrt(real_type(r.add_and_dot(-omega, t, r)));
+        {
+          const std::array<value_type, 2> r_dot_r_and_rbar =
+            internal::SolverBicgstabImplementation::add_and_dots(r,
+                                                                 -omega,
+                                                                 t,
+                                                                 rbar);
+          res              = std::sqrt(real_type(r_dot_r_and_rbar[0]));
+          next_rhobar      = r_dot_r_and_rbar[1];
+          have_next_rhobar = true;
+        }
 
       state = this->iteration_status(step, res, x);
       print_vectors(step, x, r, y);
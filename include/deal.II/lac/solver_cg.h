@@ -21,13 +21,16 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/vectorization.h>
 
+#include <deal.II/lac/la_parallel_vector_fused_operations.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
 
+#include <array>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
@@ -383,6 +386,87 @@ public:
 };
 
 
+/**
+ * This class implements the pipelined variant of the preconditioned
+ * conjugate gradient method by Ghysels and Vanroose, see
+ * @cite Ghysels2014. In the classical CG method as implemented by SolverCG,
+ * each iteration contains two global reductions (the products
+ * $\mathbf{p}^T A\mathbf{p}$ and $\mathbf{r}^T P^{-1}\mathbf{r}$) that
+ * separate the matrix-vector product from the preconditioner application.
+ * With many MPI ranks, the latency of these reductions limits the time per
+ * iteration. The pipelined variant reformulates the recurrences with three
+ * additional auxiliary vectors such that all inner products of an iteration
+ * (including the residual norm used for the convergence check) are computed
+ * in a single reduction, which is started before the application of the
+ * preconditioner and the matrix-vector product of the iteration and only
+ * waited for after them. The mathematical results are the same as for
+ * SolverCG up to round-off, but the algorithm is somewhat less stable in
+ * finite precision arithmetic, and it needs more vector updates per
+ * iteration. It hence pays off when the time of an iteration is dominated by
+ * the reduction, like for matrix-free operators on large numbers of MPI
+ * ranks with few unknowns per rank.
+ *
+ * The overlap of the reduction with the matrix-vector product is realized
+ * for vectors of type LinearAlgebra::distributed::Vector, where the locally
+ * owned parts of the inner products are combined with a non-blocking
+ * <tt>MPI_Iallreduce</tt>. For other vector types, the inner products are
+ * computed with the usual blocking operations of the vector class.
+ *
+ * Since the convergence check needs the result of the reduction, the solver
+ * performs one additional application of the preconditioner and the matrix
+ * compared to SolverCG. This class does not support the estimation of
+ * eigenvalues and condition numbers.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipelinedCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   * Here, it does not store anything but just exists for consistency
+   * with the other solver classes.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverPipelinedCG(SolverControl            &cn,
+                    VectorMemory<VectorType> &mem,
+                    const AdditionalData     &data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipelinedCG(SolverControl        &cn,
+                    const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType         &A,
+        VectorType               &x,
+        const VectorType         &b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+
+
 /** @} */
 
 /*------------------------- Implementation ----------------------------*/
@@ -563,6 +647,46 @@ namespace internal
 
 
 
+    // Compute the inner products r*v and r*z. The generic version calls the
+    // functions of the vector class, whereas the version for
+    // LinearAlgebra::distributed::Vector computes both products in a single
+    // pass over the vectors with a single reduction.
+    template <typename VectorType>
+    inline std::array<typename VectorType::value_type, 2>
+    dot_products(const VectorType &r, const VectorType &v, const VectorType &z)
+    {
+      return {{r * v, r * z}};
+    }
+
+
+
+    template <typename Number>
+    inline std::array<Number, 2>
+    dot_products(
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &r,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &v,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &z)
+    {
+      const Number *r_ptr = r.begin();
+      const Number *v_ptr = v.begin();
+      const Number *z_ptr = z.begin();
+      return LinearAlgebra::distributed::fused_operation<2>(
+        r,
+        [&](const unsigned int     begin,
+            const unsigned int     end,
+            std::array<Number, 2> &sums) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              sums[0] +=
+                r_ptr[i] * numbers::NumberTraits<Number>::conjugate(v_ptr[i]);
+              sums[1] +=
+                r_ptr[i] * numbers::NumberTraits<Number>::conjugate(z_ptr[i]);
+            }
+        });
+    }
+
+
+
     // Implementation of a conjugate gradient operation with matrices and
     // preconditioners without special capabilities
     template <typename VectorType,
@@ -603,10 +727,21 @@ namespace internal
         const Number previous_r_dot_preconditioner_dot_r =
           r_dot_preconditioner_dot_r;
 
+        // for the flexible variant, the inner product of r with the previous
+        // preconditioned residual z is computed together with the one of the
+        // current preconditioned residual
+        Number r_dot_z = Number();
         if (std::is_same_v<PreconditionerType, PreconditionIdentity> == false)
           {
             preconditioner.vmult(v, r);
-            r_dot_preconditioner_dot_r = r * v;
+            if (this->flexible && iteration_index > 1)
+              {
+                const std::array<Number, 2> products = dot_products(r, v, z);
+                r_dot_preconditioner_dot_r           = products[0];
+                r_dot_z                              = products[1];
+              }
+            else
+              r_dot_preconditioner_dot_r = r * v;
           }
         else
           r_dot_preconditioner_dot_r = residual_norm * residual_norm;
@@ -621,7 +756,11 @@ namespace internal
             beta =
               r_dot_preconditioner_dot_r / previous_r_dot_preconditioner_dot_r;
             if (this->flexible)
-              beta -= (r * z) / previous_r_dot_preconditioner_dot_r;
+              {
+                if (std::is_same_v<PreconditionerType, PreconditionIdentity>)
+                  r_dot_z = r * z;
+                beta -= r_dot_z / previous_r_dot_preconditioner_dot_r;
+              }
             p.sadd(beta, 1., direction);
           }
         else
@@ -1253,6 +1392,114 @@ namespace internal
           }
       }
     };
+
+
+    // Helper class to compute the three inner products of the pipelined CG
+    // method with a single reduction. The generic variant computes the inner
+    // products with the functions of the vector class in start(), so there
+    // is no overlap with the operations between start() and finish().
+    template <typename VectorType>
+    class PipelinedReduction
+    {
+    public:
+      using Number = typename VectorType::value_type;
+
+      // Start the computation of r*r, r*u, and w*u
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        sums[0] = r * r;
+        sums[1] = r * u;
+        sums[2] = w * u;
+      }
+
+      // Return the result of the inner products
+      const std::array<Number, 3> &
+      finish()
+      {
+        return sums;
+      }
+
+    private:
+      std::array<Number, 3> sums;
+    };
+
+
+
+    // Specialization for LinearAlgebra::distributed::Vector that computes
+    // the inner products on the locally owned range and then sums them over
+    // all MPI ranks with a non-blocking reduction, which completes in
+    // finish().
+    template <typename Number>
+    class PipelinedReduction<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+    public:
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+      PipelinedReduction()
+#ifdef DEAL_II_WITH_MPI
+        : request(MPI_REQUEST_NULL)
+#endif
+      {}
+
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        const Number      *r_ptr = r.begin();
+        const Number      *u_ptr = u.begin();
+        const Number      *w_ptr = w.begin();
+        const unsigned int size  = r.locally_owned_size();
+
+        sums = {};
+        for (unsigned int i = 0; i < size; ++i)
+          {
+            const Number u_conj =
+              numbers::NumberTraits<Number>::conjugate(u_ptr[i]);
+            sums[0] +=
+              r_ptr[i] * numbers::NumberTraits<Number>::conjugate(r_ptr[i]);
+            sums[1] += r_ptr[i] * u_conj;
+            sums[2] += w_ptr[i] * u_conj;
+          }
+
+#ifdef DEAL_II_WITH_MPI
+        const MPI_Comm comm = r.get_mpi_communicator();
+        if (Utilities::MPI::n_mpi_processes(comm) > 1)
+          {
+            const int ierr =
+              MPI_Iallreduce(MPI_IN_PLACE,
+                             sums.data(),
+                             3,
+                             Utilities::MPI::mpi_type_id_for_type<Number>,
+                             MPI_SUM,
+                             comm,
+                             &request);
+            AssertThrowMPI(ierr);
+          }
+#endif
+      }
+
+      const std::array<Number, 3> &
+      finish()
+      {
+#ifdef DEAL_II_WITH_MPI
+        if (request != MPI_REQUEST_NULL)
+          {
+            const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+#endif
+        return sums;
+      }
+
+    private:
+      std::array<Number, 3> sums;
+
+#ifdef DEAL_II_WITH_MPI
+      MPI_Request request;
+#endif
+    };
   } // namespace SolverCG
 } // namespace internal
 
@@ -1406,6 +1653,153 @@ SolverFlexibleCG<VectorType>::SolverFlexibleCG(SolverControl &cn,
 }
 
 
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl            &cn,
+                                                 VectorMemory<VectorType> &mem,
+                                                 const AdditionalData     &data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl        &cn,
+                                                 const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipelinedCG<VectorType>::solve(const MatrixType         &A,
+                                     VectorType               &x,
+                                     const VectorType         &b,
+                                     const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State solver_state = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipelined cg");
+
+  // Memory allocation. We use the notation of Algorithm 4 in Ghysels and
+  // Vanroose: 'r' is the residual, 'u' the preconditioned residual, 'w' the
+  // matrix applied to 'u', 'm' and 'n' the preconditioner and the matrix
+  // applied to 'w', and 'p', 's', 'q', 'z' the search direction and its
+  // images under the matrix and the preconditioner
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &z = *z_pointer;
+
+  // Initialize without setting the vector entries, as those will be
+  // overwritten anyway
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  p.reinit(x, true);
+  s.reinit(x, true);
+  q.reinit(x, true);
+  z.reinit(x, true);
+
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r.equ(1., b);
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  internal::SolverCG::PipelinedReduction<VectorType> reduction;
+
+  number       alpha         = number();
+  number       gamma_old     = number();
+  double       residual_norm = 0.;
+  unsigned int it            = 0;
+  while (true)
+    {
+      // start the reduction for the inner products of this iteration and
+      // hide its latency behind the preconditioner and the matrix-vector
+      // product
+      reduction.start(r, u, w);
+
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+
+      const std::array<number, 3> &sums = reduction.finish();
+
+      // Round-off errors near zero might yield negative values, so take the
+      // absolute value
+      residual_norm = std::sqrt(std::abs(sums[0]));
+      solver_state  = this->iteration_status(it, residual_norm, x);
+      if (solver_state != SolverControl::iterate)
+        break;
+
+      const number gamma = sums[1];
+      const number delta = sums[2];
+
+      if (it > 0)
+        {
+          Assert(std::abs(gamma_old) != 0., ExcDivideByZero());
+          const number beta = gamma / gamma_old;
+          Assert(std::abs(delta - beta * gamma / alpha) != 0.,
+                 ExcDivideByZero());
+          alpha = gamma / (delta - beta * gamma / alpha);
+
+          z.sadd(beta, 1., n);
+          q.sadd(beta, 1., m);
+          s.sadd(beta, 1., w);
+          p.sadd(beta, 1., u);
+        }
+      else
+        {
+          Assert(std::abs(delta) != 0., ExcDivideByZero());
+          alpha = gamma / delta;
+
+          z.equ(1., n);
+          q.equ(1., m);
+          s.equ(1., w);
+          p.equ(1., u);
+        }
+
+      x.add(alpha, p);
+      r.add(-alpha, s);
+      u.add(-alpha, q);
+      w.add(-alpha, z);
+
+      gamma_old = gamma;
+      ++it;
+    }
+
+  AssertThrow(solver_state == SolverControl::success,
+              SolverControl::NoConvergence(it, residual_norm));
+}
+
+
 
 #endif // DOXYGEN
 
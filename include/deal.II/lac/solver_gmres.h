@@ -568,6 +568,124 @@ private:
   FullMatrix<double> H1;
 };
 
+
+/**
+ * Implementation of an s-step variant of the restarted generalized minimal
+ * residual method, also known as communication-avoiding GMRES, see
+ * @cite Hoemmen2010. In the Arnoldi process of SolverGMRES, each new basis
+ * vector is orthogonalized against the previous ones immediately after it
+ * has been computed, which needs at least one global reduction per
+ * iteration. This class instead computes AdditionalData::block_size new
+ * Krylov vectors at once by repeated application of the (preconditioned)
+ * matrix in the Newton basis
+ * @f[
+ *   w_0 = (P^{-1}A - \theta_0 I) v, \quad
+ *   w_i = (P^{-1}A - \theta_i I) w_{i-1},
+ * @f]
+ * and orthogonalizes them as a block against the previous basis vectors and
+ * among each other. The block orthogonalization is a block classical
+ * Gram-Schmidt step combined with a Cholesky QR factorization, where the
+ * norms of the projected vectors are obtained by the Pythagorean theorem.
+ * As a consequence, all inner products of a block are computed in a single
+ * reduction, i.e., the number of global reductions is reduced by a factor
+ * of AdditionalData::block_size compared to SolverGMRES. The Hessenberg
+ * matrix of the Arnoldi relation is recovered from the coefficients of the
+ * Newton basis and the block orthogonalization.
+ *
+ * The shifts $\theta_i$ of the Newton basis are the Ritz values of the
+ * Hessenberg matrix of the previous restart cycle in Leja ordering, of which
+ * only the real parts are used. In the first restart cycle, no Ritz values
+ * are available and the shifts are zero, i.e., the monomial basis is used.
+ * The Newton basis keeps the block of Krylov vectors reasonably well
+ * conditioned for moderate block sizes (up to around 8), but the condition
+ * number of the block grows with the block size. If the Cholesky
+ * factorization detects a numerically rank-deficient block, the block is
+ * truncated to its linearly independent part.
+ *
+ * Convergence is checked once per block, so the number of iterations
+ * reported to the SolverControl object grows in steps of
+ * AdditionalData::block_size.
+ *
+ * The reductions are fused into a single MPI call for vectors of type
+ * LinearAlgebra::distributed::Vector (and block vectors thereof). For other
+ * vector types, the inner products are computed one by one with the
+ * functions of the vector class, which gives the same numerical algorithm
+ * but does not save any communication.
+ *
+ * For the requirements on matrices and vectors in order to work with this
+ * class, see the documentation of the Solver base class.
+ */
+template <typename VectorType = Vector<double>>
+class SolverSStepGMRES : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, set the maximum basis size to 30 and
+     * compute blocks of 4 Krylov vectors at once, with left
+     * preconditioning.
+     */
+    explicit AdditionalData(const unsigned int max_basis_size        = 30,
+                            const unsigned int block_size            = 4,
+                            const bool         right_preconditioning = false)
+      : max_basis_size(max_basis_size)
+      , block_size(block_size)
+      , right_preconditioning(right_preconditioning)
+    {}
+
+    /**
+     * Maximum basis size, after which the method is restarted.
+     */
+    unsigned int max_basis_size;
+
+    /**
+     * The number of Krylov vectors computed and orthogonalized together,
+     * i.e., the parameter $s$ of the s-step method.
+     */
+    unsigned int block_size;
+
+    /**
+     * Flag for right preconditioning. See the documentation of SolverGMRES
+     * for the difference between left and right preconditioning.
+     */
+    bool right_preconditioning;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverSStepGMRES(SolverControl            &cn,
+                   VectorMemory<VectorType> &mem,
+                   const AdditionalData     &data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverSStepGMRES(SolverControl        &cn,
+                   const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType         &A,
+        VectorType               &x,
+        const VectorType         &b,
+        const PreconditionerType &preconditioner);
+
+private:
+  /**
+   * Additional flags.
+   */
+  AdditionalData additional_data;
+};
+
 /** @} */
 /* --------------------- Inline and template functions ------------------- */
 
@@ -1225,6 +1343,131 @@ namespace internal
 
       return 0.0;
     }
+
+
+    // Compute the inner products of the vectors
+    // orthogonal_vectors[first_new], ..., orthogonal_vectors[first_new +
+    // n_new - 1] with all vectors orthogonal_vectors[0], ...,
+    // orthogonal_vectors[first_new + n_new - 1]. The result is stored in
+    // gram(a * (first_new + n_new) + i) for the product of new vector a with
+    // vector i, where only the entries with i <= first_new + a are computed.
+    template <typename VectorType,
+              std::enable_if_t<
+                !is_dealii_compatible_distributed_vector<VectorType>::value,
+                VectorType> * = nullptr>
+    void
+    block_inner_products(
+      const unsigned int first_new,
+      const unsigned int n_new,
+      const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+                     &orthogonal_vectors,
+      Vector<double> &gram)
+    {
+      const unsigned int n_total = first_new + n_new;
+      gram.reinit(n_new * n_total);
+      for (unsigned int a = 0; a < n_new; ++a)
+        for (unsigned int i = 0; i <= first_new + a; ++i)
+          gram(a * n_total + i) =
+            orthogonal_vectors[first_new + a] * orthogonal_vectors[i];
+    }
+
+
+
+    template <typename VectorType,
+              std::enable_if_t<
+                is_dealii_compatible_distributed_vector<VectorType>::value,
+                VectorType> * = nullptr>
+    void
+    block_inner_products(
+      const unsigned int first_new,
+      const unsigned int n_new,
+      const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+                     &orthogonal_vectors,
+      Vector<double> &gram)
+    {
+      const unsigned int n_total = first_new + n_new;
+      gram.reinit(n_new * n_total);
+
+      // compute all local contributions and sum them over all MPI ranks
+      // with a single reduction
+      for (unsigned int b = 0; b < n_blocks(orthogonal_vectors[0]); ++b)
+        for (unsigned int a = 0; a < n_new; ++a)
+          {
+            const auto &new_vector =
+              block(orthogonal_vectors[first_new + a], b);
+            for (unsigned int i = 0; i <= first_new + a; ++i)
+              {
+                const auto &other_vector = block(orthogonal_vectors[i], b);
+                double      sum          = 0.;
+                for (unsigned int j = 0; j < new_vector.locally_owned_size();
+                     ++j)
+                  sum += new_vector.local_element(j) *
+                         other_vector.local_element(j);
+                gram(a * n_total + i) += sum;
+              }
+          }
+
+      Utilities::MPI::sum(gram,
+                          block(orthogonal_vectors[0], 0)
+                            .get_mpi_communicator(),
+                          gram);
+    }
+
+
+
+    // Compute the shifts for the Newton basis of the s-step GMRES method as
+    // the real parts of the eigenvalues of the (square part of the)
+    // Hessenberg matrix, sorted in Leja ordering: the first shift is the one
+    // of largest magnitude, and each of the following ones maximizes the
+    // product of the distances to the shifts selected before.
+    inline std::vector<double>
+    compute_leja_shifts(const FullMatrix<double> &H_orig,
+                        const unsigned int        dim,
+                        const unsigned int        n_shifts)
+    {
+      std::vector<double> shifts(n_shifts, 0.);
+      if (dim == 0)
+        return shifts;
+
+      LAPACKFullMatrix<double> mat(dim, dim);
+      for (unsigned int i = 0; i < dim; ++i)
+        for (unsigned int j = 0; j < dim; ++j)
+          mat(i, j) = H_orig(i, j);
+      mat.compute_eigenvalues();
+
+      std::vector<double> ritz_values(dim);
+      for (unsigned int i = 0; i < dim; ++i)
+        ritz_values[i] = mat.eigenvalue(i).real();
+
+      std::vector<bool> selected(dim, false);
+      for (unsigned int k = 0; k < n_shifts; ++k)
+        {
+          // once all Ritz values have been used, start over
+          if (k % dim == 0)
+            std::fill(selected.begin(), selected.end(), false);
+
+          unsigned int best_index = numbers::invalid_unsigned_int;
+          double       best_value = -1.;
+          for (unsigned int i = 0; i < dim; ++i)
+            if (!selected[i])
+              {
+                double value = 1.;
+                if (k % dim == 0)
+                  value = std::abs(ritz_values[i]);
+                else
+                  for (unsigned int l = k - k % dim; l < k; ++l)
+                    value *= std::abs(ritz_values[i] - shifts[l]);
+                if (value > best_value)
+                  {
+                    best_value = value;
+                    best_index = i;
+                  }
+              }
+          selected[best_index] = true;
+          shifts[k]            = ritz_values[best_index];
+        }
+      return shifts;
+    }
   } // namespace SolverGMRESImplementation
 } // namespace internal
 
@@ -1821,6 +2064,261 @@ SolverFGMRES<VectorType>::solve(const MatrixType         &A,
                 SolverControl::NoConvergence(accumulated_iterations, res));
 }
 
+
+template <typename VectorType>
+SolverSStepGMRES<VectorType>::SolverSStepGMRES(SolverControl            &cn,
+                                               VectorMemory<VectorType> &mem,
+                                               const AdditionalData     &data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverSStepGMRES<VectorType>::SolverSStepGMRES(SolverControl        &cn,
+                                               const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverSStepGMRES<VectorType>::solve(const MatrixType         &A,
+                                    VectorType               &x,
+                                    const VectorType         &b,
+                                    const PreconditionerType &preconditioner)
+{
+  LogStream::Prefix prefix("SStepGMRES");
+
+  const unsigned int basis_size = additional_data.max_basis_size;
+  const unsigned int block_size = additional_data.block_size;
+  AssertThrow(block_size > 0 && block_size <= basis_size,
+              ExcMessage("The block size of the s-step GMRES method must be "
+                         "positive and must not exceed the basis size."));
+
+  const bool left_precondition = !additional_data.right_preconditioning;
+
+  SolverControl::State iteration_state = SolverControl::iterate;
+
+  // Generate an object where basis vectors are stored. The last vector is
+  // an auxiliary vector for the application of the operator.
+  internal::SolverGMRESImplementation::TmpVectors<VectorType> v(basis_size + 2,
+                                                                this->memory);
+  VectorType &aux = v(basis_size + 1, x);
+
+  // apply the preconditioned operator, i.e., P^{-1}A for left
+  // preconditioning and AP^{-1} for right preconditioning
+  const auto apply_operator = [&](VectorType &dst, const VectorType &src) {
+    if (left_precondition)
+      {
+        A.vmult(aux, src);
+        preconditioner.vmult(dst, aux);
+      }
+    else
+      {
+        preconditioner.vmult(aux, src);
+        A.vmult(dst, aux);
+      }
+  };
+
+  // number of the present iteration; this number is not reset to zero upon
+  // a restart
+  unsigned int accumulated_iterations = 0;
+
+  // the Hessenberg matrix of the Arnoldi relation, and the coefficients
+  // that express the Newton basis vectors in terms of the orthonormal basis
+  FullMatrix<double> H(basis_size + 1, basis_size);
+  FullMatrix<double> coefficients(basis_size + 1, block_size + 1);
+  FullMatrix<double> H1;
+  Vector<double>     gram;
+  Vector<double>     input(basis_size + 1);
+  Vector<double>     output(basis_size + 1);
+  Vector<double>     projected_rhs;
+  Vector<double>     y;
+
+  std::vector<double> shifts(block_size, 0.);
+
+  double res = std::numeric_limits<double>::lowest();
+
+  do
+    {
+      // compute the (preconditioned) residual
+      VectorType &v0 = v(0, x);
+      A.vmult(v0, x);
+      v0.sadd(-1., 1., b);
+      if (left_precondition)
+        {
+          aux = v0;
+          preconditioner.vmult(v0, aux);
+        }
+
+      const double beta = v0.l2_norm();
+      res               = beta;
+      iteration_state = this->iteration_status(accumulated_iterations, res, x);
+      if (iteration_state != SolverControl::iterate)
+        break;
+
+      v0 *= 1. / beta;
+      H = 0.;
+
+      // the number of columns of the Hessenberg matrix computed so far,
+      // which is one less than the number of orthonormal basis vectors
+      unsigned int dim = 0;
+      while (dim < basis_size && iteration_state == SolverControl::iterate)
+        {
+          const unsigned int first_new = dim + 1;
+          unsigned int       n_new     = std::min(block_size, basis_size - dim);
+
+          // compute the Newton basis, starting from the last orthonormal
+          // vector
+          for (unsigned int a = 0; a < n_new; ++a)
+            {
+              const VectorType &src = v[first_new + a - 1];
+              VectorType       &dst = v(first_new + a, x);
+              apply_operator(dst, src);
+              if (shifts[a] != 0.)
+                dst.add(-shifts[a], src);
+            }
+
+          // compute all inner products of the new vectors in one reduction
+          internal::SolverGMRESImplementation::block_inner_products(first_new,
+                                                                    n_new,
+                                                                    v,
+                                                                    gram);
+          const unsigned int n_total = first_new + n_new;
+
+          // block classical Gram-Schmidt: the coefficients of the new
+          // vectors with respect to the previous basis vectors are read off
+          // from the inner products, and the Gram matrix of the projected
+          // vectors follows from the Pythagorean theorem. Its Cholesky factor
+          // gives the coefficients among the new vectors. If the Cholesky
+          // factorization breaks down, the remaining vectors are numerically
+          // contained in the span of the basis and we truncate the block.
+          coefficients = 0.;
+          for (unsigned int a = 0; a < n_new; ++a)
+            for (unsigned int i = 0; i < first_new; ++i)
+              coefficients(i, a) = gram(a * n_total + i);
+          for (unsigned int a = 0; a < n_new; ++a)
+            {
+              for (unsigned int c = a; c < n_new; ++c)
+                {
+                  double sum = gram(c * n_total + first_new + a);
+                  for (unsigned int i = 0; i < first_new + a; ++i)
+                    sum -= coefficients(i, a) * coefficients(i, c);
+                  if (c == a)
+                    {
+                      const double original_norm_square =
+                        gram(a * n_total + first_new + a);
+                      if (!(sum > 1e-12 * original_norm_square))
+                        {
+                          n_new = a;
+                          break;
+                        }
+                      coefficients(first_new + a, a) = std::sqrt(sum);
+                    }
+                  else
+                    coefficients(first_new + a, c) =
+                      sum / coefficients(first_new + a, a);
+                }
+            }
+
+          // orthonormalize the new vectors with the computed coefficients
+          for (unsigned int a = 0; a < n_new; ++a)
+            {
+              VectorType &w = v[first_new + a];
+              for (unsigned int i = 0; i < first_new + a; ++i)
+                w.add(-coefficients(i, a), v[i]);
+              w *= 1. / coefficients(first_new + a, a);
+            }
+
+          // recover the columns of the Hessenberg matrix: the input vector
+          // of step a of the Newton basis has the coefficients 'input' in
+          // the orthonormal basis, and the operator maps it to the output
+          // vector of step a plus shifts[a] times the input vector
+          for (unsigned int a = 0; a < n_new; ++a)
+            {
+              const unsigned int column = dim + a;
+              input                     = 0.;
+              if (a == 0)
+                input(dim) = 1.;
+              else
+                for (unsigned int i = 0; i <= column; ++i)
+                  input(i) = coefficients(i, a - 1);
+
+              for (unsigned int i = 0; i <= column + 1; ++i)
+                output(i) = coefficients(i, a) + shifts[a] * input(i);
+              for (unsigned int j = 0; j < column; ++j)
+                if (input(j) != 0.)
+                  for (unsigned int i = 0; i <= j + 1; ++i)
+                    output(i) -= input(j) * H(i, j);
+              for (unsigned int i = 0; i <= column + 1; ++i)
+                H(i, column) = output(i) / input(column);
+            }
+
+          // a breakdown at the first vector means that the Krylov space is
+          // invariant, which means that the solution is found in the
+          // current space. compute the last column of the Hessenberg
+          // matrix without a new vector in that case
+          if (n_new == 0)
+            {
+              for (unsigned int i = 0; i < dim; ++i)
+                H(i, dim) = coefficients(i, 0);
+              H(dim, dim) = coefficients(dim, 0) + shifts[0];
+              ++dim;
+              ++accumulated_iterations;
+            }
+          else
+            {
+              dim += n_new;
+              accumulated_iterations += n_new;
+            }
+
+          // solve the least squares problem to obtain the residual
+          H1.reinit(dim + 1, dim);
+          H1.fill(H);
+          projected_rhs.reinit(dim + 1);
+          y.reinit(dim);
+          projected_rhs(0) = beta;
+          Householder<double> house(H1);
+          res = house.least_squares(y, projected_rhs);
+          iteration_state =
+            this->iteration_status(accumulated_iterations, res, x);
+
+          if (n_new == 0)
+            break;
+        }
+
+      // update the solution vector
+      if (left_precondition)
+        for (unsigned int j = 0; j < dim; ++j)
+          x.add(y(j), v[j]);
+      else
+        {
+          VectorType &p = v(basis_size, x);
+          p             = 0.;
+          for (unsigned int j = 0; j < dim; ++j)
+            p.add(y(j), v[j]);
+          preconditioner.vmult(aux, p);
+          x.add(1., aux);
+        }
+
+      // the shifts of the next restart cycle are the Ritz values of the
+      // current one
+      if (iteration_state == SolverControl::iterate)
+        shifts = internal::SolverGMRESImplementation::compute_leja_shifts(
+          H, dim, block_size);
+    }
+  while (iteration_state == SolverControl::iterate);
+
+  // in case of failure: throw exception
+  AssertThrow(iteration_state == SolverControl::success,
+              SolverControl::NoConvergence(accumulated_iterations, res));
+}
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,308 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_iterative_refinement_h
+#define dealii_solver_iterative_refinement_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/logstream.h>
+
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Solvers
+ * @{
+ */
+
+/**
+ * Implementation of an iterative refinement method for mixed-precision
+ * solvers. In each step, the residual $r=b-Ax$ is computed with the
+ * (high-precision) matrix $A$, and a correction $d$ is obtained by
+ * approximately solving $\tilde A d = r$ with an inner solver of type
+ * @p InnerSolverType, where $\tilde A$ is a cheaper approximation of the
+ * matrix. The solution is then updated by $x \leftarrow x + d$. The stopping
+ * criterion is the norm of the residual $r$ of the outer iteration.
+ *
+ * The typical use case is a matrix $\tilde A$ that stores the same entries as
+ * $A$ in lower precision, e.g., a SparseMatrix<float> copy of an assembled
+ * SparseMatrix<double>. Since the matrix-vector products of SparseMatrix
+ * convert the entries to the number type of the vectors, the inner solver
+ * still operates on (and accumulates in) double precision vectors, but only
+ * loads half as many bytes for each matrix entry. As the inner solver only
+ * needs to reduce the residual by a moderate factor (see
+ * AdditionalData::inner_reduction), the loss of accuracy in $\tilde A$ only
+ * affects the number of outer iterations, not the accuracy of the final
+ * solution which is controlled by the residual of $A$.
+ *
+ * @code
+ * SparseMatrix<double> system_matrix;
+ * // ... assemble system_matrix ...
+ *
+ * SparseMatrix<float> system_matrix_float(sparsity_pattern);
+ * system_matrix_float.copy_from(system_matrix);
+ *
+ * PreconditionJacobi<SparseMatrix<float>> preconditioner;
+ * preconditioner.initialize(system_matrix_float);
+ *
+ * SolverControl solver_control(100, 1e-12 * system_rhs.l2_norm());
+ * SolverIterativeRefinement<Vector<double>> solver(solver_control);
+ * solver.solve(system_matrix,
+ *              solution,
+ *              system_rhs,
+ *              system_matrix_float,
+ *              preconditioner);
+ * @endcode
+ *
+ * For the requirements on matrices and vectors in order to work with this
+ * class, see the documentation of the Solver base class. The inner solver
+ * needs to provide a constructor taking a SolverControl, a VectorMemory and
+ * an object of type <tt>InnerSolverType::AdditionalData</tt>, like all
+ * solvers derived from SolverBase.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence. This mechanism can also be used
+ * to observe the progress of the iteration. The iterations of the inner
+ * solver are controlled by a separate ReductionControl object and are not
+ * reported to the SolverControl object passed to the constructor.
+ */
+template <typename VectorType      = Vector<double>,
+          typename InnerSolverType = SolverCG<VectorType>>
+class SolverIterativeRefinement : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, the inner solver reduces the residual by two
+     * orders of magnitude in each step of the outer iteration.
+     */
+    explicit AdditionalData(
+      const double       inner_reduction      = 1e-2,
+      const unsigned int max_inner_iterations = 1000,
+      const typename InnerSolverType::AdditionalData &inner_solver_data =
+        typename InnerSolverType::AdditionalData());
+
+    /**
+     * The factor by which the inner solver reduces the residual in each step
+     * of the outer iteration.
+     */
+    double inner_reduction;
+
+    /**
+     * The maximal number of iterations of the inner solver in each step of
+     * the outer iteration. If the inner solver does not reach the requested
+     * reduction within this number of iterations, the correction computed so
+     * far is used nonetheless.
+     */
+    unsigned int max_inner_iterations;
+
+    /**
+     * Additional data passed to the inner solver.
+     */
+    typename InnerSolverType::AdditionalData inner_solver_data;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverIterativeRefinement(SolverControl            &cn,
+                            VectorMemory<VectorType> &mem,
+                            const AdditionalData     &data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverIterativeRefinement(SolverControl        &cn,
+                            const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x, using @p inner_matrix and
+   * @p inner_preconditioner to compute the corrections with the inner
+   * solver.
+   */
+  template <typename MatrixType,
+            typename InnerMatrixType,
+            typename InnerPreconditionerType>
+  void
+  solve(const MatrixType              &A,
+        VectorType                    &x,
+        const VectorType              &b,
+        const InnerMatrixType         &inner_matrix,
+        const InnerPreconditionerType &inner_preconditioner);
+
+  /**
+   * Return the total number of iterations of the inner solver accumulated
+   * over all steps of the last call to solve().
+   */
+  unsigned int
+  n_inner_iterations() const;
+
+protected:
+  /**
+   * Control parameters.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The accumulated number of inner iterations of the last call to solve().
+   */
+  unsigned int accumulated_inner_iterations;
+};
+
+/** @} */
+/*------------ Implementation of the iterative refinement method ------------*/
+
+#ifndef DOXYGEN
+
+template <typename VectorType, typename InnerSolverType>
+inline SolverIterativeRefinement<VectorType, InnerSolverType>::AdditionalData::
+  AdditionalData(
+    const double                                    inner_reduction,
+    const unsigned int                              max_inner_iterations,
+    const typename InnerSolverType::AdditionalData &inner_solver_data)
+  : inner_reduction(inner_reduction)
+  , max_inner_iterations(max_inner_iterations)
+  , inner_solver_data(inner_solver_data)
+{}
+
+
+
+template <typename VectorType, typename InnerSolverType>
+SolverIterativeRefinement<VectorType, InnerSolverType>::
+  SolverIterativeRefinement(SolverControl            &cn,
+                            VectorMemory<VectorType> &mem,
+                            const AdditionalData     &data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+  , accumulated_inner_iterations(0)
+{}
+
+
+
+template <typename VectorType, typename InnerSolverType>
+SolverIterativeRefinement<VectorType, InnerSolverType>::
+  SolverIterativeRefinement(SolverControl &cn, const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+  , accumulated_inner_iterations(0)
+{}
+
+
+
+template <typename VectorType, typename InnerSolverType>
+template <typename MatrixType,
+          typename InnerMatrixType,
+          typename InnerPreconditionerType>
+void
+SolverIterativeRefinement<VectorType, InnerSolverType>::solve(
+  const MatrixType              &A,
+  VectorType                    &x,
+  const VectorType              &b,
+  const InnerMatrixType         &inner_matrix,
+  const InnerPreconditionerType &inner_preconditioner)
+{
+  SolverControl::State conv = SolverControl::iterate;
+
+  double last_criterion = std::numeric_limits<double>::lowest();
+
+  unsigned int iter = 0;
+
+  accumulated_inner_iterations = 0;
+
+  // Memory allocation.
+  // 'Vr' holds the residual, 'Vd' the correction
+  typename VectorMemory<VectorType>::Pointer Vr(this->memory);
+  typename VectorMemory<VectorType>::Pointer Vd(this->memory);
+
+  VectorType &r = *Vr;
+  r.reinit(x);
+
+  VectorType &d = *Vd;
+  d.reinit(x);
+
+  LogStream::Prefix prefix("IterativeRefinement");
+
+  // Main loop
+  while (conv == SolverControl::iterate)
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+
+      last_criterion = r.l2_norm();
+      conv           = this->iteration_status(iter, last_criterion, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // compute the correction with the inner solver. an inexact correction
+      // still improves the solution, so we do not abort the outer iteration
+      // if the inner solver does not reach its tolerance
+      ReductionControl inner_control(additional_data.max_inner_iterations,
+                                     0.,
+                                     additional_data.inner_reduction,
+                                     false,
+                                     false);
+      InnerSolverType  inner_solver(inner_control,
+                                    this->memory,
+                                    additional_data.inner_solver_data);
+      d = 0.;
+      try
+        {
+          inner_solver.solve(inner_matrix, d, r, inner_preconditioner);
+        }
+      catch (const SolverControl::NoConvergence &)
+        {}
+      accumulated_inner_iterations += inner_control.last_step();
+
+      x += d;
+
+      ++iter;
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(iter, last_criterion));
+  // otherwise exit as normal
+}
+
+
+
+template <typename VectorType, typename InnerSolverType>
+inline unsigned int
+SolverIterativeRefinement<VectorType, InnerSolverType>::n_inner_iterations()
+  const
+{
+  return accumulated_inner_iterations;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
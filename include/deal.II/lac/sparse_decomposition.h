@@ -18,6 +18,9 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/sparse_matrix.h>
 
 #include <cmath>
@@ -319,11 +322,57 @@ protected:
   std::vector<const size_type *> prebuilt_lower_bound;
 
   /**
-   * Fills the #prebuilt_lower_bound array.
+   * Fills the #prebuilt_lower_bound array and the level sets used by
+   * apply_to_level_sets().
    */
   void
   prebuild_lower_bound();
 
+  /**
+   * Group the rows of the matrix into level sets for the lower and the upper
+   * triangular part, respectively. A row in level $l$ of the lower
+   * triangular part only couples to rows in levels $0,\ldots,l-1$ left of
+   * the diagonal, so all rows within a level can be processed concurrently
+   * in forward substitutions and in a row-wise factorization. The level sets
+   * of the upper triangular part are defined in the same way for the entries
+   * right of the diagonal, i.e., for backward substitutions. This function is
+   * called by prebuild_lower_bound().
+   */
+  void
+  prebuild_level_sets();
+
+  /**
+   * Call @p row_function for all rows of the matrix in an order that
+   * respects the dependencies of a forward substitution (if @p lower is
+   * true) or a backward substitution (if @p lower is false), i.e., a row is
+   * only processed once all rows it couples to left (right) of the diagonal
+   * have been processed. The level sets computed by prebuild_level_sets()
+   * are worked on one after the other, with the rows of each level
+   * distributed among the available threads. If only one thread is
+   * available, the rows are processed in their natural order. Since the
+   * operations done for a single row are the same in both cases, the result
+   * does not depend on the number of threads.
+   */
+  template <typename RowFunction>
+  void
+  apply_to_level_sets(const bool lower, const RowFunction &row_function) const;
+
+  /**
+   * The rows of the matrix sorted by their level set in the lower
+   * triangular part, and the indices into this array where each level
+   * starts.
+   */
+  std::vector<size_type> lower_level_rows;
+  std::vector<size_type> lower_level_start;
+
+  /**
+   * The rows of the matrix sorted by their level set in the upper
+   * triangular part, and the indices into this array where each level
+   * starts.
+   */
+  std::vector<size_type> upper_level_rows;
+  std::vector<size_type> upper_level_start;
+
 private:
   /**
    * In general this pointer is zero except for the case that no
@@ -408,6 +457,56 @@ SparseLUDecomposition<number>::Tvmult_add(OutVector      &dst,
   dst += tmp;
 }
 
+
+
+template <typename number>
+template <typename RowFunction>
+inline void
+SparseLUDecomposition<number>::apply_to_level_sets(
+  const bool         lower,
+  const RowFunction &row_function) const
+{
+  const size_type N = this->m();
+  const size_type grain_size =
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size;
+
+  // with a single thread or small matrices, the overhead of the level sets
+  // does not pay off, so work on the rows in their natural order
+  if (MultithreadInfo::n_threads() == 1 || N < 2 * grain_size)
+    {
+      if (lower)
+        for (size_type row = 0; row < N; ++row)
+          row_function(row);
+      else
+        for (size_type row = N; row > 0;)
+          row_function(--row);
+      return;
+    }
+
+  const std::vector<size_type> &rows =
+    lower ? lower_level_rows : upper_level_rows;
+  const std::vector<size_type> &level_start =
+    lower ? lower_level_start : upper_level_start;
+  Assert(rows.size() == N, ExcInternalError());
+
+  for (unsigned int level = 0; level + 1 < level_start.size(); ++level)
+    {
+      // only spawn tasks for levels that are large enough
+      if (level_start[level + 1] - level_start[level] < 2 * grain_size)
+        for (size_type i = level_start[level]; i < level_start[level + 1]; ++i)
+          row_function(rows[i]);
+      else
+        parallel::apply_to_subranges(
+          level_start[level],
+          level_start[level + 1],
+          [&rows, &row_function](const size_type begin, const size_type end) {
+            for (size_type i = begin; i < end; ++i)
+              row_function(rows[i]);
+          },
+          grain_size);
+    }
+}
+
 //---------------------------------------------------------------------------
 
 
@@ -57,6 +57,11 @@ SparseLUDecomposition<number>::clear()
   std::vector<const size_type *> tmp;
   tmp.swap(prebuilt_lower_bound);
 
+  lower_level_rows.clear();
+  lower_level_start.clear();
+  upper_level_rows.clear();
+  upper_level_start.clear();
+
   SparseMatrix<number>::clear();
 
   if (own_sparsity != nullptr)
@@ -157,6 +162,66 @@ SparseLUDecomposition<number>::prebuild_lower_bound()
                                &column_numbers[rowstart_indices[row + 1]],
                                row);
     }
+
+  prebuild_level_sets();
+}
+
+
+
+template <typename number>
+void
+SparseLUDecomposition<number>::prebuild_level_sets()
+{
+  const size_type *const column_numbers =
+    this->get_sparsity_pattern().colnums.get();
+  const std::size_t *const rowstart_indices =
+    this->get_sparsity_pattern().rowstart.get();
+  const size_type N = this->m();
+
+  // sort the rows by their level with a counting sort, which keeps the rows
+  // within a level in ascending order
+  const auto sort_by_level = [N](const std::vector<size_type> &row_level,
+                                 std::vector<size_type>       &level_rows,
+                                 std::vector<size_type>       &level_start) {
+    const size_type n_levels =
+      N > 0 ? *std::max_element(row_level.begin(), row_level.end()) + 1 : 0;
+    level_start.clear();
+    level_start.resize(n_levels + 1, 0);
+    for (size_type row = 0; row < N; ++row)
+      ++level_start[row_level[row] + 1];
+    for (size_type level = 0; level < n_levels; ++level)
+      level_start[level + 1] += level_start[level];
+
+    std::vector<size_type> next_position(level_start.begin(),
+                                         level_start.end() - 1);
+    level_rows.resize(N);
+    for (size_type row = 0; row < N; ++row)
+      level_rows[next_position[row_level[row]]++] = row;
+  };
+
+  std::vector<size_type> row_level(N, 0);
+
+  // lower triangular part: the entries between the diagonal, which is
+  // stored first, and the first entry right of the diagonal
+  for (size_type row = 0; row < N; ++row)
+    for (const size_type *col = &column_numbers[rowstart_indices[row] + 1];
+         col != prebuilt_lower_bound[row];
+         ++col)
+      row_level[row] = std::max(row_level[row], row_level[*col] + 1);
+  sort_by_level(row_level, lower_level_rows, lower_level_start);
+
+  // upper triangular part: the entries from the first entry right of the
+  // diagonal to the end of the row
+  std::fill(row_level.begin(), row_level.end(), 0);
+  for (size_type row = N; row > 0;)
+    {
+      --row;
+      for (const size_type *col = prebuilt_lower_bound[row];
+           col != &column_numbers[rowstart_indices[row + 1]];
+           ++col)
+        row_level[row] = std::max(row_level[row], row_level[*col] + 1);
+    }
+  sort_by_level(row_level, upper_level_rows, upper_level_start);
 }
 
 template <typename number>
@@ -239,7 +304,11 @@ std::size_t
 SparseLUDecomposition<number>::memory_consumption() const
 {
   return (SparseMatrix<number>::memory_consumption() +
-          MemoryConsumption::memory_consumption(prebuilt_lower_bound));
+          MemoryConsumption::memory_consumption(prebuilt_lower_bound) +
+          MemoryConsumption::memory_consumption(lower_level_rows) +
+          MemoryConsumption::memory_consumption(lower_level_start) +
+          MemoryConsumption::memory_consumption(upper_level_rows) +
+          MemoryConsumption::memory_consumption(upper_level_start));
 }
 
 
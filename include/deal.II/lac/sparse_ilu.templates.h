@@ -20,6 +20,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/thread_local_storage.h>
+
 #include <deal.II/lac/sparse_ilu.h>
 #include <deal.II/lac/vector.h>
 
@@ -61,74 +63,55 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
 
   number *luval = this->SparseMatrix<number>::val.get();
 
-  const size_type N    = this->m();
-  size_type       jrow = 0;
-
-  std::vector<size_type> iw(N, numbers::invalid_size_type);
-
-  for (size_type k = 0; k < N; ++k)
-    {
-      const size_type j1 = ia[k], j2 = ia[k + 1] - 1;
-
-      for (size_type j = j1; j <= j2; ++j)
-        iw[ja[j]] = j;
+  const size_type N = this->m();
 
-      // the algorithm in the book works on the elements of row k left of the
-      // diagonal. however, since we store the diagonal element at the first
-      // position, start at the element after the diagonal and run as long as
-      // we don't walk into the right half
-      size_type j = j1 + 1;
+  // row k of the factorization only reads from the rows left of the diagonal
+  // of row k, so we can work on the rows of the level sets of the lower
+  // triangular part in parallel. each thread needs its own array that maps
+  // the column indices to the positions in the current row
+  Threads::ThreadLocalStorage<std::vector<size_type>> iw_storage(
+    std::vector<size_type>(N, numbers::invalid_size_type));
 
-      // pathological case: the current row of the matrix has only the
-      // diagonal entry. then we have nothing to do.
-      if (j > j2)
-        goto label_200;
+  this->apply_to_level_sets(true, [&](const size_type k) {
+    std::vector<size_type> &iw = iw_storage.get();
 
-    label_150:
+    const size_type j1 = ia[k], j2 = ia[k + 1] - 1;
 
-      jrow = ja[j];
-      if (jrow >= k)
-        goto label_200;
+    for (size_type j = j1; j <= j2; ++j)
+      iw[ja[j]] = j;
 
-      // actual computations:
+    // the algorithm in the book works on the elements of row k left of the
+    // diagonal. however, since we store the diagonal element at the first
+    // position, start at the element after the diagonal and run as long as
+    // we don't walk into the right half
+    for (size_type j = j1 + 1; j <= j2 && ja[j] < k; ++j)
       {
+        const size_type jrow = ja[j];
+
         number t1 = luval[j] * luval[ia[jrow]];
         luval[j]  = t1;
 
         // jj runs from just right of the diagonal to the end of the row
-        size_type jj = ia[jrow] + 1;
-        while (ja[jj] < jrow)
-          ++jj;
-        for (; jj < ia[jrow + 1]; ++jj)
+        for (size_type jj = this->prebuilt_lower_bound[jrow] - ja;
+             jj < ia[jrow + 1];
+             ++jj)
           {
             const size_type jw = iw[ja[jj]];
             if (jw != numbers::invalid_size_type)
               luval[jw] -= t1 * luval[jj];
           }
-
-        ++j;
-        if (j <= j2)
-          goto label_150;
       }
 
-    label_200:
-
-      // in the book there is an assertion that we have hit the diagonal
-      // element, i.e. that jrow==k. however, we store the diagonal element at
-      // the front, so jrow must actually be larger than k or j is already in
-      // the next row
-      Assert((jrow > k) || (j == ia[k + 1]), ExcInternalError());
-
-      // now we have to deal with the diagonal element. in the book it is
-      // located at position 'j', but here we use the convention of storing
-      // the diagonal element first, so instead of j we use uptr[k]=ia[k]
-      Assert(luval[ia[k]] != 0, ExcZeroPivot(k));
+    // now we have to deal with the diagonal element. in the book it is
+    // located at position 'j', but here we use the convention of storing
+    // the diagonal element first, so instead of j we use uptr[k]=ia[k]
+    Assert(luval[ia[k]] != 0, ExcZeroPivot(k));
 
-      luval[ia[k]] = 1. / luval[ia[k]];
+    luval[ia[k]] = 1. / luval[ia[k]];
 
-      for (size_type j = j1; j <= j2; ++j)
-        iw[ja[j]] = numbers::invalid_size_type;
-    }
+    for (size_type j = j1; j <= j2; ++j)
+      iw[ja[j]] = numbers::invalid_size_type;
+  });
 }
 
 
@@ -143,7 +126,6 @@ SparseILU<number>::vmult(Vector<somenumber>       &dst,
          ExcDimensionMismatch(dst.size(), src.size()));
   Assert(dst.size() == this->m(), ExcDimensionMismatch(dst.size(), this->m()));
 
-  const size_type          N = dst.size();
   const std::size_t *const rowstart_indices =
     this->get_sparsity_pattern().rowstart.get();
   const size_type *const column_numbers =
@@ -161,26 +143,28 @@ SparseILU<number>::vmult(Vector<somenumber>       &dst,
   // we split the y_i = b_i off and
   // perform it at the outset of the
   // loop
+  //
+  // the rows within each level set of the lower (upper) triangular part are
+  // independent of each other, so we can work on them in parallel
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      // get start of this row. skip the
-      // diagonal element
-      const size_type *const rowstart =
-        &column_numbers[rowstart_indices[row] + 1];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval =
-        this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
-      for (const size_type *col = rowstart; col != first_after_diagonal;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-      dst(row) = dst_row;
-    }
+  this->apply_to_level_sets(true, [&](const size_type row) {
+    // get start of this row. skip the
+    // diagonal element
+    const size_type *const rowstart =
+      &column_numbers[rowstart_indices[row] + 1];
+    // find the position where the part
+    // right of the diagonal starts
+    const size_type *const first_after_diagonal =
+      this->prebuilt_lower_bound[row];
+
+    somenumber    dst_row = dst(row);
+    const number *luval =
+      this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
+    for (const size_type *col = rowstart; col != first_after_diagonal;
+         ++col, ++luval)
+      dst_row -= *luval * dst(*col);
+    dst(row) = dst_row;
+  });
 
   // now the backward solve. same
   // procedure, but we need not set
@@ -190,28 +174,26 @@ SparseILU<number>::vmult(Vector<somenumber>       &dst,
   // note that we need to scale now,
   // since the diagonal is not equal to
   // one now
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      const size_type *const rowend =
-        &column_numbers[rowstart_indices[row + 1]];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval   = this->SparseMatrix<number>::val.get() +
-                            (first_after_diagonal - column_numbers);
-      for (const size_type *col = first_after_diagonal; col != rowend;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-
-      // scale by the diagonal element.
-      // note that the diagonal element
-      // was stored inverted
-      dst(row) = dst_row * this->diag_element(row);
-    }
+  this->apply_to_level_sets(false, [&](const size_type row) {
+    // get end of this row
+    const size_type *const rowend = &column_numbers[rowstart_indices[row + 1]];
+    // find the position where the part
+    // right of the diagonal starts
+    const size_type *const first_after_diagonal =
+      this->prebuilt_lower_bound[row];
+
+    somenumber    dst_row = dst(row);
+    const number *luval   = this->SparseMatrix<number>::val.get() +
+                          (first_after_diagonal - column_numbers);
+    for (const size_type *col = first_after_diagonal; col != rowend;
+         ++col, ++luval)
+      dst_row -= *luval * dst(*col);
+
+    // scale by the diagonal element.
+    // note that the diagonal element
+    // was stored inverted
+    dst(row) = dst_row * this->diag_element(row);
+  });
 }
 
 
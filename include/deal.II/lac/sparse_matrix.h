@@ -1127,6 +1127,14 @@ public:
    * you want to multiply with BlockVector objects, you should consider using
    * a BlockSparseMatrix as well.
    *
+   * The vectors may use a different number type than the matrix. In that
+   * case, the matrix entries are converted to the number type of @p dst and
+   * the products are accumulated in that precision. This allows to store a
+   * SparseMatrix<float> copy of a matrix, which halves the memory traffic
+   * for the matrix entries, while operating on Vector<double> or
+   * LinearAlgebra::distributed::Vector<double> objects without losing
+   * accuracy in the summation, see also the SolverIterativeRefinement class.
+   *
    * Source and destination must not be the same vector.
    *
    * @dealiiOperationIsMultithreaded
@@ -92,27 +92,43 @@ SparseMIC<number>::initialize(const SparseMatrix<somenumber> &matrix,
   inner_sums.resize(this->m());
 
   // precalc sum(j=k+1, N, a[k][j]))
-  for (size_type row = 0; row < this->m(); ++row)
-    inner_sums[row] = get_rowsum(row);
-
-  for (size_type row = 0; row < this->m(); ++row)
-    {
-      const number temp  = this->begin(row)->value();
-      number       temp1 = 0;
-
-      // work on the lower left part of the matrix. we know
-      // it's symmetric, so we can work with this alone
-      for (typename SparseMatrix<somenumber>::const_iterator p =
-             matrix.begin(row) + 1;
-           (p != matrix.end(row)) && (p->column() < row);
-           ++p)
-        temp1 += p->value() / diag[p->column()] * inner_sums[p->column()];
-
-      Assert(temp - temp1 > 0, ExcStrengthenDiagonalTooSmall());
-      diag[row] = temp - temp1;
-
-      inv_diag[row] = 1.0 / diag[row];
-    }
+  parallel::apply_to_subranges(
+    size_type(0),
+    this->m(),
+    [this](const size_type begin, const size_type end) {
+      for (size_type row = begin; row < end; ++row)
+        inner_sums[row] = get_rowsum(row);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+
+  const auto compute_diagonal = [&](const size_type row) {
+    const number temp  = this->begin(row)->value();
+    number       temp1 = 0;
+
+    // work on the lower left part of the matrix. we know
+    // it's symmetric, so we can work with this alone
+    for (typename SparseMatrix<somenumber>::const_iterator p =
+           matrix.begin(row) + 1;
+         (p != matrix.end(row)) && (p->column() < row);
+         ++p)
+      temp1 += p->value() / diag[p->column()] * inner_sums[p->column()];
+
+    Assert(temp - temp1 > 0, ExcStrengthenDiagonalTooSmall());
+    diag[row] = temp - temp1;
+
+    inv_diag[row] = 1.0 / diag[row];
+  };
+
+  // the diagonal of a row depends on the diagonal of the rows left of the
+  // diagonal in the given matrix. if the matrix uses the same sparsity
+  // pattern as this object, these dependencies are described by the level
+  // sets of the lower triangular part and we can work on the rows of each
+  // level in parallel
+  if (&matrix.get_sparsity_pattern() == &this->get_sparsity_pattern())
+    this->apply_to_level_sets(true, compute_diagonal);
+  else
+    for (size_type row = 0; row < this->m(); ++row)
+      compute_diagonal(row);
 }
 
 
@@ -150,39 +166,38 @@ SparseMIC<number>::vmult(Vector<somenumber>       &dst,
   // strictly lower- and upper- diagonal parts of the system.
   //
   // Solve (X-L)X{-1}(X-U) x = b in 3 steps:
+  //
+  // the rows within each level set of the lower (upper) triangular part are
+  // independent of each other, so we can work on them in parallel
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      // Now: (X-L)u = b
-
-      // get start of this row. skip
-      // the diagonal element
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           (p != this->end(row)) && (p->column() < row);
-           ++p)
-        dst(row) -= p->value() * dst(p->column());
+  this->apply_to_level_sets(true, [&](const size_type row) {
+    // Now: (X-L)u = b
 
-      dst(row) *= inv_diag[row];
-    }
+    // get start of this row. skip
+    // the diagonal element
+    for (typename SparseMatrix<number>::const_iterator p = this->begin(row) + 1;
+         (p != this->end(row)) && (p->column() < row);
+         ++p)
+      dst(row) -= p->value() * dst(p->column());
+
+    dst(row) *= inv_diag[row];
+  });
 
   // Now: v = Xu
   for (size_type row = 0; row < N; ++row)
     dst(row) *= diag[row];
 
   // x = (X-U)v
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           p != this->end(row);
-           ++p)
-        if (p->column() > static_cast<size_type>(row))
-          dst(row) -= p->value() * dst(p->column());
-
-      dst(row) *= inv_diag[row];
-    }
+  this->apply_to_level_sets(false, [&](const size_type row) {
+    // get end of this row
+    for (typename SparseMatrix<number>::const_iterator p = this->begin(row) + 1;
+         p != this->end(row);
+         ++p)
+      if (p->column() > row)
+        dst(row) -= p->value() * dst(p->column());
+
+    dst(row) *= inv_diag[row];
+  });
 }
 
 
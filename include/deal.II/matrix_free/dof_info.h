@@ -330,6 +330,29 @@ namespace internal
         const TaskInfo                                &task_info,
         const std::vector<FaceToCellTopology<length>> &faces);
 
+      /**
+       * Fills the arrays @p cell_ghost_target_list_index and @p
+       * cell_ghost_target_list that record, for each cell batch, the
+       * processes in the ghost targets of @p vector_partitioner from which the
+       * cell batch reads ghost data. The indices of all DoFInfo objects in @p
+       * dof_infos whose vector partitioner is compatible with the present one
+       * are taken into account, as vectors set up for the present object can
+       * also be accessed through them. Besides the indices of the cell itself,
+       * the indices of the neighbors across the faces recorded in @p face_info
+       * are included, as a cell can also access the data of its neighbors
+       * via FEFaceEvaluation::reinit(cell, face).
+       *
+       * The intent of this pattern is to start the work on cell batches with
+       * ghost dependencies as soon as the data from the respective processes
+       * has arrived, rather than waiting for the whole ghost exchange.
+       */
+      template <int length>
+      void
+      compute_ghost_target_access_pattern(
+        const TaskInfo             &task_info,
+        const std::vector<DoFInfo> &dof_infos,
+        const FaceInfo<length>     &face_info);
+
       /**
        * Return the memory consumption in bytes of this class.
        */
@@ -766,6 +789,21 @@ namespace internal
        * entries.
        */
       std::vector<std::pair<unsigned int, unsigned int>> cell_loop_post_list;
+
+      /**
+       * Stores an integer to each cell batch that indicates the start of the
+       * list of ghost targets in @p cell_ghost_target_list the cell batch
+       * reads from. Cell batches beyond the size of this array do not access
+       * ghost data.
+       */
+      std::vector<unsigned int> cell_ghost_target_list_index;
+
+      /**
+       * Stores the indices into Utilities::MPI::Partitioner::ghost_targets()
+       * of @p vector_partitioner for the processes whose ghost data is read by
+       * a cell batch.
+       */
+      std::vector<unsigned int> cell_ghost_target_list;
     };
 
 
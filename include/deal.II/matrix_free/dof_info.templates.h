@@ -563,6 +563,132 @@ namespace internal
 
 
 
+    template <int length>
+    void
+    DoFInfo::compute_ghost_target_access_pattern(
+      const TaskInfo             &task_info,
+      const std::vector<DoFInfo> &dof_infos,
+      const FaceInfo<length>     &face_info)
+    {
+      cell_ghost_target_list_index.clear();
+      cell_ghost_target_list.clear();
+
+      const auto &ghost_targets = vector_partitioner->ghost_targets();
+      if (ghost_targets.empty() || task_info.partition_row_index.size() < 4)
+        return;
+
+      AssertDimension(length, vectorization_length);
+
+      // position of the first ghost index of each target in the ghost range
+      // of the vector
+      std::vector<unsigned int> ghost_target_starts(ghost_targets.size() + 1);
+      for (unsigned int p = 0; p < ghost_targets.size(); ++p)
+        ghost_target_starts[p + 1] =
+          ghost_target_starts[p] + ghost_targets[p].second;
+      AssertDimension(ghost_target_starts.back(),
+                      vector_partitioner->n_ghost_indices());
+
+      // only the cell batches in the part of the loop that runs after the
+      // ghost exchange can access ghost data
+      const unsigned int locally_owned_size =
+        vector_partitioner->locally_owned_size();
+      const unsigned int end_cell_batch =
+        task_info.cell_partition_data[task_info.partition_row_index[2]];
+      cell_ghost_target_list_index.resize(end_cell_batch + 1);
+
+      std::vector<const DoFInfo *> compatible_dof_infos;
+      for (const DoFInfo &dof_info : dof_infos)
+        if (dof_info.vector_partitioner.get() == vector_partitioner.get() ||
+            dof_info.vector_partitioner->is_compatible(*vector_partitioner))
+          compatible_dof_infos.push_back(&dof_info);
+
+      std::vector<unsigned int> targets_of_batch;
+      const auto add_index = [&](const unsigned int index) {
+        if (index >= locally_owned_size &&
+            index != numbers::invalid_unsigned_int)
+          targets_of_batch.push_back(
+            std::upper_bound(ghost_target_starts.begin(),
+                             ghost_target_starts.end(),
+                             index - locally_owned_size) -
+            ghost_target_starts.begin() - 1);
+      };
+
+      // collects the indices of a (locally owned or ghost) cell, including
+      // the unconstrained indices read for hanging node constraints
+      const auto add_indices_of_cell = [&](const DoFInfo     &dof_info,
+                                           const unsigned int cell) {
+        const unsigned int n_components = dof_info.start_components.back();
+        for (unsigned int it = dof_info.row_starts[cell * n_components].first;
+             it != dof_info.row_starts[(cell + 1) * n_components].first;
+             ++it)
+          add_index(dof_info.dof_indices[it]);
+
+        if (dof_info.row_starts_plain_indices.size() > cell &&
+            dof_info.row_starts_plain_indices[cell] !=
+              numbers::invalid_unsigned_int)
+          {
+            const unsigned int n_dofs =
+              dof_info.dofs_per_cell[dof_info.cell_active_fe_index.empty() ?
+                                       0 :
+                                       dof_info.cell_active_fe_index
+                                         [cell / vectorization_length]];
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              add_index(
+                dof_info
+                  .plain_dof_indices[dof_info.row_starts_plain_indices[cell] +
+                                     i]);
+          }
+      };
+
+      const Table<3, unsigned int> &cell_and_face_to_plain_faces =
+        face_info.cell_and_face_to_plain_faces;
+      for (unsigned int batch = 0; batch < end_cell_batch; ++batch)
+        {
+          targets_of_batch.clear();
+          for (const DoFInfo *dof_info_ptr : compatible_dof_infos)
+            for (unsigned int v = 0; v < vectorization_length; ++v)
+              {
+                const unsigned int cell = batch * vectorization_length + v;
+                add_indices_of_cell(*dof_info_ptr, cell);
+
+                // a cell batch can also read the data of its face neighbors
+                // through FEFaceEvaluation::reinit(cell, face), e.g. in
+                // MatrixFree::loop_cell_centric(), which in DG accesses
+                // ghost data that is not among the indices of the cell
+                if (batch < cell_and_face_to_plain_faces.size(0))
+                  for (unsigned int f = 0;
+                       f < cell_and_face_to_plain_faces.size(1);
+                       ++f)
+                    {
+                      const unsigned int face_index =
+                        cell_and_face_to_plain_faces(batch, f, v);
+                      if (face_index == numbers::invalid_unsigned_int)
+                        continue;
+                      const FaceToCellTopology<length> &face =
+                        face_info.faces[face_index / length];
+                      const unsigned int lane = face_index % length;
+                      const unsigned int neighbor =
+                        face.cells_interior[lane] == cell ?
+                          face.cells_exterior[lane] :
+                          face.cells_interior[lane];
+                      if (neighbor != numbers::invalid_unsigned_int)
+                        add_indices_of_cell(*dof_info_ptr, neighbor);
+                    }
+              }
+          std::sort(targets_of_batch.begin(), targets_of_batch.end());
+          targets_of_batch.erase(std::unique(targets_of_batch.begin(),
+                                             targets_of_batch.end()),
+                                 targets_of_batch.end());
+          cell_ghost_target_list.insert(cell_ghost_target_list.end(),
+                                        targets_of_batch.begin(),
+                                        targets_of_batch.end());
+          cell_ghost_target_list_index[batch + 1] =
+            cell_ghost_target_list.size();
+        }
+    }
+
+
+
     namespace internal
     {
       // rudimentary version of a vector that keeps entries always ordered
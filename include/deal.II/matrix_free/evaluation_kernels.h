@@ -651,7 +651,80 @@ namespace internal
           }
       }
 
-    if (evaluation_flag & EvaluationFlags::gradients)
+    if ((evaluation_flag & EvaluationFlags::gradients) &&
+        fe_eval.get_shape_info().n_q_points_1d_collapsed > 0)
+      {
+        // the quadrature formula is a collapsed tensor product, so we can
+        // compute the gradients from the values in the quadrature points by
+        // sum factorization in the collapsed coordinates and transform them
+        // to the reference simplex afterwards
+        const std::size_t n_q_points_1d_collapsed =
+          fe_eval.get_shape_info().n_q_points_1d_collapsed;
+        const Number2 *collapsed_gradients =
+          fe_eval.get_shape_info().collapsed_coordinate_gradients.data();
+        using EvalCollapsed =
+          EvaluatorTensorProduct<evaluate_general, dim, 0, 0, Number, Number2>;
+        EvalCollapsed eval(
+          nullptr,
+          shape_data.front().shape_gradients_collocation.data(),
+          nullptr,
+          n_q_points_1d_collapsed,
+          n_q_points_1d_collapsed);
+
+        Number *values_tmp         = fe_eval.get_scratch_data().begin();
+        Number *derivatives        = values_tmp + n_q_points;
+        auto   *gradients_quad_ptr = fe_eval.begin_gradients();
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            const Number *values_quad = fe_eval.begin_values() + c * n_q_points;
+            if (!(evaluation_flag & EvaluationFlags::values))
+              {
+                Eval eval_values(shape_data.front().shape_values.data(),
+                                 nullptr,
+                                 nullptr,
+                                 n_dofs,
+                                 n_q_points);
+                eval_values.template values<0, true, false>(
+                  values_dofs_actual + c * n_dofs, values_tmp);
+                values_quad = values_tmp;
+              }
+
+            // add the contribution of the derivative in collapsed direction
+            // e to the gradient on the reference simplex
+            const auto transform = [&](const unsigned int e) {
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  const Number2 *factors =
+                    collapsed_gradients + (e * dim + d) * n_q_points;
+                  if (e == 0)
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      gradients_quad_ptr[q * dim + d] =
+                        factors[q] * derivatives[q];
+                  else
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      gradients_quad_ptr[q * dim + d] +=
+                        factors[q] * derivatives[q];
+                }
+            };
+
+            eval.template gradients<0, true, false>(values_quad, derivatives);
+            transform(0);
+            if constexpr (dim > 1)
+              {
+                eval.template gradients<1, true, false>(values_quad,
+                                                        derivatives);
+                transform(1);
+              }
+            if constexpr (dim > 2)
+              {
+                eval.template gradients<2, true, false>(values_quad,
+                                                        derivatives);
+                transform(2);
+              }
+            gradients_quad_ptr += n_q_points * dim;
+          }
+      }
+    else if (evaluation_flag & EvaluationFlags::gradients)
       {
         const auto *const shape_gradients =
           shape_data.front().shape_gradients.data();
@@ -706,6 +779,86 @@ namespace internal
     using Eval =
       EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number2>;
 
+    if ((integration_flag & EvaluationFlags::gradients) &&
+        fe_eval.get_shape_info().n_q_points_1d_collapsed > 0)
+      {
+        // transpose of the evaluation with sum factorization in collapsed
+        // coordinates: transform the gradients to the collapsed coordinates,
+        // sum them into the values in the quadrature points, and apply the
+        // transpose of the interpolation matrix once for values and
+        // gradients
+        const std::size_t n_q_points_1d_collapsed =
+          fe_eval.get_shape_info().n_q_points_1d_collapsed;
+        const Number2 *collapsed_gradients =
+          fe_eval.get_shape_info().collapsed_coordinate_gradients.data();
+        using EvalCollapsed =
+          EvaluatorTensorProduct<evaluate_general, dim, 0, 0, Number, Number2>;
+        EvalCollapsed eval(
+          nullptr,
+          shape_data.front().shape_gradients_collocation.data(),
+          nullptr,
+          n_q_points_1d_collapsed,
+          n_q_points_1d_collapsed);
+        Eval eval_values(shape_data.front().shape_values.data(),
+                         nullptr,
+                         nullptr,
+                         n_dofs,
+                         n_q_points);
+
+        Number     *values_tmp         = fe_eval.get_scratch_data().begin();
+        Number     *derivatives        = values_tmp + n_q_points;
+        const auto *gradients_quad_ptr = fe_eval.begin_gradients();
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            if (integration_flag & EvaluationFlags::values)
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                values_tmp[q] = fe_eval.begin_values()[c * n_q_points + q];
+            else
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                values_tmp[q] = Number();
+
+            // compute the test function contributions of the derivative in
+            // collapsed direction e from the gradient on the reference simplex
+            const auto transform = [&](const unsigned int e) {
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                derivatives[q] = Number();
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  const Number2 *factors =
+                    collapsed_gradients + (e * dim + d) * n_q_points;
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    derivatives[q] +=
+                      factors[q] * gradients_quad_ptr[q * dim + d];
+                }
+            };
+
+            transform(0);
+            eval.template gradients<0, false, true>(derivatives, values_tmp);
+            if constexpr (dim > 1)
+              {
+                transform(1);
+                eval.template gradients<1, false, true>(derivatives,
+                                                        values_tmp);
+              }
+            if constexpr (dim > 2)
+              {
+                transform(2);
+                eval.template gradients<2, false, true>(derivatives,
+                                                        values_tmp);
+              }
+
+            if (add_into_values_array == false)
+              eval_values.template values<0, false, false>(
+                values_tmp, values_dofs_actual + c * n_dofs);
+            else
+              eval_values.template values<0, false, true>(
+                values_tmp, values_dofs_actual + c * n_dofs);
+
+            gradients_quad_ptr += n_q_points * dim;
+          }
+        return;
+      }
+
     if (integration_flag & EvaluationFlags::values)
       {
         const auto *const shape_values = shape_data.front().shape_values.data();
@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2020 - 2022 by the deal.II authors
+// Copyright (C) 2020 - 2023 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -24,6 +24,14 @@
 #  define FE_EVAL_FACTORY_DEGREE_MAX 6
 #endif
 
+// For degrees above FE_EVAL_FACTORY_DEGREE_MAX, only the most common
+// combinations with n_q_points_1d = degree + 1 and the over-integration
+// n_q_points_1d = 3 * degree / 2 + 1 (e.g. for de-aliasing of nonlinear
+// terms) are pre-compiled, up to this degree
+#ifndef FE_EVAL_FACTORY_DEGREE_MAX_OVERINTEGRATION
+#  define FE_EVAL_FACTORY_DEGREE_MAX_OVERINTEGRATION 8
+#endif
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace internal
@@ -43,6 +51,15 @@ namespace internal
     }
   };
 
+  /**
+   * The largest degree for which instantiation_helper_run() selects
+   * templated code paths.
+   */
+  constexpr int instantiation_helper_degree_max =
+    FE_EVAL_FACTORY_DEGREE_MAX > FE_EVAL_FACTORY_DEGREE_MAX_OVERINTEGRATION ?
+      FE_EVAL_FACTORY_DEGREE_MAX :
+      FE_EVAL_FACTORY_DEGREE_MAX_OVERINTEGRATION;
+
   template <int degree, typename EvaluatorType, typename... Args>
   bool
   instantiation_helper_run(const unsigned int given_degree,
@@ -53,22 +70,27 @@ namespace internal
       {
         if (n_q_points_1d == degree + 1)
           return EvaluatorType::template run<degree, degree + 1>(args...);
-        else if (n_q_points_1d == degree + 2)
-          return EvaluatorType::template run<degree, degree + 2>(args...);
-        else if (n_q_points_1d == degree)
-          return EvaluatorType::template run<degree, degree>(args...);
         else if (n_q_points_1d == (3 * degree) / 2 + 1)
           return EvaluatorType::template run<degree, (3 * degree) / 2 + 1>(
             args...);
-        else if ((n_q_points_1d == (2 * degree)) && (degree <= 4))
-          return EvaluatorType::template run<degree, (2 * degree)>(args...);
-        else
-          // slow path
-          return EvaluatorType::template run<-1, 0>(args...);
+
+        if constexpr (degree <= FE_EVAL_FACTORY_DEGREE_MAX)
+          {
+            if (n_q_points_1d == degree + 2)
+              return EvaluatorType::template run<degree, degree + 2>(args...);
+            else if (n_q_points_1d == degree)
+              return EvaluatorType::template run<degree, degree>(args...);
+            else if ((n_q_points_1d == (2 * degree)) && (degree <= 4))
+              return EvaluatorType::template run<degree, (2 * degree)>(
+                args...);
+          }
+
+        // slow path
+        return EvaluatorType::template run<-1, 0>(args...);
       }
-    else if (degree < FE_EVAL_FACTORY_DEGREE_MAX)
+    else if (degree < instantiation_helper_degree_max)
       return instantiation_helper_run<
-        (degree < FE_EVAL_FACTORY_DEGREE_MAX ? degree + 1 : degree),
+        (degree < instantiation_helper_degree_max ? degree + 1 : degree),
         EvaluatorType>(given_degree, n_q_points_1d, args...);
     else
       // slow path
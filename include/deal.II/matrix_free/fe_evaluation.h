@@ -37,6 +37,7 @@
 #include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/mapping_data_on_the_fly.h>
 #include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/performance_counters.h>
 #include <deal.II/matrix_free/shape_info.h>
 #include <deal.II/matrix_free/tensor_product_kernels.h>
 #include <deal.II/matrix_free/type_traits.h>
@@ -725,6 +726,16 @@ protected:
   void
   apply_hanging_node_constraints(const bool transpose) const;
 
+  /**
+   * For an object initialized from a MatrixFree object, give this object its
+   * own copy of the geometry that @p other computed on the fly into its
+   * internal storage and let the geometry pointers refer to the copy, such
+   * that a later call to reinit() on either object does not overwrite the
+   * data of the other.
+   */
+  void
+  copy_geometry_computed_on_the_fly(const FEEvaluationBase &other);
+
   /**
    * This is the general array for all data fields.
    */
@@ -1696,8 +1707,10 @@ protected:
  * core. The non-templated version is also fastest at polynomial degree 5 with
  * 2.1e-9 seconds per degree of freedom or 48 million degrees of freedom per
  * second. Note that using FEEvaluation with template `degree=-1` selects the
- * fast path for degrees between one and six, and the slow path for other
- * degrees.
+ * fast path for degrees between one and six, as well as for degrees seven and
+ * eight with either `degree+1` quadrature points or the over-integration
+ * with `3*degree/2+1` quadrature points per direction typically used for
+ * de-aliasing nonlinear terms, and the slow path for other degrees.
  *
  * <h4>Pre-compiling code for more polynomial degrees</h4>
  *
@@ -1716,8 +1729,11 @@ protected:
  * `FE_EVAL_FACTORY_DEGREE_MAX` overridden to the desired value. In the second
  * option, symbols will be available twice, and it depends on your linker and
  * dynamic library loader whether the user-specified setting takes precedence;
- * use `LD_PRELOAD` to select the desired library. You can check if fast
- * evaluation/integration for a given degree/n_quadrature_points pair by
+ * use `LD_PRELOAD` to select the desired library. The set of degrees with
+ * `degree+1` and `3*degree/2+1` quadrature points per direction can be
+ * extended separately by the macro
+ * `FE_EVAL_FACTORY_DEGREE_MAX_OVERINTEGRATION` (default 8). You can check if
+ * fast evaluation/integration for a given degree/n_quadrature_points pair by
  * calling FEEvaluation::fast_evaluation_supported() or
  * FEFaceEvaluation::fast_evaluation_supported().
  *
@@ -2326,6 +2342,15 @@ private:
   void
   check_template_arguments(const unsigned int fe_no,
                            const unsigned int first_selected_component);
+
+  /**
+   * Return the estimated number of floating point operations of one lane in
+   * the evaluation or integration with the given flags for the performance
+   * counters of MatrixFreeTools::PerformanceCounters.
+   */
+  double
+  estimate_evaluation_flops(
+    const EvaluationFlags::EvaluationFlags evaluation_flag) const;
 };
 
 
@@ -2997,6 +3022,8 @@ inline FEEvaluationBase<dim,
       this->quadrature_points =
         this->mapped_geometry->get_data_storage().quadrature_points.begin();
     }
+  else
+    copy_geometry_computed_on_the_fly(other);
 
   this->set_data_pointers(scratch_data_array, n_components_);
 }
@@ -3068,6 +3095,7 @@ operator=(const FEEvaluationBase<dim,
   else
     {
       scratch_data_array = matrix_free->acquire_scratch_data();
+      copy_geometry_computed_on_the_fly(other);
     }
 
   this->set_data_pointers(scratch_data_array, n_components_);
@@ -3077,6 +3105,53 @@ operator=(const FEEvaluationBase<dim,
 
 
 
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  copy_geometry_computed_on_the_fly(const FEEvaluationBase &other)
+{
+  Assert(other.matrix_free != nullptr, ExcInternalError());
+
+  // the internal storage is only used for cell batches whose geometry is
+  // computed on the fly, the other geometry data is owned by the MatrixFree
+  // object and can be shared
+  this->mapped_geometry.reset();
+  if (other.mapped_geometry == nullptr)
+    return;
+
+  this->mapped_geometry =
+    std::make_shared<internal::MatrixFreeFunctions::
+                       MappingDataOnTheFly<dim, VectorizedArrayType>>();
+  auto &storage = this->mapped_geometry->get_data_storage();
+  storage       = other.mapped_geometry->get_data_storage();
+
+  const auto &other_storage = other.mapped_geometry->get_data_storage();
+
+  const auto redirect =
+    [](auto &pointer, const auto &other_array, auto &array) {
+      if (other_array.size() > 0 && pointer >= other_array.data() &&
+          pointer < other_array.data() + other_array.size())
+        pointer = array.data() + (pointer - other_array.data());
+    };
+  redirect(this->jacobian, other_storage.jacobians[0], storage.jacobians[0]);
+  redirect(this->J_value, other_storage.JxW_values, storage.JxW_values);
+  redirect(this->jacobian_gradients,
+           other_storage.jacobian_gradients[0],
+           storage.jacobian_gradients[0]);
+  redirect(this->jacobian_gradients_non_inverse,
+           other_storage.jacobian_gradients_non_inverse[0],
+           storage.jacobian_gradients_non_inverse[0]);
+  redirect(this->quadrature_points,
+           other_storage.quadrature_points,
+           storage.quadrature_points);
+}
+
+
+
 template <int dim,
           int n_components_,
           typename Number,
@@ -4345,6 +4420,13 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                   const unsigned int          first_index,
                   const std::bitset<n_lanes> &mask)
 {
+  internal::MatrixFreeFunctions::PerformanceCounterScope counter(
+    MatrixFreeTools::PerformanceCounters::Phase::read_dof_values);
+  if (counter.is_enabled())
+    counter.add_counts(0.,
+                       n_components * this->data->dofs_per_component_on_cell *
+                         n_lanes * sizeof(Number));
+
   const auto src_data = internal::get_vector_data<n_components_>(
     src,
     first_index,
@@ -4412,6 +4494,15 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
          internal::ExcAccessToUninitializedField());
 #  endif
 
+  // the vector entries are read and written
+  internal::MatrixFreeFunctions::PerformanceCounterScope counter(
+    MatrixFreeTools::PerformanceCounters::Phase::distribute_local_to_global);
+  if (counter.is_enabled())
+    counter.add_counts(0.,
+                       2 * n_components *
+                         this->data->dofs_per_component_on_cell * n_lanes *
+                         sizeof(Number));
+
   apply_hanging_node_constraints(true);
 
   const auto dst_data = internal::get_vector_data<n_components_>(
@@ -7471,20 +7562,69 @@ FEEvaluation<dim,
 
   Assert(this->dof_info != nullptr, ExcNotInitialized());
   Assert(this->mapping_data != nullptr, ExcNotInitialized());
+  internal::MatrixFreeFunctions::PerformanceCounterScope counter(
+    MatrixFreeTools::PerformanceCounters::Phase::reinit);
   this->cell = cell_index;
-  this->cell_type =
-    this->matrix_free->get_mapping_info().get_cell_type(cell_index);
+  const auto &mapping_info = this->matrix_free->get_mapping_info();
+  this->cell_type          = mapping_info.get_cell_type(cell_index);
 
-  const unsigned int offsets =
-    this->mapping_data->data_index_offsets[cell_index];
-  this->jacobian = &this->mapping_data->jacobians[0][offsets];
-  this->J_value  = &this->mapping_data->JxW_values[offsets];
-  if (!this->mapping_data->jacobian_gradients[0].empty())
+  if (mapping_info.cell_geometry_is_computed_on_the_fly(cell_index))
     {
-      this->jacobian_gradients =
-        this->mapping_data->jacobian_gradients[0].data() + offsets;
-      this->jacobian_gradients_non_inverse =
-        this->mapping_data->jacobian_gradients_non_inverse[0].data() + offsets;
+      // the geometry of this cell batch is not stored, so compute it from
+      // the support points of the mapping into the internal storage
+      if (this->mapped_geometry == nullptr)
+        this->mapped_geometry =
+          std::make_shared<internal::MatrixFreeFunctions::
+                             MappingDataOnTheFly<dim, VectorizedArrayType>>();
+      auto &mapping_storage = this->mapped_geometry->get_data_storage();
+
+      AlignedVector<VectorizedArrayType> *scratch =
+        this->matrix_free->acquire_scratch_data();
+      mapping_info.compute_cell_geometry_on_the_fly(cell_index,
+                                                    this->quad_no,
+                                                    mapping_storage,
+                                                    *scratch);
+      this->matrix_free->release_scratch_data(scratch);
+
+      this->jacobian          = mapping_storage.jacobians[0].data();
+      this->J_value           = mapping_storage.JxW_values.data();
+      this->quadrature_points = mapping_storage.quadrature_points.data();
+    }
+  else
+    {
+      const unsigned int offsets =
+        this->mapping_data->data_index_offsets[cell_index];
+      this->jacobian = &this->mapping_data->jacobians[0][offsets];
+      this->J_value  = &this->mapping_data->JxW_values[offsets];
+
+      // the inverse Jacobian and JxW are stored once per cell batch for
+      // affine cells, where only the diagonal of the Jacobian is used on
+      // Cartesian cells, and for each quadrature point otherwise
+      if (counter.is_enabled())
+        counter.add_counts(
+          0.,
+          (this->cell_type <= internal::MatrixFreeFunctions::affine ?
+             1 :
+             this->n_quadrature_points) *
+            ((this->cell_type == internal::MatrixFreeFunctions::cartesian ?
+                dim :
+                dim * dim) +
+             1) *
+            sizeof(VectorizedArrayType));
+
+      if (!this->mapping_data->jacobian_gradients[0].empty())
+        {
+          this->jacobian_gradients =
+            this->mapping_data->jacobian_gradients[0].data() + offsets;
+          this->jacobian_gradients_non_inverse =
+            this->mapping_data->jacobian_gradients_non_inverse[0].data() +
+            offsets;
+        }
+
+      if (this->mapping_data->quadrature_points.empty() == false)
+        this->quadrature_points =
+          &this->mapping_data->quadrature_points
+             [this->mapping_data->quadrature_point_offsets[this->cell]];
     }
 
   if (this->matrix_free->n_active_entries_per_cell_batch(this->cell) == n_lanes)
@@ -7503,11 +7643,6 @@ FEEvaluation<dim,
         this->cell_ids[i] = numbers::invalid_unsigned_int;
     }
 
-  if (this->mapping_data->quadrature_points.empty() == false)
-    this->quadrature_points =
-      &this->mapping_data->quadrature_points
-         [this->mapping_data->quadrature_point_offsets[this->cell]];
-
 #  ifdef DEBUG
   this->is_reinitialized           = true;
   this->dof_values_initialized     = false;
@@ -7536,6 +7671,10 @@ FEEvaluation<dim,
 {
   Assert(this->dof_info != nullptr, ExcNotInitialized());
   Assert(this->mapping_data != nullptr, ExcNotInitialized());
+  Assert(this->matrix_free->get_mapping_info()
+             .cell_mapping_support_point_offsets.empty(),
+         ExcMessage("Initialization from a list of cell indices is not "
+                    "possible when the geometry is computed on the fly."));
 
   this->cell     = numbers::invalid_unsigned_int;
   this->cell_ids = cell_ids;
@@ -7876,6 +8015,12 @@ FEEvaluation<dim,
   evaluate(const VectorizedArrayType             *values_array,
            const EvaluationFlags::EvaluationFlags evaluation_flag)
 {
+  internal::MatrixFreeFunctions::PerformanceCounterScope counter(
+    MatrixFreeTools::PerformanceCounters::Phase::evaluate);
+  if (counter.is_enabled())
+    counter.add_counts(n_lanes * estimate_evaluation_flops(evaluation_flag),
+                       0.);
+
   const bool hessians_on_general_cells =
     evaluation_flag & EvaluationFlags::hessians &&
     (this->cell_type > internal::MatrixFreeFunctions::affine);
@@ -8011,7 +8156,16 @@ FEEvaluation<dim,
     internal::check_vector_access_inplace<Number, const VectorizedArrayType>(
       *this, input_vector);
   if (src_ptr != nullptr)
-    evaluate(src_ptr, evaluation_flag);
+    {
+      // the vector entries are read directly by evaluate()
+      if (MatrixFreeTools::PerformanceCounters::is_enabled())
+        internal::MatrixFreeFunctions::add_to_performance_counters(
+          MatrixFreeTools::PerformanceCounters::Phase::read_dof_values,
+          0.,
+          dofs_per_cell * n_lanes * sizeof(Number),
+          0.);
+      evaluate(src_ptr, evaluation_flag);
+    }
   else
     {
       this->read_dof_values(input_vector);
@@ -8083,6 +8237,12 @@ FEEvaluation<dim,
     ExcMessage("Only EvaluationFlags::values, EvaluationFlags::gradients, and "
                "EvaluationFlags::hessians are supported."));
 
+  internal::MatrixFreeFunctions::PerformanceCounterScope counter(
+    MatrixFreeTools::PerformanceCounters::Phase::integrate);
+  if (counter.is_enabled())
+    counter.add_counts(n_lanes * estimate_evaluation_flops(integration_flag),
+                       0.);
+
   EvaluationFlags::EvaluationFlags integration_flag_actual = integration_flag;
   if (integration_flag & EvaluationFlags::hessians &&
       (this->cell_type > internal::MatrixFreeFunctions::affine))
@@ -8169,7 +8329,17 @@ FEEvaluation<dim,
     internal::check_vector_access_inplace<Number, VectorizedArrayType>(
       *this, destination);
   if (dst_ptr != nullptr)
-    integrate(integration_flag, dst_ptr, true);
+    {
+      // the vector entries are read and written directly by integrate()
+      if (MatrixFreeTools::PerformanceCounters::is_enabled())
+        internal::MatrixFreeFunctions::add_to_performance_counters(
+          MatrixFreeTools::PerformanceCounters::Phase::
+            distribute_local_to_global,
+          0.,
+          2 * dofs_per_cell * n_lanes * sizeof(Number),
+          0.);
+      integrate(integration_flag, dst_ptr, true);
+    }
   else
     {
       integrate(integration_flag, this->begin_dof_values());
@@ -8179,6 +8349,35 @@ FEEvaluation<dim,
 
 
 
+template <int dim,
+          int fe_degree,
+          int n_q_points_1d,
+          int n_components_,
+          typename Number,
+          typename VectorizedArrayType>
+inline double
+FEEvaluation<dim,
+             fe_degree,
+             n_q_points_1d,
+             n_components_,
+             Number,
+             VectorizedArrayType>::
+  estimate_evaluation_flops(
+    const EvaluationFlags::EvaluationFlags evaluation_flag) const
+{
+  return internal::MatrixFreeFunctions::estimate_cell_evaluation_flops(
+    dim,
+    n_components,
+    this->data->element_type,
+    this->data->data.front().fe_degree + 1,
+    this->data->data.front().n_q_points_1d,
+    this->data->dofs_per_component_on_cell,
+    this->data->n_q_points,
+    evaluation_flag);
+}
+
+
+
 template <int dim,
           int fe_degree,
           int n_q_points_1d,
@@ -363,6 +363,10 @@ public:
    * Jacobian of the geometry, e.g., to store an effective coefficient tensors
    * that combines a coefficient with the geometry for lower memory transfer
    * as the available data fields.
+   *
+   * @note For cells whose geometry is computed on the fly, see
+   * MatrixFree::AdditionalData::compute_geometry_on_the_fly, no data is
+   * stored and this function returns numbers::invalid_unsigned_int.
    */
   unsigned int
   get_mapping_data_index_offset() const;
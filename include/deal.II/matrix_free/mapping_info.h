@@ -34,6 +34,7 @@
 
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/mapping_info_storage.h>
+#include <deal.II/matrix_free/shape_info.h>
 
 #include <memory>
 
@@ -61,6 +62,11 @@ namespace internal
        * for different kinds of iterators, e.g. standard DoFHandler,
        * multigrid, etc.)  on a fixed Triangulation. In addition, a mapping
        * and several 1d quadrature formulas are given.
+       *
+       * If @p compute_geometry_on_the_fly is set, the inverse Jacobians,
+       * JxW values and quadrature points on cells of type
+       * GeometryType::general are not stored, but only the support points
+       * of the mapping, see compute_cell_geometry_on_the_fly().
        */
       void
       initialize(
@@ -74,7 +80,8 @@ namespace internal
         const UpdateFlags update_flags_boundary_faces,
         const UpdateFlags update_flags_inner_faces,
         const UpdateFlags update_flags_faces_by_cells,
-        const bool        piola_transform);
+        const bool        piola_transform,
+        const bool        compute_geometry_on_the_fly = false);
 
       /**
        * Update the information in the given cells and faces that is the
@@ -96,6 +103,35 @@ namespace internal
       GeometryType
       get_cell_type(const unsigned int cell_chunk_no) const;
 
+      /**
+       * Return whether the geometry of the given cell batch is computed on
+       * the fly by compute_cell_geometry_on_the_fly() instead of being
+       * stored in @p cell_data.
+       */
+      bool
+      cell_geometry_is_computed_on_the_fly(
+        const unsigned int cell_chunk_no) const;
+
+      /**
+       * Compute the inverse Jacobians, the JxW values and, if requested by
+       * the update flags, the quadrature points of the given cell batch for
+       * the quadrature formula with index @p quad_no from the support points
+       * of the mapping, using sum factorization with the polynomial
+       * representation of the geometry. The result is written into the
+       * fields @p jacobians[0], @p JxW_values and @p quadrature_points of
+       * @p data, with one entry per quadrature point. The array @p scratch
+       * is used for intermediate results.
+       *
+       * This function may only be called for cell batches where
+       * cell_geometry_is_computed_on_the_fly() returns true.
+       */
+      void
+      compute_cell_geometry_on_the_fly(
+        const unsigned int                                 cell_chunk_no,
+        const unsigned int                                 quad_no,
+        MappingInfoStorage<dim, dim, VectorizedArrayType> &data,
+        AlignedVector<VectorizedArrayType>                &scratch) const;
+
       /**
        * Clear all data fields in this class.
        */
@@ -140,6 +176,12 @@ namespace internal
        */
       UpdateFlags update_flags_faces_by_cells;
 
+      /**
+       * Whether the geometry of cells of type GeometryType::general should be
+       * computed on the fly rather than stored, as given to initialize().
+       */
+      bool compute_geometry_on_the_fly;
+
       /**
        * Stores whether a cell is Cartesian (cell type 0), has constant
        * transform data (Jacobians) (cell type 1), or is general (cell type
@@ -185,6 +227,39 @@ namespace internal
       std::vector<MappingInfoStorage<dim - 1, dim, VectorizedArrayType>>
         face_data_by_cells;
 
+      /**
+       * The support points of the mapping on the cell batches whose geometry
+       * is computed on the fly, i.e., the points of MappingQ evaluated in the
+       * Gauss-Lobatto points of the mapping degree. The points of a cell
+       * batch are stored in lexicographic order, with the spatial component
+       * running slowest.
+       *
+       * Compared to the data stored in @p cell_data, which contains
+       * <tt>dim*dim+1</tt> numbers per quadrature point for the inverse
+       * Jacobian and the JxW value for each quadrature formula, this needs
+       * only @p dim numbers per support point of the mapping, independently
+       * of the number of quadrature formulas. The price to pay is the
+       * evaluation of the Jacobians and their inverses in
+       * FEEvaluation::reinit(), which is usually cheaper than loading the
+       * data from main memory on modern hardware.
+       */
+      AlignedVector<VectorizedArrayType> cell_mapping_support_points;
+
+      /**
+       * The offset of each cell batch into @p cell_mapping_support_points,
+       * or numbers::invalid_unsigned_int if the geometry of the cell batch is
+       * stored in @p cell_data. Empty if no cell has its geometry computed
+       * on the fly.
+       */
+      std::vector<unsigned int> cell_mapping_support_point_offsets;
+
+      /**
+       * The interpolation matrices from the support points of the mapping to
+       * the quadrature points of the quadrature formulas used for the cells,
+       * for computing the geometry on the fly.
+       */
+      std::vector<ShapeInfo<VectorizedArrayType>> cell_mapping_shape_info;
+
       /**
        * The pointer to the underlying hp::MappingCollection object.
        */
@@ -309,6 +384,20 @@ namespace internal
       return cell_type[cell_no];
     }
 
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    inline bool
+    MappingInfo<dim, Number, VectorizedArrayType>::
+      cell_geometry_is_computed_on_the_fly(const unsigned int cell_no) const
+    {
+      if (cell_mapping_support_point_offsets.empty())
+        return false;
+      AssertIndexRange(cell_no, cell_mapping_support_point_offsets.size());
+      return cell_mapping_support_point_offsets[cell_no] !=
+             numbers::invalid_unsigned_int;
+    }
+
   } // end of namespace MatrixFreeFunctions
 } // end of namespace internal
 
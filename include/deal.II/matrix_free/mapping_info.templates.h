@@ -33,6 +33,7 @@
 #include <deal.II/matrix_free/fe_evaluation_data.h>
 #include <deal.II/matrix_free/mapping_info.h>
 #include <deal.II/matrix_free/mapping_info_storage.templates.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
 #include <deal.II/matrix_free/util.h>
 
 #include <limits>
@@ -53,6 +54,9 @@ namespace internal
       face_data_by_cells.clear();
       cell_type.clear();
       face_type.clear();
+      cell_mapping_support_points.clear();
+      cell_mapping_support_point_offsets.clear();
+      cell_mapping_shape_info.clear();
       mapping_collection = nullptr;
       mapping            = nullptr;
     }
@@ -72,11 +76,13 @@ namespace internal
       const UpdateFlags update_flags_boundary_faces,
       const UpdateFlags update_flags_inner_faces,
       const UpdateFlags update_flags_faces_by_cells,
-      const bool        piola_transform)
+      const bool        piola_transform,
+      const bool        compute_geometry_on_the_fly)
     {
       clear();
-      this->mapping_collection = mapping;
-      this->mapping            = &mapping->operator[](0);
+      this->mapping_collection          = mapping;
+      this->mapping                     = &mapping->operator[](0);
+      this->compute_geometry_on_the_fly = compute_geometry_on_the_fly;
 
       cell_data.resize(quad.size());
       face_data.resize(quad.size());
@@ -220,6 +226,9 @@ namespace internal
         data.clear_data_fields();
       for (auto &data : face_data_by_cells)
         data.clear_data_fields();
+      cell_mapping_support_points.clear();
+      cell_mapping_support_point_offsets.clear();
+      cell_mapping_shape_info.clear();
 
       this->mapping_collection = mapping;
       this->mapping            = &mapping->operator[](0);
@@ -1159,6 +1168,7 @@ namespace internal
         const UpdateFlags                  update_flags_cells,
         const AlignedVector<double>       &plain_quadrature_points,
         const ShapeInfo<VectorizedDouble> &shape_info,
+        const std::vector<unsigned int>   &cell_mapping_support_point_offsets,
         MappingInfoStorage<dim, dim, VectorizedArrayType> &my_data)
       {
         constexpr unsigned int n_lanes   = VectorizedArrayType::size();
@@ -1177,6 +1187,13 @@ namespace internal
         for (unsigned int cell = begin_cell; cell < end_cell; ++cell)
           for (unsigned vv = 0; vv < n_lanes; vv += n_lanes_d)
             {
+              // nothing to do for cells where the geometry is computed on
+              // the fly from the support points of the mapping
+              if (!cell_mapping_support_point_offsets.empty() &&
+                  cell_mapping_support_point_offsets[cell] !=
+                    numbers::invalid_unsigned_int)
+                continue;
+
               if (cell_type[cell] > affine || process_cell[cell])
                 {
                   unsigned int start_indices[n_lanes_d];
@@ -2733,6 +2750,56 @@ namespace internal
                               preliminary_cell_type.data() + cell + n_lanes);
         }
 
+      // step 3b: in case the geometry on general cells should be computed on
+      // the fly, keep the support points of the mapping for those cell
+      // batches. This needs a tensor-product quadrature formula and is not
+      // done if the derivatives of the Jacobians are requested.
+      bool geometry_on_the_fly =
+        compute_geometry_on_the_fly &&
+        (update_flags_cells & update_jacobian_grads) == 0;
+      for (const auto &data : cell_data)
+        if (Utilities::pow(data.descriptor[0].quadrature_1d.size(), dim) !=
+            data.descriptor[0].n_q_points)
+          geometry_on_the_fly = false;
+
+      unsigned int n_cells_on_the_fly = 0;
+      if (geometry_on_the_fly)
+        {
+          cell_mapping_support_point_offsets.resize(
+            cell_type.size(), numbers::invalid_unsigned_int);
+          for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+            if (cell_type[cell] == general)
+              cell_mapping_support_point_offsets[cell] =
+                (n_cells_on_the_fly++) * dim * n_mapping_points;
+        }
+
+      if (n_cells_on_the_fly > 0)
+        {
+          cell_mapping_support_points.resize_fast(n_cells_on_the_fly * dim *
+                                                  n_mapping_points);
+          for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+            if (cell_geometry_is_computed_on_the_fly(cell))
+              {
+                VectorizedArrayType *points =
+                  cell_mapping_support_points.data() +
+                  cell_mapping_support_point_offsets[cell];
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  for (unsigned int i = 0; i < dim * n_mapping_points; ++i)
+                    points[i][v] =
+                      plain_quadrature_points[(cell * n_lanes + v) * dim *
+                                                n_mapping_points +
+                                              i];
+              }
+
+          FE_DGQ<dim> fe_geometry(mapping_degree);
+          cell_mapping_shape_info.resize(cell_data.size());
+          for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
+            cell_mapping_shape_info[my_q].reinit(
+              cell_data[my_q].descriptor[0].quadrature, fe_geometry);
+        }
+      else
+        cell_mapping_support_point_offsets.clear();
+
       // step 4: compute the data on cells from the cached quadrature
       // points, filling up all SIMD lanes as appropriate
       for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
@@ -2747,6 +2814,12 @@ namespace internal
           my_data.data_index_offsets.resize(cell_type.size());
           for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
             {
+              if (cell_geometry_is_computed_on_the_fly(cell))
+                {
+                  my_data.data_index_offsets[cell] =
+                    numbers::invalid_unsigned_int;
+                  continue;
+                }
               if (process_cell[cell] == false)
                 my_data.data_index_offsets[cell] =
                   my_data.data_index_offsets[cell_data_index_vect[cell]];
@@ -2768,17 +2841,19 @@ namespace internal
 
           if (update_flags_cells & update_quadrature_points)
             {
+              const auto n_stored_points = [&](const unsigned int cell) {
+                return cell_geometry_is_computed_on_the_fly(cell) ?
+                         0U :
+                         (cell_type[cell] <= affine ? 1U : n_q_points);
+              };
               my_data.quadrature_point_offsets.resize(cell_type.size());
               for (unsigned int cell = 1; cell < cell_type.size(); ++cell)
-                if (cell_type[cell - 1] <= affine)
-                  my_data.quadrature_point_offsets[cell] =
-                    my_data.quadrature_point_offsets[cell - 1] + 1;
-                else
-                  my_data.quadrature_point_offsets[cell] =
-                    my_data.quadrature_point_offsets[cell - 1] + n_q_points;
+                my_data.quadrature_point_offsets[cell] =
+                  my_data.quadrature_point_offsets[cell - 1] +
+                  n_stored_points(cell - 1);
               my_data.quadrature_points.resize_fast(
                 my_data.quadrature_point_offsets.back() +
-                (cell_type.back() <= affine ? 1 : n_q_points));
+                n_stored_points(cell_type.size() - 1));
             }
 
           // step 4b: go through the cells and compute the information using
@@ -2798,6 +2873,7 @@ namespace internal
                 update_flags_cells,
                 plain_quadrature_points,
                 shape_infos[my_q],
+                cell_mapping_support_point_offsets,
                 my_data);
             },
             std::max(cell_type.size() / MultithreadInfo::n_threads() / 2,
@@ -3312,6 +3388,120 @@ namespace internal
 
 
 
+    template <int dim, typename Number, typename VectorizedArrayType>
+    void
+    MappingInfo<dim, Number, VectorizedArrayType>::
+      compute_cell_geometry_on_the_fly(
+        const unsigned int                                 cell,
+        const unsigned int                                 quad_no,
+        MappingInfoStorage<dim, dim, VectorizedArrayType> &data,
+        AlignedVector<VectorizedArrayType>                &scratch) const
+    {
+      Assert(cell_geometry_is_computed_on_the_fly(cell), ExcInternalError());
+      AssertIndexRange(quad_no, cell_mapping_shape_info.size());
+
+      const UnivariateShapeData<VectorizedArrayType> &univariate_data =
+        cell_mapping_shape_info[quad_no].data.front();
+      const unsigned int n_points_1d   = univariate_data.fe_degree + 1;
+      const unsigned int n_q_points_1d = univariate_data.n_q_points_1d;
+      const unsigned int n_points      = Utilities::pow(n_points_1d, dim);
+      const unsigned int n_q_points    = Utilities::pow(n_q_points_1d, dim);
+      const unsigned int n_max =
+        Utilities::pow(std::max(n_points_1d, n_q_points_1d), dim);
+
+      scratch.resize_fast(3 * n_max);
+      VectorizedArrayType *tmp0 = scratch.data();
+      VectorizedArrayType *tmp1 = tmp0 + n_max;
+      VectorizedArrayType *out  = tmp1 + n_max;
+
+      data.jacobians[0].resize_fast(n_q_points);
+      data.JxW_values.resize_fast(n_q_points);
+      const bool compute_points =
+        (update_flags_cells & update_quadrature_points) != 0u;
+      if (compute_points)
+        data.quadrature_points.resize_fast(n_q_points);
+
+      Tensor<2, dim, VectorizedArrayType> *jacobians = data.jacobians[0].data();
+      const auto store_derivative = [&](const unsigned int c,
+                                        const unsigned int e) {
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          jacobians[q][c][e] = out[q];
+      };
+      const auto store_point = [&](const unsigned int c) {
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          data.quadrature_points[q][c] = out[q];
+      };
+
+      // compute the derivatives of the geometry with respect to the unit
+      // coordinates by sum factorization, sharing the interpolation in the
+      // first directions between the derivatives
+      EvaluatorTensorProduct<evaluate_general, dim, 0, 0, VectorizedArrayType>
+        eval(univariate_data.shape_values.data(),
+             univariate_data.shape_gradients.data(),
+             nullptr,
+             n_points_1d,
+             n_q_points_1d);
+      for (unsigned int c = 0; c < dim; ++c)
+        {
+          const VectorizedArrayType *in =
+            cell_mapping_support_points.data() +
+            cell_mapping_support_point_offsets[cell] + c * n_points;
+          if constexpr (dim == 1)
+            {
+              eval.template gradients<0, true, false>(in, out);
+              store_derivative(c, 0);
+              if (compute_points)
+                {
+                  eval.template values<0, true, false>(in, out);
+                  store_point(c);
+                }
+            }
+          else if constexpr (dim == 2)
+            {
+              eval.template values<0, true, false>(in, tmp0);
+              eval.template gradients<1, true, false>(tmp0, out);
+              store_derivative(c, 1);
+              if (compute_points)
+                {
+                  eval.template values<1, true, false>(tmp0, out);
+                  store_point(c);
+                }
+              eval.template gradients<0, true, false>(in, tmp0);
+              eval.template values<1, true, false>(tmp0, out);
+              store_derivative(c, 0);
+            }
+          else
+            {
+              eval.template values<0, true, false>(in, tmp0);
+              eval.template values<1, true, false>(tmp0, tmp1);
+              eval.template gradients<2, true, false>(tmp1, out);
+              store_derivative(c, 2);
+              if (compute_points)
+                {
+                  eval.template values<2, true, false>(tmp1, out);
+                  store_point(c);
+                }
+              eval.template gradients<1, true, false>(tmp0, tmp1);
+              eval.template values<2, true, false>(tmp1, out);
+              store_derivative(c, 1);
+              eval.template gradients<0, true, false>(in, tmp0);
+              eval.template values<1, true, false>(tmp0, tmp1);
+              eval.template values<2, true, false>(tmp1, out);
+              store_derivative(c, 0);
+            }
+        }
+
+      const auto &weights = cell_data[quad_no].descriptor[0].quadrature_weights;
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          const Tensor<2, dim, VectorizedArrayType> jac = jacobians[q];
+          data.JxW_values[q] = determinant(jac) * weights[q];
+          jacobians[q]       = transpose(invert(jac));
+        }
+    }
+
+
+
     template <int dim, typename Number, typename VectorizedArrayType>
     std::size_t
     MappingInfo<dim, Number, VectorizedArrayType>::memory_consumption() const
@@ -3323,6 +3513,11 @@ namespace internal
       memory += face_type.capacity() * sizeof(GeometryType);
       memory += faces_by_cells_type.capacity() *
                 GeometryInfo<dim>::faces_per_cell * sizeof(GeometryType);
+      memory +=
+        MemoryConsumption::memory_consumption(cell_mapping_support_points);
+      memory += MemoryConsumption::memory_consumption(
+        cell_mapping_support_point_offsets);
+      memory += MemoryConsumption::memory_consumption(cell_mapping_shape_info);
       memory += sizeof(*this);
       return memory;
     }
@@ -3351,6 +3546,13 @@ namespace internal
                                           GeometryInfo<dim>::faces_per_cell *
                                           sizeof(GeometryType));
 
+      if (!cell_mapping_support_point_offsets.empty())
+        {
+          out << "    Mapping support points:          ";
+          task_info.print_memory_statistics(
+            out, cell_mapping_support_points.memory_consumption());
+        }
+
       for (unsigned int j = 0; j < cell_data.size(); ++j)
         {
           out << "    Data component " << j << std::endl;
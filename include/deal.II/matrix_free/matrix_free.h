@@ -250,6 +250,7 @@ public:
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
       , allow_ghosted_vectors_in_loops(allow_ghosted_vectors_in_loops)
+      , compute_geometry_on_the_fly(false)
       , communicator_sm(MPI_COMM_SELF)
     {}
 
@@ -276,6 +277,7 @@ public:
       , cell_vectorization_categories_strict(
           other.cell_vectorization_categories_strict)
       , allow_ghosted_vectors_in_loops(other.allow_ghosted_vectors_in_loops)
+      , compute_geometry_on_the_fly(other.compute_geometry_on_the_fly)
       , communicator_sm(other.communicator_sm)
     {}
 
@@ -304,6 +306,7 @@ public:
       cell_vectorization_categories_strict =
         other.cell_vectorization_categories_strict;
       allow_ghosted_vectors_in_loops = other.allow_ghosted_vectors_in_loops;
+      compute_geometry_on_the_fly    = other.compute_geometry_on_the_fly;
       communicator_sm                = other.communicator_sm;
 
       return *this;
@@ -548,6 +551,27 @@ public:
      */
     bool allow_ghosted_vectors_in_loops;
 
+    /**
+     * Option to control whether the geometry on cells with a general,
+     * non-affine shape is stored in terms of the support points of the
+     * mapping, rather than the inverse Jacobians and JxW values in all
+     * quadrature points. The latter are then computed on the fly with sum
+     * factorization in FEEvaluation::reinit(), which trades memory transfer
+     * for arithmetic operations. This reduces the memory consumption of the
+     * cell geometry data by a factor of three or more in 3d, especially when
+     * several quadrature formulas are used, and is often faster on hardware
+     * where the operator evaluation is limited by the memory bandwidth, such
+     * as for high-order curved meshes.
+     *
+     * This option only has an effect for mappings derived from MappingQ
+     * without hp-capabilities, with quadrature formulas that are tensor
+     * products of a 1d formula, and if the mapping update flags for cells do
+     * not contain update_jacobian_grads or update_hessians. The geometry on
+     * faces is always stored. FEEvaluation::reinit() with a list of cell
+     * indices is not supported in this mode. Default: false.
+     */
+    bool compute_geometry_on_the_fly;
+
     /**
      * Shared-memory MPI communicator. Default: MPI_COMM_SELF.
      */
@@ -1013,6 +1037,48 @@ public:
                               &operation_after_loop,
             const unsigned int dof_handler_index_pre_post = 0) const;
 
+  /**
+   * Same as the first cell_loop() variant, but runs several cell operations
+   * in a single loop over the cells, e.g., the operators acting on the
+   * different blocks of a coupled system or the operators of several
+   * species in a reaction-diffusion system. The operation
+   * <code>cell_operations[i]</code> reads from <code>*src[i]</code> and
+   * writes into <code>*dst[i]</code>. For each range of cells, all
+   * operations are called one after the other, so that the geometry data of
+   * MappingInfo and the DoF indices of DoFInfo for the cells in the range
+   * are loaded from main memory only once and are still in caches for the
+   * later operations. Furthermore, the MPI data exchange of all vectors is
+   * done together and overlapped with the computations. Compared to calling
+   * cell_loop() once per operation, this reduces the memory traffic and
+   * the number of synchronization points.
+   *
+   * The vectors may be associated with different DoFHandler objects of the
+   * current MatrixFree object. A vector may appear in @p src or @p dst for
+   * more than one operation, in which case its data exchange is only done
+   * once. If @p zero_dst_vector is set, all destination vectors are set to
+   * zero on the subranges touched by the loop, as in the other variants.
+   *
+   * @code
+   * matrix_free.template cell_loop<VectorType, VectorType>(
+   *   {velocity_operation, pressure_operation},
+   *   {&dst_velocity, &dst_pressure},
+   *   {&src_velocity, &src_pressure},
+   *   true);
+   * @endcode
+   */
+  template <typename OutVector, typename InVector>
+  void
+  cell_loop(
+    const std::vector<
+      std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                         OutVector &,
+                         const InVector &,
+                         const std::pair<unsigned int, unsigned int> &)>>
+                                        &cell_operations,
+    const std::vector<OutVector *>      &dst,
+    const std::vector<const InVector *> &src,
+    const bool                           zero_dst_vector = false) const;
+
   /**
    * This method runs a loop over all cells (in parallel) and performs the MPI
    * data exchange on the source vector and destination vector. As opposed to
@@ -3590,6 +3656,44 @@ namespace internal
 
 
 
+    /**
+     * Wait for the ghost data from the next process in the update of ghost
+     * values started by update_ghost_values_start() for vectors that support
+     * exchange on a subset of DoFs, i.e. LinearAlgebra::distributed::Vector,
+     * and return the index of that process within the ghost targets of the
+     * vector partitioner of component @p mf_component of the MatrixFree
+     * object. Returns numbers::invalid_unsigned_int once all data has arrived
+     * or if the exchange cannot wait for individual processes. In both cases,
+     * update_ghost_values_finish() must be called to complete the update.
+     */
+    template <typename VectorType,
+              std::enable_if_t<has_exchange_on_subset<VectorType>, VectorType>
+                * = nullptr>
+    unsigned int
+    update_ghost_values_finish_any(const unsigned int component_in_block_vector,
+                                   const unsigned int mf_component,
+                                   const VectorType  &vec)
+    {
+      (void)component_in_block_vector;
+      (void)mf_component;
+      (void)vec;
+#  ifdef DEAL_II_WITH_MPI
+      AssertIndexRange(component_in_block_vector, tmp_data.size());
+
+      // the data of a process is only in its final place if the exchange
+      // covers all ghost indices of the vector
+      const auto &part = get_partitioner(mf_component);
+      if (vec.size() != 0 && tmp_data[component_in_block_vector] != nullptr &&
+          part.n_ghost_indices() == matrix_free.get_dof_info(mf_component)
+                                      .vector_partitioner->n_ghost_indices())
+        return part.export_to_ghosted_array_finish_any(
+          this->requests[component_in_block_vector]);
+#  endif
+      return numbers::invalid_unsigned_int;
+    }
+
+
+
     /**
      * Start compress for serial vectors
      */
@@ -4594,6 +4698,37 @@ namespace internal
   }
 
 
+
+  // Same as above, but only for the constrained DoFs within the range
+  // [begin, end) of locally owned indices. The list of constrained DoFs is
+  // sorted.
+  template <typename VectorStruct1, typename VectorStruct2>
+  inline void
+  apply_operation_to_constrained_dofs(const std::vector<unsigned int> &,
+                                      const unsigned int,
+                                      const unsigned int,
+                                      const VectorStruct1 &,
+                                      VectorStruct2 &)
+  {}
+
+  template <typename Number>
+  inline void
+  apply_operation_to_constrained_dofs(
+    const std::vector<unsigned int>                  &constrained_dofs,
+    const unsigned int                                begin,
+    const unsigned int                                end,
+    const LinearAlgebra::distributed::Vector<Number> &src,
+    LinearAlgebra::distributed::Vector<Number>       &dst)
+  {
+    for (auto it = std::lower_bound(constrained_dofs.begin(),
+                                    constrained_dofs.end(),
+                                    begin);
+         it != constrained_dofs.end() && *it < end;
+         ++it)
+      dst.local_element(*it) = src.local_element(*it);
+  }
+
+
   namespace MatrixFreeFunctions
   {
     // struct to select between a const interface and a non-const interface
@@ -4758,6 +4893,98 @@ namespace internal
     }
 
   public:
+    // Finishes the communication for the update ghost values operation and
+    // runs the cell work on the ranges [begin_range, end_range). For a single
+    // LinearAlgebra::distributed::Vector as source, a cell batch is processed
+    // as soon as the ghost data from all processes it reads from has
+    // arrived, which overlaps the communication with the work on the cells.
+    virtual void
+    vector_update_ghosts_finish_and_cell(const unsigned int begin_range,
+                                         const unsigned int end_range) override
+    {
+      if constexpr (has_exchange_on_subset<InVector> &&
+                    !IsBlockVector<InVector>::value)
+        if (cell_function != nullptr && !src_and_dst_are_same &&
+            src.size() != 0)
+          {
+            const std::vector<unsigned int> &cell_partition_data =
+              matrix_free.get_task_info().cell_partition_data;
+            const unsigned int mf_component =
+              src_data_exchanger.find_vector_in_mf(src);
+            const internal::MatrixFreeFunctions::DoFInfo &dof_info =
+              matrix_free.get_dof_info(mf_component);
+            const unsigned int begin_batch = cell_partition_data[begin_range];
+            const unsigned int end_batch   = cell_partition_data[end_range];
+            if (dof_info.cell_ghost_target_list_index.size() > end_batch)
+              {
+                // number of processes whose ghost data a cell batch still
+                // waits for, set to invalid once the batch has been processed
+                std::vector<unsigned int> n_missing(end_batch - begin_batch);
+                for (unsigned int batch = begin_batch; batch < end_batch;
+                     ++batch)
+                  n_missing[batch - begin_batch] =
+                    dof_info.cell_ghost_target_list_index[batch + 1] -
+                    dof_info.cell_ghost_target_list_index[batch];
+
+                // run the cell work on the contiguous runs of cell batches
+                // whose data is available; the runs may not cross the ranges
+                // of the loop in order to keep the sorting by active FE index
+                const auto process_available_batches = [&]() {
+                  for (unsigned int range = begin_range; range < end_range;
+                       ++range)
+                    {
+                      unsigned int first = cell_partition_data[range];
+                      for (unsigned int batch = first;
+                           batch <= cell_partition_data[range + 1];
+                           ++batch)
+                        if (batch == cell_partition_data[range + 1] ||
+                            n_missing[batch - begin_batch] != 0)
+                          {
+                            if (batch > first)
+                              cell(std::make_pair(first, batch));
+                            for (unsigned int b = first; b < batch; ++b)
+                              n_missing[b - begin_batch] =
+                                numbers::invalid_unsigned_int;
+                            first = batch + 1;
+                          }
+                    }
+                };
+
+                process_available_batches();
+                for (unsigned int target =
+                       src_data_exchanger.update_ghost_values_finish_any(
+                         0, mf_component, src);
+                     target != numbers::invalid_unsigned_int;
+                     target = src_data_exchanger.update_ghost_values_finish_any(
+                       0, mf_component, src))
+                  {
+                    for (unsigned int batch = begin_batch; batch < end_batch;
+                         ++batch)
+                      if (n_missing[batch - begin_batch] !=
+                          numbers::invalid_unsigned_int)
+                        for (unsigned int i =
+                               dof_info.cell_ghost_target_list_index[batch];
+                             i <
+                             dof_info.cell_ghost_target_list_index[batch + 1];
+                             ++i)
+                          if (dof_info.cell_ghost_target_list[i] == target)
+                            --n_missing[batch - begin_batch];
+                    process_available_batches();
+                  }
+
+                internal::update_ghost_values_finish(src, src_data_exchanger);
+                for (unsigned int &n : n_missing)
+                  if (n != numbers::invalid_unsigned_int)
+                    n = 0;
+                process_available_batches();
+                return;
+              }
+          }
+
+      MFWorkerInterface::vector_update_ghosts_finish_and_cell(begin_range,
+                                                              end_range);
+    }
+
     // Starts the communication for the update ghost values operation. We
     // cannot call this update if ghost and destination are the same because
     // that would introduce spurious entries in the destination (there is also
@@ -4838,22 +5065,14 @@ namespace internal
     {
       if (operation_after_loop)
         {
-          // Run unit matrix operation on constrained dofs if we are at the
-          // last range
-          const std::vector<unsigned int> &partition_row_index =
-            matrix_free.get_task_info().partition_row_index;
-          if (range_index ==
-              partition_row_index[partition_row_index.size() - 2] - 1)
-            apply_operation_to_constrained_dofs(
-              matrix_free.get_constrained_dofs(dof_handler_index_pre_post),
-              src,
-              dst);
-
+          const std::vector<unsigned int> &constrained_dofs =
+            matrix_free.get_constrained_dofs(dof_handler_index_pre_post);
           const internal::MatrixFreeFunctions::DoFInfo &dof_info =
             matrix_free.get_dof_info(dof_handler_index_pre_post);
           if (range_index == numbers::invalid_unsigned_int)
             {
               // Case with threaded loop -> currently no overlap implemented
+              apply_operation_to_constrained_dofs(constrained_dofs, src, dst);
               dealii::parallel::apply_to_subranges(
                 0U,
                 dof_info.vector_partitioner->locally_owned_size(),
@@ -4868,8 +5087,19 @@ namespace internal
                      dof_info.cell_loop_post_list_index[range_index];
                    id != dof_info.cell_loop_post_list_index[range_index + 1];
                    ++id)
-                operation_after_loop(dof_info.cell_loop_post_list[id].first,
-                                     dof_info.cell_loop_post_list[id].second);
+                {
+                  // Run unit matrix operation on the constrained dofs of the
+                  // range before handing it to the operation, which might
+                  // read these entries
+                  apply_operation_to_constrained_dofs(
+                    constrained_dofs,
+                    dof_info.cell_loop_post_list[id].first,
+                    dof_info.cell_loop_post_list[id].second,
+                    src,
+                    dst);
+                  operation_after_loop(dof_info.cell_loop_post_list[id].first,
+                                       dof_info.cell_loop_post_list[id].second);
+                }
             }
         }
     }
@@ -5288,6 +5518,58 @@ MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
 }
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
+  const std::vector<
+    std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                       OutVector &,
+                       const InVector &,
+                       const std::pair<unsigned int, unsigned int> &)>>
+                                      &cell_operations,
+  const std::vector<OutVector *>      &dst,
+  const std::vector<const InVector *> &src,
+  const bool                           zero_dst_vector) const
+{
+  AssertDimension(cell_operations.size(), dst.size());
+  AssertDimension(cell_operations.size(), src.size());
+
+  // the data exchange is done on the list of distinct vectors, since the
+  // same vector must not be involved in two concurrent ghost updates or
+  // compress operations
+  const auto unique_pointers = [](const auto &vectors) {
+    std::remove_const_t<std::remove_reference_t<decltype(vectors)>> result;
+    for (const auto vector : vectors)
+      {
+        Assert(vector != nullptr, ExcInternalError());
+        if (std::find(result.begin(), result.end(), vector) == result.end())
+          result.push_back(vector);
+      }
+    return result;
+  };
+  std::vector<OutVector *>            dst_unique = unique_pointers(dst);
+  const std::vector<const InVector *> src_unique = unique_pointers(src);
+
+  // run all operations on each range of cells with the vectors given by the
+  // user, rather than the lists of distinct vectors passed to the loop
+  const std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                           std::vector<OutVector *> &,
+                           const std::vector<const InVector *> &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    fused_operation =
+      [&](const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+          std::vector<OutVector *> &,
+          const std::vector<const InVector *> &,
+          const std::pair<unsigned int, unsigned int> &cell_range) {
+        for (unsigned int i = 0; i < cell_operations.size(); ++i)
+          cell_operations[i](matrix_free, *dst[i], *src[i], cell_range);
+      };
+
+  cell_loop(fused_operation, dst_unique, src_unique, zero_dst_vector);
+}
+
+
 
 template <int dim, typename Number, typename VectorizedArrayType>
 template <typename CLASS, typename OutVector, typename InVector>
@@ -843,7 +843,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
         additional_data.mapping_update_flags_faces_by_cells,
-        piola_transform);
+        piola_transform,
+        additional_data.compute_geometry_on_the_fly);
 
       mapping_is_initialized = true;
     }
@@ -1176,7 +1177,10 @@ namespace internal
           const dealii::hp::FECollection<dim> &fes =
             dof_handlers[no]->get_fe_collection();
 
+          // a single element is always compatible with itself, which also
+          // covers elements that do not implement compare_for_domination()
           use_fast_hanging_node_algorithm &=
+            fes.size() == 1 ||
             std::all_of(fes.begin(), fes.end(), [&fes](const auto &fe) {
               return fes[0].compare_for_domination(fe) ==
                      FiniteElementDomination::Domination::
@@ -2076,7 +2080,10 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
     }
 
   for (auto &di : dof_info)
-    di.compute_vector_zero_access_pattern(task_info, face_info.faces);
+    {
+      di.compute_vector_zero_access_pattern(task_info, face_info.faces);
+      di.compute_ghost_target_access_pattern(task_info, dof_info, face_info);
+    }
 
 #ifdef DEAL_II_WITH_MPI
   {
@@ -33,6 +33,7 @@
 
 #include <deal.II/multigrid/mg_constrained_dofs.h>
 
+#include <algorithm>
 #include <limits>
 
 DEAL_II_NAMESPACE_OPEN
@@ -112,6 +113,9 @@ namespace MatrixFreeOperators
    * compute_diagonal() to initialize the protected member
    * inverse_diagonal_entries and/or diagonal_entries. In case of a
    * non-symmetric operator, Tapply_add() should be additionally implemented.
+   * Derived classes that run a single MatrixFree::cell_loop() in apply_add()
+   * should also implement apply_add_with_operations(), which allows
+   * PreconditionChebyshev to merge its vector updates into the cell loop.
    *
    * Currently, the only supported vectors are
    * LinearAlgebra::distributed::Vector and
@@ -312,6 +316,41 @@ namespace MatrixFreeOperators
     void
     vmult(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Matrix-vector multiplication that runs
+     * @p operation_before_matrix_vector_product on ranges of the locally
+     * owned entries of the vectors before the cell loop first accesses them,
+     * and @p operation_after_matrix_vector_product on ranges of entries after
+     * the cell loop has finished working on them, see MatrixFree::cell_loop()
+     * for the details. The result of the operator is added into @p dst, so
+     * the operation before the product typically sets the entries of @p dst
+     * to zero. The entries of @p dst that belong to constrained DoFs or to
+     * the refinement edge of a multigrid level are set to the respective
+     * entries of @p src, like in the vmult() function above.
+     *
+     * This is the interface that PreconditionChebyshev uses to merge its
+     * vector updates into the matrix-vector product, such that each step of
+     * the Chebyshev iteration with a DiagonalMatrix as preconditioner needs a
+     * single pass through the vectors only. The data locality is only
+     * obtained if the derived class implements apply_add_with_operations().
+     *
+     * The two operations usually access the vectors through raw pointers, so
+     * the vectors are not re-initialized in this function as in vmult(). If
+     * their layout of ghost entries differs from the one required by the
+     * underlying MatrixFree object, the product is computed on temporary
+     * copies of the vectors instead.
+     *
+     * This function is only available for non-block vectors.
+     */
+    template <typename VectorTypeNonBlock = VectorType>
+    std::enable_if_t<!IsBlockVector<VectorTypeNonBlock>::value>
+    vmult(VectorType       &dst,
+          const VectorType &src,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_before_matrix_vector_product,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_after_matrix_vector_product) const;
+
     /**
      * Transpose matrix-vector multiplication.
      */
@@ -429,6 +468,31 @@ namespace MatrixFreeOperators
     virtual void
     Tapply_add(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Apply operator to @p src and add result in @p dst, running
+     * @p operation_before_loop and @p operation_after_loop on ranges of the
+     * locally owned entries of the vectors. The operations must be scheduled
+     * like in MatrixFree::cell_loop() called with these operations and
+     * <tt>dof_handler_index_pre_post = selected_rows[0]</tt>, including the
+     * unit matrix operation on the constrained DoFs that precedes
+     * @p operation_after_loop. A derived class whose apply_add() runs a
+     * single MatrixFree::cell_loop() can thus implement this function by
+     * passing the two operations on to that cell loop.
+     *
+     * The default implementation runs @p operation_before_loop on all
+     * entries, calls apply_add(), sets the constrained entries of @p dst to
+     * the ones of @p src, and then runs @p operation_after_loop on all
+     * entries.
+     */
+    virtual void
+    apply_add_with_operations(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const;
+
     /**
      * MatrixFree object to be used with this operator.
      */
@@ -825,6 +889,19 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as apply_add(), but runs the given operations on ranges of the
+     * vector entries within the cell loop.
+     */
+    virtual void
+    apply_add_with_operations(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * For this operator, there is just a cell contribution.
      */
@@ -975,6 +1052,19 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as apply_add(), but runs the given operations on ranges of the
+     * vector entries within the cell loop.
+     */
+    virtual void
+    apply_add_with_operations(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * Applies the Laplace operator on a cell.
      */
@@ -1471,6 +1561,88 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  template <typename VectorTypeNonBlock>
+  std::enable_if_t<!IsBlockVector<VectorTypeNonBlock>::value>
+  Base<dim, VectorType, VectorizedArrayType>::vmult(
+    VectorType       &dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_matrix_vector_product,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_matrix_vector_product) const
+  {
+    using Number =
+      typename Base<dim, VectorType, VectorizedArrayType>::value_type;
+    AssertDimension(dst.size(), src.size());
+    AssertDimension(selected_rows.size(), 1);
+
+    if (!dst.get_partitioner()->is_compatible(
+          *data->get_dof_info(selected_rows[0]).vector_partitioner) ||
+        !src.get_partitioner()->is_compatible(
+          *data->get_dof_info(selected_columns[0]).vector_partitioner))
+      {
+        // the operations may hold pointers into the vectors, so we cannot
+        // re-initialize them as in vmult() and compute the product on copies
+        // with the right layout instead, without merging the operations into
+        // the loop
+        VectorType src_copy, dst_copy;
+        data->initialize_dof_vector(src_copy, selected_columns[0]);
+        data->initialize_dof_vector(dst_copy, selected_rows[0]);
+
+        operation_before_matrix_vector_product(0, dst.locally_owned_size());
+        src_copy.copy_locally_owned_data_from(src);
+        vmult(dst_copy, src_copy);
+        for (unsigned int i = 0; i < dst.locally_owned_size(); ++i)
+          dst.local_element(i) += dst_copy.local_element(i);
+        operation_after_matrix_vector_product(0, dst.locally_owned_size());
+        return;
+      }
+
+    // set zero Dirichlet values on the refinement edge of the input vector
+    // once the operation before the loop has been run on a range, and reset
+    // them together with the unit matrix operation on these entries before
+    // the operation after the loop. the list of indices is sorted, so we can
+    // find the entries of a range by binary search.
+    const std::vector<unsigned int>        &edge_indices =
+      edge_constrained_indices[0];
+    std::vector<std::pair<Number, Number>> &edge_values =
+      edge_constrained_values[0];
+    VectorType &src_mutable = const_cast<VectorType &>(src);
+
+    apply_add_with_operations(
+      dst,
+      src,
+      [&](const unsigned int begin, const unsigned int end) {
+        operation_before_matrix_vector_product(begin, end);
+        for (auto it = std::lower_bound(edge_indices.begin(),
+                                        edge_indices.end(),
+                                        begin);
+             it != edge_indices.end() && *it < end;
+             ++it)
+          {
+            edge_values[it - edge_indices.begin()].first =
+              src_mutable.local_element(*it);
+            src_mutable.local_element(*it) = 0.;
+          }
+      },
+      [&](const unsigned int begin, const unsigned int end) {
+        for (auto it = std::lower_bound(edge_indices.begin(),
+                                        edge_indices.end(),
+                                        begin);
+             it != edge_indices.end() && *it < end;
+             ++it)
+          {
+            const Number value = edge_values[it - edge_indices.begin()].first;
+            src_mutable.local_element(*it) = value;
+            dst.local_element(*it)         = value;
+          }
+        operation_after_matrix_vector_product(begin, end);
+      });
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::vmult_add(
@@ -1786,6 +1958,29 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::apply_add_with_operations(
+    VectorType       &dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_loop,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_loop) const
+  {
+    const unsigned int locally_owned_size =
+      BlockHelper::subblock(dst, 0).locally_owned_size();
+    operation_before_loop(0, locally_owned_size);
+    apply_add(dst, src);
+    for (const unsigned int constrained_dof :
+         data->get_constrained_dofs(selected_rows[0]))
+      BlockHelper::subblock(dst, 0).local_element(constrained_dof) =
+        BlockHelper::subblock(src, 0).local_element(constrained_dof);
+    operation_after_loop(0, locally_owned_size);
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::precondition_Jacobi(
@@ -2113,6 +2308,39 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  MassOperator<dim,
+               fe_degree,
+               n_q_points_1d,
+               n_components,
+               VectorType,
+               VectorizedArrayType>::
+    apply_add_with_operations(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &MassOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
+
+
   template <int dim,
             int fe_degree,
             int n_q_points_1d,
@@ -2306,6 +2534,39 @@ namespace MatrixFreeOperators
       &LaplaceOperator::local_apply_cell, this, dst, src);
   }
 
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  LaplaceOperator<dim,
+                  fe_degree,
+                  n_q_points_1d,
+                  n_components,
+                  VectorType,
+                  VectorizedArrayType>::
+    apply_add_with_operations(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &LaplaceOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
   namespace Implementation
   {
     template <typename VectorizedArrayType>
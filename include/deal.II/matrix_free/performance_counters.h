@@ -0,0 +1,320 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_performance_counters_h
+#define dealii_matrix_free_performance_counters_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/matrix_free/evaluation_flags.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    /**
+     * The flag whether the performance counters are collected. It is defined
+     * in the header, such that the check in the kernels reduces to a single
+     * relaxed load without a function call.
+     */
+    inline std::atomic<bool> performance_counters_enabled{false};
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
+
+
+namespace MatrixFreeTools
+{
+  /**
+   * An optional instrumentation layer for the matrix-free kernels, which
+   * collects the number of calls, an estimate of the arithmetic operations
+   * and the memory transfer, and the run time of the phases of the work on
+   * cell batches. Once enabled by enable(), the counters are updated by
+   *
+   * - FEEvaluation::reinit(), which counts the bytes of the geometry data
+   *   read from MappingInfo (phase reinit),
+   * - FEEvaluationBase::read_dof_values() and
+   *   FEEvaluationBase::distribute_local_to_global(), which count the bytes
+   *   of vector entries read and written (phases read_dof_values and
+   *   distribute_local_to_global), also when called from
+   *   FEEvaluation::gather_evaluate() and FEEvaluation::integrate_scatter(),
+   * - FEEvaluation::evaluate() and FEEvaluation::integrate(), which count the
+   *   arithmetic operations of the sum-factorization kernels (phases evaluate
+   *   and integrate),
+   * - the loops of MatrixFree such as MatrixFree::cell_loop() and
+   *   MatrixFree::loop(), which count the number of loops and their total run
+   *   time (phase loop).
+   *
+   * The operation counts are estimates from the complexity of the
+   * algorithms, i.e., the number of multiplications and additions of the
+   * sum-factorization passes without the savings of the even-odd
+   * decomposition, and the size of the vector entries and geometry data
+   * accessed by the lanes of a cell batch, without the index data and without
+   * considering caches. Together with the peak performance of the machine,
+   * these numbers tell whether an operator is limited by the arithmetic
+   * throughput or by the memory bandwidth, see print_report().
+   *
+   * The counters are kept separately for each thread and summed up by
+   * get_data(). They only cover the current MPI process. When the counters
+   * are disabled, which is the default, the only overhead in the kernels is
+   * the check of a flag.
+   *
+   * A typical use is
+   * @code
+   * MatrixFreeTools::PerformanceCounters::enable();
+   * for (unsigned int i = 0; i < 100; ++i)
+   *   laplace_operator.vmult(dst, src);
+   * MatrixFreeTools::PerformanceCounters::print_report(std::cout, 2000, 200);
+   * MatrixFreeTools::PerformanceCounters::disable();
+   * @endcode
+   */
+  namespace PerformanceCounters
+  {
+    /**
+     * The phases for which the counters are collected.
+     */
+    enum class Phase : unsigned int
+    {
+      reinit,
+      read_dof_values,
+      evaluate,
+      integrate,
+      distribute_local_to_global,
+      loop
+    };
+
+    /**
+     * The number of entries in the Phase enum.
+     */
+    constexpr unsigned int n_phases = 6;
+
+    /**
+     * The counters for a single phase.
+     */
+    struct PhaseData
+    {
+      /**
+       * The number of calls, i.e., the number of cell batches for the
+       * phases of the kernels and the number of loops for Phase::loop.
+       */
+      std::uint64_t n_calls = 0;
+
+      /**
+       * The estimated number of floating point operations.
+       */
+      double flops = 0.;
+
+      /**
+       * The estimated number of bytes transferred from and to memory.
+       */
+      double bytes = 0.;
+
+      /**
+       * The accumulated run time in seconds.
+       */
+      double time = 0.;
+    };
+
+    /**
+     * Start collecting the counters.
+     */
+    void
+    enable();
+
+    /**
+     * Stop collecting the counters. The counters collected so far are kept.
+     */
+    void
+    disable();
+
+    /**
+     * Return whether the counters are collected.
+     */
+    inline bool
+    is_enabled()
+    {
+      return internal::MatrixFreeFunctions::performance_counters_enabled.load(
+        std::memory_order_relaxed);
+    }
+
+    /**
+     * Set all counters to zero.
+     *
+     * @note This function may not be called while other threads run
+     * matrix-free kernels.
+     */
+    void
+    reset();
+
+    /**
+     * Return the counters of all phases, summed over all threads and indexed
+     * by the values of the Phase enum.
+     *
+     * @note This function may not be called while other threads run
+     * matrix-free kernels.
+     */
+    std::array<PhaseData, n_phases>
+    get_data();
+
+    /**
+     * Return the name of the given phase.
+     */
+    std::string
+    get_phase_name(const Phase phase);
+
+    /**
+     * Print a table of the counters of all phases and of the sum of the
+     * phases of the kernels to @p out. For each phase, the table contains the
+     * number of calls, the operation counts, the run time, and the achieved
+     * arithmetic throughput and memory bandwidth, as well as the values per
+     * loop. The arithmetic intensity of each phase is compared to the
+     * machine balance given by @p peak_gflops (the peak arithmetic
+     * throughput in GFlop/s) and @p peak_gbytes_per_second (the peak memory
+     * bandwidth in GB/s) to classify the phase as compute-bound or
+     * memory-bound according to the roofline model, and the achieved
+     * performance is reported as the fraction of the roofline limit.
+     */
+    void
+    print_report(std::ostream &out,
+                 const double  peak_gflops,
+                 const double  peak_gbytes_per_second);
+  } // namespace PerformanceCounters
+} // namespace MatrixFreeTools
+
+
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    /**
+     * Add the given counts and time to the counters of @p phase of the
+     * current thread.
+     */
+    void
+    add_to_performance_counters(
+      const MatrixFreeTools::PerformanceCounters::Phase phase,
+      const double                                      flops,
+      const double                                      bytes,
+      const double                                      time);
+
+    /**
+     * Estimate the number of floating point operations of one lane in the
+     * evaluation of a finite element on a cell from the coefficients to the
+     * quantities requested by @p evaluation_flag, which is also the number
+     * of operations of the integration with the same flags. The shape
+     * functions of type @p element_type (a value of the ElementType enum)
+     * have @p n_dofs_1d and @p n_q_points_1d degrees of freedom and
+     * quadrature points per direction for tensor-product elements, and
+     * @p dofs_per_component and @p n_q_points degrees of freedom and
+     * quadrature points in total.
+     */
+    double
+    estimate_cell_evaluation_flops(
+      const unsigned int                     dim,
+      const unsigned int                     n_components,
+      const unsigned int                     element_type,
+      const unsigned int                     n_dofs_1d,
+      const unsigned int                     n_q_points_1d,
+      const unsigned int                     dofs_per_component,
+      const unsigned int                     n_q_points,
+      const EvaluationFlags::EvaluationFlags evaluation_flag);
+
+    /**
+     * A class that measures the time between its construction and its
+     * destruction and adds it, together with the operation counts given to
+     * add_counts(), to the performance counters of a phase. If the counters
+     * are not enabled at construction, the class does nothing.
+     */
+    class PerformanceCounterScope
+    {
+    public:
+      /**
+       * Constructor. Starts the time measurement if the counters are
+       * enabled.
+       */
+      PerformanceCounterScope(
+        const MatrixFreeTools::PerformanceCounters::Phase phase)
+        : phase(phase)
+        , enabled(performance_counters_enabled.load(std::memory_order_relaxed))
+        , flops(0.)
+        , bytes(0.)
+      {
+        if (enabled)
+          start_time = std::chrono::steady_clock::now();
+      }
+
+      /**
+       * Destructor. Adds the time and operation counts to the counters.
+       */
+      ~PerformanceCounterScope()
+      {
+        if (enabled)
+          add_to_performance_counters(
+            phase,
+            flops,
+            bytes,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                          start_time)
+              .count());
+      }
+
+      /**
+       * Return whether the counters are collected, in which case the
+       * operation counts should be computed and passed to add_counts().
+       */
+      bool
+      is_enabled() const
+      {
+        return enabled;
+      }
+
+      /**
+       * Add the given number of floating point operations and bytes.
+       */
+      void
+      add_counts(const double n_flops, const double n_bytes)
+      {
+        flops += n_flops;
+        bytes += n_bytes;
+      }
+
+    private:
+      const MatrixFreeTools::PerformanceCounters::Phase phase;
+      const bool                                        enabled;
+      double                                            flops;
+      double                                            bytes;
+      std::chrono::steady_clock::time_point             start_time;
+    };
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -531,6 +531,33 @@ namespace internal
        */
       unsigned int dofs_per_component_on_face;
 
+      /**
+       * For elements on simplex reference cells evaluated with a quadrature
+       * formula that is obtained by collapsing a tensor-product formula with
+       * the same 1d points in all directions onto the simplex (like
+       * QGaussCollapsedSimplex), this variable stores the number of
+       * quadrature points per direction. In that case, the gradients are
+       * evaluated by sum factorization in the collapsed coordinates with the
+       * collocation derivative matrix stored in
+       * UnivariateShapeData::shape_gradients_collocation of the first entry
+       * in @p data, followed by the transformation with
+       * @p collapsed_coordinate_gradients. This is possible if the number of
+       * points per direction exceeds the polynomial degree of the element.
+       * Otherwise, this variable is zero.
+       */
+      unsigned int n_q_points_1d_collapsed;
+
+      /**
+       * The derivatives of the collapsed coordinates $\xi_e$ with respect to
+       * the coordinates $x_d$ on the reference simplex, evaluated in the
+       * quadrature points, which are needed to transform gradients in
+       * collapsed coordinates to the reference simplex. The entry for the
+       * quadrature point $q$ is stored at position
+       * <code>(e * dim + d) * n_q_points + q</code>. Only filled if
+       * @p n_q_points_1d_collapsed is nonzero.
+       */
+      AlignedVector<Number> collapsed_coordinate_gradients;
+
       /**
        * For nodal basis functions with nodes located at the boundary of the
        * unit cell, face integrals that involve only the values of the shape
@@ -175,6 +175,60 @@ namespace internal
 
 
 
+    /**
+     * Check whether the points of the given quadrature formula on the
+     * reference simplex are obtained by collapsing a tensor product of the
+     * same 1d points in all directions, via the map
+     * $x_d = \xi_d \prod_{e>d} (1-\xi_e)$ used by QGaussCollapsedSimplex,
+     * with the points numbered lexicographically in the collapsed
+     * coordinates. If so, return the collapsed coordinates of all quadrature
+     * points, otherwise an empty vector.
+     */
+    template <int dim>
+    std::vector<Point<dim>>
+    compute_collapsed_coordinates(const Quadrature<dim> &quad)
+    {
+      const unsigned int n_points_1d = static_cast<unsigned int>(
+        std::round(std::pow(static_cast<double>(quad.size()), 1. / dim)));
+      if (dim < 2 || n_points_1d < 2 ||
+          Utilities::pow(n_points_1d, dim) != quad.size())
+        return {};
+
+      // invert the collapsing map, starting from the last coordinate
+      std::vector<Point<dim>> collapsed_points(quad.size());
+      for (unsigned int q = 0; q < quad.size(); ++q)
+        {
+          double sum = 0;
+          for (int d = dim - 1; d >= 0; --d)
+            {
+              if (1. - sum < 1e-12)
+                return {};
+              collapsed_points[q][d] = quad.point(q)[d] / (1. - sum);
+              sum += quad.point(q)[d];
+            }
+        }
+
+      // check the tensor-product structure with the 1d points taken from the
+      // first coordinate direction
+      const double tolerance = 1e-12;
+      for (unsigned int q = 0; q < quad.size(); ++q)
+        for (unsigned int d = 0, stride = 1; d < dim;
+             ++d, stride *= n_points_1d)
+          if (std::abs(collapsed_points[q][d] -
+                       collapsed_points[(q / stride) % n_points_1d][0]) >
+              tolerance)
+            return {};
+
+      for (unsigned int i = 1; i < n_points_1d; ++i)
+        if (std::abs(collapsed_points[i][0] - collapsed_points[i - 1][0]) <
+            tolerance)
+          return {};
+
+      return collapsed_points;
+    }
+
+
+
     template <int dim_to, int dim, int spacedim>
     std::unique_ptr<FiniteElement<dim_to, dim_to>>
     create_fe(const FiniteElement<dim, spacedim> &fe)
@@ -208,6 +262,7 @@ namespace internal
       , dofs_per_component_on_cell(0)
       , n_q_points_face(0)
       , dofs_per_component_on_face(0)
+      , n_q_points_1d_collapsed(0)
     {}
 
 
@@ -225,6 +280,7 @@ namespace internal
       , dofs_per_component_on_cell(0)
       , n_q_points_face(0)
       , dofs_per_component_on_face(0)
+      , n_q_points_1d_collapsed(0)
     {
       reinit(quad, fe_in, base_element_number);
     }
@@ -241,6 +297,9 @@ namespace internal
       static_assert(dim == spacedim,
                     "Currently, only the case dim=spacedim is implemented");
 
+      n_q_points_1d_collapsed = 0;
+      collapsed_coordinate_gradients.clear();
+
       // ShapeInfo for RT elements. Here, data is of size 2 instead of 1.
       // data[0] is univariate_shape_data in normal direction and
       // data[1] is univariate_shape_data in tangential direction
@@ -381,6 +440,134 @@ namespace internal
                                   q] = grad[d];
               }
 
+          // for polynomials on simplices evaluated with a collapsed
+          // tensor-product quadrature formula, set up the data to compute
+          // gradients by sum factorization. a polynomial of degree k on the
+          // simplex is a polynomial of degree k in each collapsed coordinate,
+          // so the derivatives of its interpolant in the quadrature points
+          // are exact if we have more than k points per direction
+          const auto fe_poly = dynamic_cast<const FE_Poly<dim, dim> *>(&fe);
+          if (dim > 1 && fe.reference_cell().is_simplex() &&
+              fe_poly != nullptr)
+            {
+              const std::vector<Point<dim>> collapsed_points =
+                compute_collapsed_coordinates(quad);
+              const unsigned int n_points_1d =
+                collapsed_points.empty() ?
+                  0 :
+                  static_cast<unsigned int>(std::round(
+                    std::pow(static_cast<double>(n_q_points), 1. / dim)));
+              if (n_points_1d > fe_poly->get_poly_space().degree() &&
+                  n_points_1d < 200)
+                {
+                  n_q_points_1d_collapsed = n_points_1d;
+
+                  std::vector<Point<1>> points_1d(n_points_1d);
+                  for (unsigned int i = 0; i < n_points_1d; ++i)
+                    points_1d[i][0] = collapsed_points[i][0];
+                  const std::vector<Polynomials::Polynomial<double>>
+                    poly_coll =
+                      Polynomials::generate_complete_Lagrange_basis(points_1d);
+                  univariate_shape_data.shape_gradients_collocation.resize(
+                    n_points_1d * n_points_1d);
+                  std::vector<double>   gradients_1d(n_points_1d *
+                                                   n_points_1d);
+                  std::array<double, 2> values;
+                  for (unsigned int i = 0; i < n_points_1d; ++i)
+                    for (unsigned int q = 0; q < n_points_1d; ++q)
+                      {
+                        poly_coll[i].value(points_1d[q][0], 1, values.data());
+                        gradients_1d[i * n_points_1d + q] = values[1];
+                        univariate_shape_data
+                          .shape_gradients_collocation[i * n_points_1d + q] =
+                          values[1];
+                      }
+
+                  // the derivatives of the collapsing map
+                  // x_d = xi_d * prod_{e>d} (1-xi_e), which we invert
+                  collapsed_coordinate_gradients.resize(dim * dim * n_q_points);
+                  std::vector<double> coordinate_gradients(dim * dim *
+                                                           n_q_points);
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    {
+                      const Point<dim> &xi = collapsed_points[q];
+                      Tensor<2, dim>    jacobian;
+                      for (unsigned int d = 0; d < dim; ++d)
+                        for (unsigned int e = d; e < dim; ++e)
+                          {
+                            double entry = (e == d) ? 1. : -xi[d];
+                            for (unsigned int f = d + 1; f < dim; ++f)
+                              if (f != e)
+                                entry *= 1. - xi[f];
+                            jacobian[d][e] = entry;
+                          }
+                      const Tensor<2, dim> inverse_jacobian = invert(jacobian);
+                      for (unsigned int e = 0; e < dim; ++e)
+                        for (unsigned int d = 0; d < dim; ++d)
+                          {
+                            coordinate_gradients[(e * dim + d) * n_q_points +
+                                                 q] = inverse_jacobian[e][d];
+                            collapsed_coordinate_gradients[(e * dim + d) *
+                                                             n_q_points +
+                                                           q] =
+                              inverse_jacobian[e][d];
+                          }
+                    }
+
+                  // the degree reported by the polynomial space is only a
+                  // lower bound of the total degree for some spaces, e.g.
+                  // with the bubble functions of FE_SimplexP_Bubbles, so
+                  // check that sum factorization reproduces the gradients
+                  // of the shape functions and fall back to the dense
+                  // evaluation otherwise
+                  bool                gradients_are_exact = true;
+                  std::vector<double> values_i(n_q_points);
+                  for (unsigned int i = 0;
+                       i < n_dofs && gradients_are_exact;
+                       ++i)
+                    {
+                      for (unsigned int q = 0; q < n_q_points; ++q)
+                        values_i[q] = fe.shape_value(i, quad.point(q));
+                      for (unsigned int q = 0; q < n_q_points; ++q)
+                        {
+                          Tensor<1, dim> gradient;
+                          unsigned int   stride = 1;
+                          for (unsigned int e = 0; e < dim; ++e)
+                            {
+                              const unsigned int q_e =
+                                (q / stride) % n_points_1d;
+                              const unsigned int q_first = q - q_e * stride;
+                              double             derivative = 0;
+                              for (unsigned int j = 0; j < n_points_1d; ++j)
+                                derivative +=
+                                  gradients_1d[j * n_points_1d + q_e] *
+                                  values_i[q_first + j * stride];
+                              for (unsigned int d = 0; d < dim; ++d)
+                                gradient[d] +=
+                                  coordinate_gradients[(e * dim + d) *
+                                                         n_q_points +
+                                                       q] *
+                                  derivative;
+                              stride *= n_points_1d;
+                            }
+                          const Tensor<1, dim> exact =
+                            fe.shape_grad(i, quad.point(q));
+                          if ((gradient - exact).norm() >
+                              1e-8 * std::max(1., exact.norm()))
+                            gradients_are_exact = false;
+                        }
+                    }
+
+                  if (!gradients_are_exact)
+                    {
+                      n_q_points_1d_collapsed = 0;
+                      univariate_shape_data.shape_gradients_collocation
+                        .clear();
+                      collapsed_coordinate_gradients.clear();
+                    }
+                }
+            }
+
           {
             const auto reference_cell = fe.reference_cell();
 
@@ -1244,6 +1431,8 @@ namespace internal
       std::size_t memory = sizeof(*this);
       for (const auto &univariate_shape_data : data)
         memory += univariate_shape_data.memory_consumption();
+      memory +=
+        MemoryConsumption::memory_consumption(collapsed_coordinate_gradients);
       return memory;
     }
 
@@ -84,6 +84,20 @@ namespace internal
     virtual void
     cell(const unsigned int range_index) = 0;
 
+    /// Finishes the communication for the update ghost values operation and
+    /// runs the cell work of the ranges [begin_range, end_range). The
+    /// default implementation waits for all ghost data before running the
+    /// cell work, whereas derived classes may start the work on a cell batch
+    /// as soon as the ghost data it reads has arrived
+    virtual void
+    vector_update_ghosts_finish_and_cell(const unsigned int begin_range,
+                                         const unsigned int end_range)
+    {
+      vector_update_ghosts_finish();
+      for (unsigned int i = begin_range; i < end_range; ++i)
+        cell(i);
+    }
+
     /// Runs the body of the work on interior faces specified by
     /// MatrixFree::loop
     virtual void
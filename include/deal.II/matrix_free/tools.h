@@ -18,12 +18,23 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/std_cxx20/iota_view.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/work_stream.h>
+
 #include <deal.II/grid/tria.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+
 #include <deal.II/matrix_free/fe_evaluation.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/vector_access_internal.h>
 
+#include <type_traits>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -104,6 +115,14 @@ namespace MatrixFreeTools
    * @p matrix_free and the local cell integral operation @p local_vmult.
    * Constrained entries on the diagonal are set to one.
    *
+   * The element matrices of all lanes of a cell batch are computed together
+   * by applying @p local_vmult to the unit vectors. The cell batches are
+   * processed in parallel with WorkStream::run(), independently of the
+   * parallelization scheme selected in @p matrix_free, so @p local_vmult
+   * must be safe to call from several threads at once. The element matrices
+   * are added to @p matrix by a single thread at a time, so any matrix type
+   * supported by AffineConstraints::distribute_local_to_global() can be used.
+   *
    * The parameters @p dof_no, @p quad_no, and @p first_selected_component are
    * passed to the constructor of the FEEvaluation that is internally set up.
    */
@@ -158,6 +177,180 @@ namespace MatrixFreeTools
 
 
 
+  /**
+   * Call @p kernel with an argument of type `std::integral_constant<int,
+   * degree>` that carries the polynomial degree @p fe_degree as a
+   * compile-time constant, if @p fe_degree is between 1 and @p max_degree,
+   * and with `std::integral_constant<int, -1>` otherwise. This allows to
+   * select code with the degree as template argument, e.g. FEEvaluation with
+   * loops of compile-time length in the sum-factorization kernels and in the
+   * user code at quadrature points, from a degree that is only known at run
+   * time. The @p kernel is typically a generic lambda, which gets
+   * instantiated for all degrees up to @p max_degree and for the fallback
+   * degree -1:
+   * @code
+   * MatrixFreeTools::select_fe_degree<4>(fe_degree, [&](const auto degree) {
+   *   constexpr int fe_degree     = decltype(degree)::value;
+   *   constexpr int n_q_points_1d = fe_degree == -1 ? 0 : fe_degree + 1;
+   *   FEEvaluation<dim, fe_degree, n_q_points_1d> phi(matrix_free);
+   *   ...
+   * });
+   * @endcode
+   */
+  template <int max_degree, typename Kernel>
+  void
+  select_fe_degree(const unsigned int fe_degree, const Kernel &kernel);
+
+  /**
+   * Perform a loop over all cells of @p matrix_free like
+   * MatrixFree::cell_loop(), where @p cell_operation is called with the
+   * polynomial degree of the cell range as compile-time constant, as
+   * selected by select_fe_degree(). In the hp-adaptive case, MatrixFree
+   * groups the cell batches by the active FE index, so each range passed to
+   * @p cell_operation has a unique degree, which is read from the element
+   * of the DoFHandler with index @p dof_handler_index. This way, operators
+   * on an hp::FECollection with different degrees run with the templated
+   * kernels of the respective degree, rather than in FEEvaluation with
+   * degree -1. The @p cell_operation is called with the arguments
+   * `(degree, matrix_free, dst, src, cell_range)` and is typically a generic
+   * lambda:
+   * @code
+   * MatrixFreeTools::cell_loop_hp<max_degree>(
+   *   matrix_free,
+   *   [&](const auto degree,
+   *       const auto &matrix_free,
+   *       auto &dst,
+   *       const auto &src,
+   *       const auto cell_range) {
+   *     constexpr int fe_degree     = decltype(degree)::value;
+   *     constexpr int n_q_points_1d = fe_degree == -1 ? 0 : fe_degree + 1;
+   *     FEEvaluation<dim, fe_degree, n_q_points_1d> phi(matrix_free,
+   *                                                     cell_range);
+   *     for (unsigned int cell = cell_range.first; cell < cell_range.second;
+   *          ++cell)
+   *       {
+   *         phi.reinit(cell);
+   *         ...
+   *       }
+   *   },
+   *   dst,
+   *   src);
+   * @endcode
+   * The constraints, including the hanging-node constraints between cells of
+   * different degrees, are resolved by FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global() as in the case without
+   * hp-adaptivity.
+   *
+   * @note The number of quadrature points selected in @p cell_operation must
+   * match the quadrature formula of the active FE index used to set up
+   * @p matrix_free.
+   */
+  template <int max_degree,
+            int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            typename OutVector,
+            typename InVector,
+            typename CellOperation>
+  void
+  cell_loop_hp(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+               const CellOperation &cell_operation,
+               OutVector           &dst,
+               const InVector      &src,
+               const bool           zero_dst_vector   = false,
+               const unsigned int   dof_handler_index = 0);
+
+
+
+  /**
+   * The run time of a user operation measured by autotune_vectorization()
+   * for one combination of the SIMD width and the task-parallel scheme.
+   */
+  template <int dim, typename Number>
+  struct AutotuneResult
+  {
+    /**
+     * The number of SIMD lanes, i.e., the width of the VectorizedArray type
+     * used as the third template argument of MatrixFree.
+     */
+    unsigned int n_lanes;
+
+    /**
+     * The scheme for task parallelism set in MatrixFree::AdditionalData.
+     */
+    typename MatrixFree<dim, Number>::AdditionalData::TasksParallelScheme
+      tasks_parallel_scheme;
+
+    /**
+     * The wall time of one call to the operation in seconds, averaged over
+     * all repetitions and maximized over all MPI processes.
+     */
+    double time;
+  };
+
+  /**
+   * Measure the run time of a user operation for a MatrixFree object set up
+   * with different SIMD widths, i.e., VectorizedArray<Number, n_lanes> for
+   * all values of @p n_lanes supported by the platform from 1 up to
+   * VectorizedArray<Number>::size(), and different schemes for task
+   * parallelism. The widest SIMD width is not always the fastest choice,
+   * e.g., for low polynomial degrees, where the gather and scatter of the
+   * vector entries for several cells is expensive, or on meshes where many
+   * cell batches are only partially filled. This function replaces the
+   * manual sweep over these parameters.
+   *
+   * For each combination, a MatrixFree object is initialized with @p mapping,
+   * @p dof_handler, @p constraints, @p quadrature, and @p additional_data,
+   * where only the field AdditionalData::tasks_parallel_scheme is changed.
+   * Then, @p create_operation is called with this MatrixFree object. It must
+   * return a function object that runs the operation to be measured, e.g.,
+   * one operator evaluation, and sets up all data needed by the operation,
+   * like vectors, outside of the measured time. Since the type of the
+   * MatrixFree object differs between the SIMD widths, @p create_operation
+   * is typically a generic lambda:
+   * @code
+   * const auto results =
+   *   MatrixFreeTools::autotune_vectorization<dim, double>(
+   *     mapping, dof_handler, constraints, QGauss<1>(fe_degree + 1), data,
+   *     [](const auto &matrix_free) {
+   *       using VectorType = LinearAlgebra::distributed::Vector<double>;
+   *       auto src = std::make_shared<VectorType>();
+   *       auto dst = std::make_shared<VectorType>();
+   *       matrix_free.initialize_dof_vector(*src);
+   *       matrix_free.initialize_dof_vector(*dst);
+   *       src->add(1.);
+   *       return [&matrix_free, src, dst]() {
+   *         // run the operator, e.g. matrix_free.cell_loop(...)
+   *       };
+   *     });
+   * const unsigned int best_n_lanes = results[0].n_lanes;
+   * @endcode
+   *
+   * The operation is run once for warming up and then @p n_repetitions
+   * times, and the average time is recorded. If @p tune_tasks_parallel_scheme
+   * is true and more than one thread is available, the schemes
+   * AdditionalData::none, AdditionalData::partition_partition,
+   * AdditionalData::partition_color and AdditionalData::color are tested,
+   * otherwise only the scheme given in @p additional_data.
+   *
+   * The results are returned sorted by the measured time, i.e., the first
+   * entry describes the fastest setting. Since the times are maximized over
+   * all MPI processes, all processes select the same setting.
+   */
+  template <int dim, typename Number, typename number2, typename Operation>
+  std::vector<AutotuneResult<dim, Number>>
+  autotune_vectorization(
+    const Mapping<dim>                                     &mapping,
+    const DoFHandler<dim>                                  &dof_handler,
+    const AffineConstraints<number2>                       &constraints,
+    const Quadrature<1>                                    &quadrature,
+    const typename MatrixFree<dim, Number>::AdditionalData &additional_data,
+    const Operation                                        &create_operation,
+    const unsigned int                                      n_repetitions = 10,
+    const bool tune_tasks_parallel_scheme = true);
+
+
+
   /**
    * A wrapper around MatrixFree to help users to deal with DoFHandler
    * objects involving cells without degrees of freedom, i.e.,
@@ -339,6 +532,217 @@ namespace MatrixFreeTools
     unsigned int fe_index_valid;
   };
 
+
+
+  /**
+   * A block-Jacobi (additive Schwarz) preconditioner for operators of the form
+   * $\mu M + \kappa L$, where $M$ is the mass matrix and $L$ the matrix of
+   * the Laplace operator, with blocks that are either the cells or the
+   * vertex patches of the mesh. The inverse of each block is applied with
+   * the fast diagonalization method of the class
+   * TensorProductMatrixSymmetricSum, using a separable approximation of the
+   * block with one 1d mass matrix and one 1d Laplace matrix per coordinate
+   * direction. Compared to the point-Jacobi method with the diagonal
+   * computed by compute_diagonal(), these smoothers typically need
+   * considerably fewer multigrid iterations for high polynomial degrees,
+   * while the cost of applying the inverse of a block with $k^d$ unknowns
+   * is only $\mathcal O(k^{d+1})$.
+   *
+   * The 1d matrices are computed automatically: The reference 1d mass and
+   * Laplace matrices are set up from the univariate shape data stored in
+   * the ShapeInfo of the given MatrixFree object, and they are scaled with
+   * the extent of the cells in the respective direction, which is computed
+   * from the inverse Jacobians stored in MappingInfo. For axis-aligned
+   * rectangular cells, the separable approximation is exact; for deformed
+   * cells, it is a good approximation as long as the cells are not too
+   * distorted. The blocks are set up and applied vectorized across several
+   * cells or patches with the data type @p VectorizedArrayType.
+   *
+   * Two types of blocks are supported, see AdditionalData::PatchType:
+   * <ul>
+   * <li> Cell blocks. For discontinuous elements like FE_DGQ, the block
+   * contains all unknowns of a cell, and the face terms of the symmetric
+   * interior penalty method with penalty parameter
+   * $\sigma = \eta (k+1)^2/h$, where $\eta$ is
+   * AdditionalData::penalty_factor, are included in the 1d Laplace
+   * matrices. For continuous elements like FE_Q, the block contains all
+   * unknowns of the cell including the ones on the cell boundary, where the
+   * contribution of the neighboring cells to the diagonal entries of these
+   * unknowns is included. Unknowns constrained by the AffineConstraints
+   * object passed to MatrixFree are neither read nor written. The
+   * contributions of the cells are added up.
+   * <li> Vertex patches, only for continuous elements. The block contains
+   * the unknowns in the interior of the $2^d$ cells around a vertex, i.e.,
+   * $(2k-1)^d$ unknowns for polynomial degree $k$. Blocks are only set up
+   * for vertices with exactly $2^d$ adjacent cells, which all need to be
+   * part of the MatrixFree object on the present MPI process and be
+   * oriented in a standard way; all other vertices, like those at the
+   * boundary, those adjacent to cells on other MPI processes, and hanging
+   * vertices, are skipped. The unknowns in the interior of a patch must
+   * not be constrained. The contributions of the patches are added up.
+   * </ul>
+   *
+   * Since the contributions of overlapping blocks are added up, the
+   * preconditioner should be used together with a relaxation parameter or
+   * within a Chebyshev iteration, which estimates the spectrum of the
+   * preconditioned operator.
+   *
+   * The mapping data of the MatrixFree object needs to include the
+   * inverse Jacobians, i.e., MatrixFree::AdditionalData::mapping_update_flags
+   * needs to include @p update_gradients. Only scalar elements with the same
+   * polynomial degree in all directions are supported.
+   */
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType = VectorizedArray<Number>>
+  class TensorProductBlockJacobi : public Subscriptor
+  {
+  public:
+    /**
+     * The vector type the preconditioner can be applied to.
+     */
+    using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+    /**
+     * Struct that helps to configure TensorProductBlockJacobi.
+     */
+    struct AdditionalData
+    {
+      /**
+       * The type of the blocks.
+       */
+      enum class PatchType
+      {
+        /**
+         * One block for each cell.
+         */
+        cell,
+        /**
+         * One block for the interior of each vertex patch.
+         */
+        vertex_patch
+      };
+
+      /**
+       * Constructor.
+       */
+      AdditionalData(
+        const PatchType                     patch_type      = PatchType::cell,
+        const Number                        mass_factor     = 0.,
+        const Number                        laplace_factor  = 1.,
+        const Number                        penalty_factor  = 1.,
+        const std::set<types::boundary_id> &dirichlet_boundaries = {},
+        const unsigned int                  dof_index            = 0,
+        const unsigned int                  quad_index           = 0);
+
+      /**
+       * The type of the blocks.
+       */
+      PatchType patch_type;
+
+      /**
+       * The factor $\mu$ in front of the mass matrix.
+       */
+      Number mass_factor;
+
+      /**
+       * The factor $\kappa$ in front of the Laplace matrix.
+       */
+      Number laplace_factor;
+
+      /**
+       * The factor $\eta$ in the penalty parameter of the symmetric interior
+       * penalty method for discontinuous elements. It is ignored for
+       * continuous elements.
+       */
+      Number penalty_factor;
+
+      /**
+       * The boundary IDs of the boundary parts with Dirichlet conditions.
+       * For discontinuous elements, the penalty terms are added on these
+       * boundaries; for continuous elements, the unknowns on these
+       * boundaries are removed from the blocks. Natural boundary conditions
+       * are assumed on all other boundaries.
+       */
+      std::set<types::boundary_id> dirichlet_boundaries;
+
+      /**
+       * Index of the DoFHandler within MatrixFree to be used.
+       */
+      unsigned int dof_index;
+
+      /**
+       * Index of the quadrature formula within MatrixFree to be used for
+       * computing the reference 1d matrices and the cell extents.
+       */
+      unsigned int quad_index;
+    };
+
+    /**
+     * Compute the inverses of all blocks for the given MatrixFree object,
+     * which needs to be kept alive as long as this object is used.
+     */
+    void
+    initialize(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+               const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Apply the preconditioner, i.e., add the inverse of each block applied
+     * to the entries of @p src in the block into @p dst, which is zeroed
+     * first.
+     */
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return the number of blocks on the present MPI process.
+     */
+    unsigned int
+    n_blocks() const;
+
+    /**
+     * Return the memory consumption of this class in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Reference to the underlying MatrixFree object.
+     */
+    SmartPointer<const MatrixFree<dim, Number, VectorizedArrayType>>
+      matrix_free;
+
+    /**
+     * The settings passed to initialize().
+     */
+    AdditionalData additional_data;
+
+    /**
+     * The 1d matrices, eigenvalues and eigenvectors of all blocks, with one
+     * entry per cell batch or per batch of vertex patches.
+     */
+    std::unique_ptr<
+      TensorProductMatrixSymmetricSumCollection<dim, VectorizedArrayType>>
+      block_inverses;
+
+    /**
+     * The number of blocks.
+     */
+    unsigned int n_blocks_total = 0;
+
+    /**
+     * The number of unknowns of a vertex patch.
+     */
+    unsigned int n_dofs_per_patch = 0;
+
+    /**
+     * The local indices of the unknowns of the vertex patches in
+     * lexicographic order, with the patches of a batch running fastest.
+     */
+    std::vector<unsigned int> patch_dof_indices;
+  };
+
   // implementations
 
 #ifndef DOXYGEN
@@ -1105,6 +1509,76 @@ namespace MatrixFreeTools
       first_selected_component);
   }
 
+  namespace internal
+  {
+    template <int degree, int max_degree, typename Kernel>
+    void
+    select_fe_degree_recursive(const unsigned int fe_degree,
+                               const Kernel      &kernel)
+    {
+      if (fe_degree == degree)
+        kernel(std::integral_constant<int, degree>());
+      else if constexpr (degree < max_degree)
+        select_fe_degree_recursive<degree + 1, max_degree>(fe_degree, kernel);
+      else
+        kernel(std::integral_constant<int, -1>());
+    }
+  } // namespace internal
+
+  template <int max_degree, typename Kernel>
+  void
+  select_fe_degree(const unsigned int fe_degree, const Kernel &kernel)
+  {
+    if constexpr (max_degree > 0)
+      internal::select_fe_degree_recursive<1, max_degree>(fe_degree, kernel);
+    else
+      kernel(std::integral_constant<int, -1>());
+  }
+
+  template <int max_degree,
+            int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            typename OutVector,
+            typename InVector,
+            typename CellOperation>
+  void
+  cell_loop_hp(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+               const CellOperation &cell_operation,
+               OutVector           &dst,
+               const InVector      &src,
+               const bool           zero_dst_vector,
+               const unsigned int   dof_handler_index)
+  {
+    const auto &dof_info = matrix_free.get_dof_info(dof_handler_index);
+
+    matrix_free.template cell_loop<OutVector, InVector>(
+      [&](const MatrixFree<dim, Number, VectorizedArrayType> &data,
+          OutVector                                          &dst,
+          const InVector                                     &src,
+          const std::pair<unsigned int, unsigned int>        &cell_range) {
+        const unsigned int active_fe_index =
+          dof_info.cell_active_fe_index.empty() ?
+            0 :
+            data.get_cell_active_fe_index(cell_range);
+        const unsigned int fe_degree =
+          data
+            .get_shape_info(dof_handler_index,
+                            0,
+                            dof_info.component_to_base_index[0],
+                            active_fe_index)
+            .data.front()
+            .fe_degree;
+
+        select_fe_degree<max_degree>(fe_degree, [&](const auto degree) {
+          cell_operation(degree, data, dst, src, cell_range);
+        });
+      },
+      dst,
+      src,
+      zero_dst_vector);
+  }
+
   namespace internal
   {
     /**
@@ -1183,84 +1657,106 @@ namespace MatrixFreeTools
                                                         constraints_in,
                                                         constraints_for_matrix);
 
-    matrix_free.template cell_loop<MatrixType, MatrixType>(
-      [&](const auto &, auto &dst, const auto &, const auto range) {
-        FEEvaluation<dim,
-                     fe_degree,
-                     n_q_points_1d,
-                     n_components,
-                     Number,
-                     VectorizedArrayType>
-          integrator(
-            matrix_free, range, dof_no, quad_no, first_selected_component);
-
-        const unsigned int dofs_per_cell = integrator.dofs_per_cell;
-
-        std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
-        std::vector<types::global_dof_index> dof_indices_mf(dofs_per_cell);
-
-        std::array<FullMatrix<typename MatrixType::value_type>,
-                   VectorizedArrayType::size()>
-          matrices;
+    using FEEvalType = FEEvaluation<dim,
+                                    fe_degree,
+                                    n_q_points_1d,
+                                    n_components,
+                                    Number,
+                                    VectorizedArrayType>;
+    using MatrixNumber = typename MatrixType::value_type;
+
+    // The element matrices of all lanes of a cell batch are computed at once
+    // by applying the cell operation to the unit vectors, which is done in
+    // parallel for the cell batches. The resulting matrices are written into
+    // the global matrix one batch at a time, which works for all matrix
+    // types and does not depend on the parallelization scheme of the
+    // MatrixFree object.
+    struct ScratchData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+    };
 
-        std::fill_n(matrices.begin(),
-                    VectorizedArrayType::size(),
-                    FullMatrix<typename MatrixType::value_type>(dofs_per_cell,
-                                                                dofs_per_cell));
+    struct CopyData
+    {
+      unsigned int n_filled_lanes = 0;
+      std::array<FullMatrix<MatrixNumber>, VectorizedArrayType::size()>
+        matrices;
+      std::array<std::vector<types::global_dof_index>,
+                 VectorizedArrayType::size()>
+        dof_indices;
+    };
 
-        const auto lexicographic_numbering =
-          matrix_free
-            .get_shape_info(dof_no,
+    const auto worker = [&](const auto   &cell_iterator,
+                            ScratchData &scratch_data,
+                            CopyData    &copy_data) {
+      const unsigned int cell = *cell_iterator;
+
+      // the evaluator uses the scratch memory of the MatrixFree object of
+      // the current thread, so it must not be kept in the scratch data,
+      // which WorkStream might destroy on another thread
+      FEEvalType integrator(matrix_free,
+                            std::make_pair(cell, cell + 1),
+                            dof_no,
                             quad_no,
-                            first_selected_component,
-                            integrator.get_active_fe_index(),
-                            integrator.get_active_quadrature_index())
-            .lexicographic_numbering;
-
-        for (auto cell = range.first; cell < range.second; ++cell)
-          {
-            integrator.reinit(cell);
-
-            const unsigned int n_filled_lanes =
-              matrix_free.n_active_entries_per_cell_batch(cell);
-
-            for (unsigned int v = 0; v < n_filled_lanes; ++v)
-              matrices[v] = 0.0;
+                            first_selected_component);
+      const std::vector<unsigned int> &lexicographic_numbering =
+        matrix_free
+          .get_shape_info(dof_no,
+                          quad_no,
+                          first_selected_component,
+                          integrator.get_active_fe_index(),
+                          integrator.get_active_quadrature_index())
+          .lexicographic_numbering;
+      const unsigned int dofs_per_cell = integrator.dofs_per_cell;
+      integrator.reinit(cell);
+
+      copy_data.n_filled_lanes =
+        matrix_free.n_active_entries_per_cell_batch(cell);
+      for (unsigned int v = 0; v < copy_data.n_filled_lanes; ++v)
+        copy_data.matrices[v].reinit(dofs_per_cell, dofs_per_cell, true);
+
+      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+        {
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            integrator.begin_dof_values()[i] = static_cast<Number>(i == j);
 
-            for (unsigned int j = 0; j < dofs_per_cell; ++j)
-              {
-                for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                  integrator.begin_dof_values()[i] =
-                    static_cast<Number>(i == j);
+          local_vmult(integrator);
 
-                local_vmult(integrator);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            for (unsigned int v = 0; v < copy_data.n_filled_lanes; ++v)
+              copy_data.matrices[v](i, j) = integrator.begin_dof_values()[i][v];
+        }
 
-                for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                  for (unsigned int v = 0; v < n_filled_lanes; ++v)
-                    matrices[v](i, j) = integrator.begin_dof_values()[i][v];
-              }
+      scratch_data.dof_indices.resize(dofs_per_cell);
+      for (unsigned int v = 0; v < copy_data.n_filled_lanes; ++v)
+        {
+          const auto cell_v = matrix_free.get_cell_iterator(cell, v, dof_no);
 
-            for (unsigned int v = 0; v < n_filled_lanes; ++v)
-              {
-                const auto cell_v =
-                  matrix_free.get_cell_iterator(cell, v, dof_no);
+          if (matrix_free.get_mg_level() != numbers::invalid_unsigned_int)
+            cell_v->get_mg_dof_indices(scratch_data.dof_indices);
+          else
+            cell_v->get_dof_indices(scratch_data.dof_indices);
 
-                if (matrix_free.get_mg_level() != numbers::invalid_unsigned_int)
-                  cell_v->get_mg_dof_indices(dof_indices);
-                else
-                  cell_v->get_dof_indices(dof_indices);
+          copy_data.dof_indices[v].resize(dofs_per_cell);
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            copy_data.dof_indices[v][j] =
+              scratch_data.dof_indices[lexicographic_numbering[j]];
+        }
+    };
 
-                for (unsigned int j = 0; j < dof_indices.size(); ++j)
-                  dof_indices_mf[j] = dof_indices[lexicographic_numbering[j]];
+    const auto copier = [&](const CopyData &copy_data) {
+      for (unsigned int v = 0; v < copy_data.n_filled_lanes; ++v)
+        constraints.distribute_local_to_global(copy_data.matrices[v],
+                                               copy_data.dof_indices[v],
+                                               matrix);
+    };
 
-                constraints.distribute_local_to_global(matrices[v],
-                                                       dof_indices_mf,
-                                                       dst);
-              }
-          }
-      },
-      matrix,
-      matrix);
+    WorkStream::run(std_cxx20::ranges::iota_view<unsigned int, unsigned int>(
+                      0U, matrix_free.n_cell_batches()),
+                    worker,
+                    copier,
+                    ScratchData(),
+                    CopyData());
 
     matrix.compress(VectorOperation::add);
   }
@@ -1305,6 +1801,753 @@ namespace MatrixFreeTools
       first_selected_component);
   }
 
+  namespace internal
+  {
+    /**
+     * Copy the settings of an AdditionalData object to the AdditionalData
+     * object of a MatrixFree class with different template arguments.
+     */
+    template <typename AdditionalDataOut, typename AdditionalDataIn>
+    AdditionalDataOut
+    convert_additional_data(const AdditionalDataIn &in)
+    {
+      AdditionalDataOut out;
+      out.tasks_parallel_scheme =
+        static_cast<typename AdditionalDataOut::TasksParallelScheme>(
+          in.tasks_parallel_scheme);
+      out.tasks_block_size                    = in.tasks_block_size;
+      out.mapping_update_flags                = in.mapping_update_flags;
+      out.mapping_update_flags_boundary_faces =
+        in.mapping_update_flags_boundary_faces;
+      out.mapping_update_flags_inner_faces =
+        in.mapping_update_flags_inner_faces;
+      out.mapping_update_flags_faces_by_cells =
+        in.mapping_update_flags_faces_by_cells;
+      out.mg_level                          = in.mg_level;
+      out.store_plain_indices               = in.store_plain_indices;
+      out.initialize_indices                = in.initialize_indices;
+      out.initialize_mapping                = in.initialize_mapping;
+      out.overlap_communication_computation =
+        in.overlap_communication_computation;
+      out.hold_all_faces_to_owned_cells = in.hold_all_faces_to_owned_cells;
+      out.cell_vectorization_category   = in.cell_vectorization_category;
+      out.cell_vectorization_categories_strict =
+        in.cell_vectorization_categories_strict;
+      out.allow_ghosted_vectors_in_loops = in.allow_ghosted_vectors_in_loops;
+      out.compute_geometry_on_the_fly    = in.compute_geometry_on_the_fly;
+      out.communicator_sm                = in.communicator_sm;
+      return out;
+    }
+
+
+
+    /**
+     * Run the measurements of autotune_vectorization() for a SIMD width of
+     * @p n_lanes and continue with the next wider SIMD width.
+     */
+    template <int          dim,
+              typename Number,
+              unsigned int n_lanes,
+              typename number2,
+              typename Operation>
+    void
+    autotune_vectorization_width(
+      const Mapping<dim>                                     &mapping,
+      const DoFHandler<dim>                                  &dof_handler,
+      const AffineConstraints<number2>                       &constraints,
+      const Quadrature<1>                                    &quadrature,
+      const typename MatrixFree<dim, Number>::AdditionalData &additional_data,
+      const Operation                                        &create_operation,
+      const unsigned int                                      n_repetitions,
+      const std::vector<
+        typename MatrixFree<dim, Number>::AdditionalData::TasksParallelScheme>
+                                               &schemes,
+      std::vector<AutotuneResult<dim, Number>> &results)
+    {
+      if constexpr (n_lanes <= VectorizedArray<Number>::size())
+        {
+          // VectorizedArray is only available for the scalar case and for
+          // widths of at least 128 bits
+          if constexpr (n_lanes == 1 || n_lanes * sizeof(Number) >= 16)
+            {
+              using VectorizedArrayType = VectorizedArray<Number, n_lanes>;
+              using MatrixFreeType =
+                MatrixFree<dim, Number, VectorizedArrayType>;
+
+              for (const auto scheme : schemes)
+                {
+                  typename MatrixFreeType::AdditionalData data =
+                    convert_additional_data<
+                      typename MatrixFreeType::AdditionalData>(
+                      additional_data);
+                  data.tasks_parallel_scheme =
+                    static_cast<typename MatrixFreeType::AdditionalData::
+                                  TasksParallelScheme>(scheme);
+
+                  MatrixFreeType matrix_free;
+                  matrix_free.reinit(
+                    mapping, dof_handler, constraints, quadrature, data);
+
+                  const auto operation = create_operation(matrix_free);
+
+                  // run once to warm up caches and to allocate scratch data
+                  operation();
+
+                  Timer timer(dof_handler.get_communicator());
+                  timer.restart();
+                  for (unsigned int i = 0; i < n_repetitions; ++i)
+                    operation();
+                  timer.stop();
+
+                  AutotuneResult<dim, Number> result;
+                  result.n_lanes               = n_lanes;
+                  result.tasks_parallel_scheme = scheme;
+                  result.time =
+                    Utilities::MPI::max(timer.wall_time(),
+                                        dof_handler.get_communicator()) /
+                    std::max(n_repetitions, 1U);
+                  results.push_back(result);
+                }
+            }
+
+          autotune_vectorization_width<dim, Number, 2 * n_lanes>(
+            mapping,
+            dof_handler,
+            constraints,
+            quadrature,
+            additional_data,
+            create_operation,
+            n_repetitions,
+            schemes,
+            results);
+        }
+    }
+  } // namespace internal
+
+
+
+  template <int dim, typename Number, typename number2, typename Operation>
+  std::vector<AutotuneResult<dim, Number>>
+  autotune_vectorization(
+    const Mapping<dim>                                     &mapping,
+    const DoFHandler<dim>                                  &dof_handler,
+    const AffineConstraints<number2>                       &constraints,
+    const Quadrature<1>                                    &quadrature,
+    const typename MatrixFree<dim, Number>::AdditionalData &additional_data,
+    const Operation                                        &create_operation,
+    const unsigned int                                      n_repetitions,
+    const bool tune_tasks_parallel_scheme)
+  {
+    using AdditionalData = typename MatrixFree<dim, Number>::AdditionalData;
+
+    std::vector<typename AdditionalData::TasksParallelScheme> schemes;
+    if (tune_tasks_parallel_scheme && MultithreadInfo::n_threads() > 1)
+      schemes = {AdditionalData::none,
+                 AdditionalData::partition_partition,
+                 AdditionalData::partition_color,
+                 AdditionalData::color};
+    else
+      schemes = {additional_data.tasks_parallel_scheme};
+
+    std::vector<AutotuneResult<dim, Number>> results;
+    internal::autotune_vectorization_width<dim, Number, 1>(mapping,
+                                                           dof_handler,
+                                                           constraints,
+                                                           quadrature,
+                                                           additional_data,
+                                                           create_operation,
+                                                           n_repetitions,
+                                                           schemes,
+                                                           results);
+
+    std::stable_sort(results.begin(),
+                     results.end(),
+                     [](const auto &a, const auto &b) {
+                       return a.time < b.time;
+                     });
+    return results;
+  }
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  TensorProductBlockJacobi<dim, Number, VectorizedArrayType>::AdditionalData::
+    AdditionalData(const PatchType                     patch_type,
+                   const Number                        mass_factor,
+                   const Number                        laplace_factor,
+                   const Number                        penalty_factor,
+                   const std::set<types::boundary_id> &dirichlet_boundaries,
+                   const unsigned int                  dof_index,
+                   const unsigned int                  quad_index)
+    : patch_type(patch_type)
+    , mass_factor(mass_factor)
+    , laplace_factor(laplace_factor)
+    , penalty_factor(penalty_factor)
+    , dirichlet_boundaries(dirichlet_boundaries)
+    , dof_index(dof_index)
+    , quad_index(quad_index)
+  {}
+
+
+
+  namespace internal
+  {
+    /**
+     * Compute the 1d mass and Laplace matrices on the unit interval from the
+     * univariate shape data of a tensor-product element.
+     */
+    template <typename Number, typename VectorizedArrayType>
+    std::pair<Table<2, Number>, Table<2, Number>>
+    compute_reference_1d_matrices(
+      const dealii::internal::MatrixFreeFunctions::UnivariateShapeData<
+        VectorizedArrayType> &data)
+    {
+      const unsigned int n_dofs_1d     = data.fe_degree + 1;
+      const unsigned int n_q_points_1d = data.n_q_points_1d;
+
+      Table<2, Number> mass_matrix(n_dofs_1d, n_dofs_1d);
+      Table<2, Number> laplace_matrix(n_dofs_1d, n_dofs_1d);
+      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+        for (unsigned int j = 0; j < n_dofs_1d; ++j)
+          for (unsigned int q = 0; q < n_q_points_1d; ++q)
+            {
+              const Number weight = data.quadrature.weight(q);
+              mass_matrix(i, j) += data.shape_values[i * n_q_points_1d + q][0] *
+                                   data.shape_values[j * n_q_points_1d + q][0] *
+                                   weight;
+              laplace_matrix(i, j) +=
+                data.shape_gradients[i * n_q_points_1d + q][0] *
+                data.shape_gradients[j * n_q_points_1d + q][0] * weight;
+            }
+
+      return {mass_matrix, laplace_matrix};
+    }
+
+
+
+    /**
+     * Compute the extent of the cells of the batch @p phi is initialized to
+     * in the direction of each unit coordinate, given by the inverse of the
+     * length of the gradient of the unit coordinate averaged over the
+     * quadrature points.
+     */
+    template <int dim, typename Number, typename VectorizedArrayType>
+    std::array<VectorizedArrayType, dim>
+    compute_cell_extent(
+      const FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType> &phi)
+    {
+      std::array<VectorizedArrayType, dim> extent;
+      for (unsigned int e = 0; e < dim; ++e)
+        extent[e] = VectorizedArrayType();
+
+      for (const unsigned int q : phi.quadrature_point_indices())
+        {
+          const Tensor<2, dim, VectorizedArrayType> inverse_jacobian =
+            phi.inverse_jacobian(q);
+          for (unsigned int e = 0; e < dim; ++e)
+            {
+              VectorizedArrayType norm_square = VectorizedArrayType();
+              for (unsigned int d = 0; d < dim; ++d)
+                norm_square +=
+                  inverse_jacobian[d][e] * inverse_jacobian[d][e];
+              extent[e] += std::sqrt(norm_square);
+            }
+        }
+
+      for (unsigned int e = 0; e < dim; ++e)
+        extent[e] = VectorizedArrayType(Number(phi.n_q_points)) / extent[e];
+
+      return extent;
+    }
+  } // namespace internal
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  TensorProductBlockJacobi<dim, Number, VectorizedArrayType>::initialize(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AdditionalData                               &additional_data)
+  {
+    this->matrix_free     = &matrix_free;
+    this->additional_data = additional_data;
+    n_blocks_total        = 0;
+    n_dofs_per_patch      = 0;
+    patch_dof_indices.clear();
+
+    const unsigned int dof_index  = additional_data.dof_index;
+    const unsigned int quad_index = additional_data.quad_index;
+    const bool         use_vertex_patches =
+      additional_data.patch_type == AdditionalData::PatchType::vertex_patch;
+
+    const FiniteElement<dim> &fe =
+      matrix_free.get_dof_handler(dof_index).get_fe();
+    const auto &shape_info = matrix_free.get_shape_info(dof_index, quad_index);
+    AssertThrow(fe.n_components() == 1, ExcNotImplemented());
+    AssertThrow(shape_info.element_type <=
+                  dealii::internal::MatrixFreeFunctions::
+                    tensor_symmetric_no_collocation,
+                ExcNotImplemented());
+
+    const bool is_dg = fe.n_dofs_per_vertex() == 0;
+    AssertThrow(is_dg == false || use_vertex_patches == false,
+                ExcMessage("Vertex patches are only implemented for "
+                           "continuous elements."));
+
+    const unsigned int fe_degree = shape_info.data[0].fe_degree;
+    const unsigned int n_dofs_1d = fe_degree + 1;
+    const unsigned int n_lanes   = VectorizedArrayType::size();
+
+    const std::pair<Table<2, Number>, Table<2, Number>> reference_matrices =
+      internal::compute_reference_1d_matrices<Number>(shape_info.data[0]);
+    const Table<2, Number> &mass_reference    = reference_matrices.first;
+    const Table<2, Number> &laplace_reference = reference_matrices.second;
+
+    // compute the extent of all cells from the inverse Jacobians
+    std::vector<std::array<VectorizedArrayType, dim>> batch_extents(
+      matrix_free.n_cell_batches());
+    std::map<CellId, std::array<Number, dim>> cell_extents;
+    {
+      FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType> phi(matrix_free,
+                                                                   dof_index,
+                                                                   quad_index);
+      for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+        {
+          phi.reinit(cell);
+          batch_extents[cell] = internal::compute_cell_extent(phi);
+          for (unsigned int v = 0;
+               v < matrix_free.n_active_entries_per_cell_batch(cell);
+               ++v)
+            {
+              std::array<Number, dim> extent;
+              for (unsigned int d = 0; d < dim; ++d)
+                extent[d] = batch_extents[cell][d][v];
+              cell_extents[matrix_free.get_cell_iterator(cell, v, dof_index)
+                             ->id()] = extent;
+            }
+        }
+    }
+
+    block_inverses = std::make_unique<
+      TensorProductMatrixSymmetricSumCollection<dim, VectorizedArrayType>>();
+
+    // the 1d matrices of a batch of blocks, where the mass term is split
+    // among the directions such that the sum of the Kronecker products of
+    // the derivative matrices with the mass matrices of the other directions
+    // gives the full operator
+    std::array<Table<2, VectorizedArrayType>, dim> mass_matrices;
+    std::array<Table<2, VectorizedArrayType>, dim> derivative_matrices;
+    const auto store_lane = [&](const unsigned int      d,
+                                const unsigned int      lane,
+                                const Table<2, Number> &mass_matrix,
+                                const Table<2, Number> &laplace_matrix) {
+      for (unsigned int i = 0; i < mass_matrix.n_rows(); ++i)
+        for (unsigned int j = 0; j < mass_matrix.n_cols(); ++j)
+          {
+            mass_matrices[d](i, j)[lane] = mass_matrix(i, j);
+            derivative_matrices[d](i, j)[lane] =
+              additional_data.laplace_factor * laplace_matrix(i, j) +
+              additional_data.mass_factor / Number(dim) * mass_matrix(i, j);
+          }
+    };
+    const auto reinit_matrices = [&](const unsigned int n) {
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          mass_matrices[d].reinit(n, n);
+          derivative_matrices[d].reinit(n, n);
+        }
+    };
+
+    if (use_vertex_patches == false)
+      {
+        // values and derivatives of the 1d shape functions at the two ends
+        // of the unit interval, needed for the face terms of DG elements
+        const auto &face_data = shape_info.data[0].shape_data_on_face;
+
+        block_inverses->reserve(matrix_free.n_cell_batches());
+        for (unsigned int cell = 0; cell < matrix_free.n_cell_batches();
+             ++cell)
+          {
+            reinit_matrices(n_dofs_1d);
+            for (unsigned int v = 0;
+                 v < matrix_free.n_active_entries_per_cell_batch(cell);
+                 ++v, ++n_blocks_total)
+              {
+                const auto cell_it =
+                  matrix_free.get_cell_iterator(cell, v, dof_index);
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    const Number h = batch_extents[cell][d][v];
+
+                    Table<2, Number> mass_matrix(n_dofs_1d, n_dofs_1d);
+                    Table<2, Number> laplace_matrix(n_dofs_1d, n_dofs_1d);
+                    for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                      for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                        {
+                          mass_matrix(i, j) = mass_reference(i, j) * h;
+                          laplace_matrix(i, j) = laplace_reference(i, j) / h;
+                        }
+
+                    for (unsigned int side = 0; side < 2; ++side)
+                      {
+                        const unsigned int face = 2 * d + side;
+                        const bool         at_boundary =
+                          cell_it->at_boundary(face) &&
+                          !cell_it->has_periodic_neighbor(face);
+                        const bool at_dirichlet_boundary =
+                          at_boundary &&
+                          additional_data.dirichlet_boundaries.find(
+                            cell_it->face(face)->boundary_id()) !=
+                            additional_data.dirichlet_boundaries.end();
+
+                        // use the extent of the neighbor if it is available
+                        // on this process and the extent of the present cell
+                        // otherwise
+                        Number h_neighbor = h;
+                        if (at_boundary == false)
+                          {
+                            const auto neighbor =
+                              cell_it->neighbor_or_periodic_neighbor(face);
+                            const auto entry =
+                              cell_extents.find(neighbor->id());
+                            if (entry != cell_extents.end())
+                              h_neighbor = entry->second[d];
+                          }
+
+                        if (is_dg)
+                          {
+                            // symmetric interior penalty terms, with the
+                            // derivative in normal direction given by the
+                            // derivative in the unit coordinate times
+                            // normal / h
+                            if (at_boundary && !at_dirichlet_boundary)
+                              continue;
+                            const Number normal = side == 0 ? -1. : 1.;
+                            const Number flux_factor =
+                              at_boundary ? Number(1.) : Number(0.5);
+                            const Number sigma =
+                              additional_data.penalty_factor *
+                              Number((fe_degree + 1) * (fe_degree + 1)) *
+                              (at_boundary ? Number(2.) / h :
+                                             Number(0.5) / h +
+                                               Number(0.5) / h_neighbor);
+                            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                              for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                                {
+                                  const Number value_i = face_data[side][i][0];
+                                  const Number value_j = face_data[side][j][0];
+                                  const Number derivative_i =
+                                    face_data[side][n_dofs_1d + i][0] *
+                                    normal / h;
+                                  const Number derivative_j =
+                                    face_data[side][n_dofs_1d + j][0] *
+                                    normal / h;
+                                  laplace_matrix(i, j) +=
+                                    -flux_factor * (derivative_i * value_j +
+                                                    value_i * derivative_j) +
+                                    sigma * value_i * value_j;
+                                }
+                          }
+                        else
+                          {
+                            // the unknown on the face is shared with the
+                            // neighbor, whose contribution enters the
+                            // diagonal entry; unknowns on Dirichlet
+                            // boundaries are removed from the block
+                            const unsigned int i =
+                              side == 0 ? 0 : n_dofs_1d - 1;
+                            if (at_dirichlet_boundary)
+                              for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                                {
+                                  mass_matrix(i, j)    = 0.;
+                                  mass_matrix(j, i)    = 0.;
+                                  laplace_matrix(i, j) = 0.;
+                                  laplace_matrix(j, i) = 0.;
+                                }
+                            else if (at_boundary == false)
+                              {
+                                const unsigned int i_neighbor =
+                                  n_dofs_1d - 1 - i;
+                                mass_matrix(i, i) +=
+                                  mass_reference(i_neighbor, i_neighbor) *
+                                  h_neighbor;
+                                laplace_matrix(i, i) +=
+                                  laplace_reference(i_neighbor, i_neighbor) /
+                                  h_neighbor;
+                              }
+                          }
+                      }
+
+                    store_lane(d, v, mass_matrix, laplace_matrix);
+                  }
+              }
+            block_inverses->insert(cell, mass_matrices, derivative_matrices);
+          }
+      }
+    else
+      {
+        // collect the cells around each vertex with their position within
+        // the patch, which is the complement of the vertex index within the
+        // cell for standard orientation
+        constexpr unsigned int n_cells_per_patch =
+          GeometryInfo<dim>::vertices_per_cell;
+        using CellIndex = std::pair<unsigned int, unsigned int>;
+        std::map<unsigned int, std::vector<std::pair<unsigned int, CellIndex>>>
+          vertex_to_cells;
+        for (unsigned int cell = 0; cell < matrix_free.n_cell_batches();
+             ++cell)
+          for (unsigned int v = 0;
+               v < matrix_free.n_active_entries_per_cell_batch(cell);
+               ++v)
+            {
+              const auto cell_it =
+                matrix_free.get_cell_iterator(cell, v, dof_index);
+              for (const unsigned int vertex : cell_it->vertex_indices())
+                vertex_to_cells[cell_it->vertex_index(vertex)].emplace_back(
+                  n_cells_per_patch - 1 - vertex, std::make_pair(cell, v));
+            }
+
+        // select the patches with 2^dim cells that are neighbors of each
+        // other in a standard orientation
+        std::vector<std::array<CellIndex, n_cells_per_patch>> patches;
+        for (const auto &entry : vertex_to_cells)
+          {
+            if (entry.second.size() != n_cells_per_patch)
+              continue;
+
+            std::array<CellIndex, n_cells_per_patch> patch;
+            std::bitset<n_cells_per_patch> found;
+            for (const auto &cell : entry.second)
+              {
+                found[cell.first] = true;
+                patch[cell.first] = cell.second;
+              }
+            if (found.all() == false)
+              continue;
+
+            bool is_regular = true;
+            for (unsigned int p = 0; p < n_cells_per_patch; ++p)
+              for (unsigned int d = 0; d < dim; ++d)
+                if ((p & (1U << d)) == 0)
+                  {
+                    const auto cell_it = matrix_free.get_cell_iterator(
+                      patch[p].first, patch[p].second, dof_index);
+                    const auto neighbor_it =
+                      matrix_free.get_cell_iterator(patch[p | (1U << d)].first,
+                                                    patch[p | (1U << d)].second,
+                                                    dof_index);
+                    if (cell_it->at_boundary(2 * d + 1) ||
+                        cell_it->neighbor(2 * d + 1)->id() != neighbor_it->id())
+                      is_regular = false;
+                  }
+            if (is_regular)
+              patches.push_back(patch);
+          }
+
+        n_blocks_total = patches.size();
+        const unsigned int n_batches = (patches.size() + n_lanes - 1) / n_lanes;
+
+        const unsigned int n_patch_dofs_1d = 2 * fe_degree - 1;
+        n_dofs_per_patch = Utilities::pow(n_patch_dofs_1d, dim);
+        patch_dof_indices.assign(n_batches * n_dofs_per_patch * n_lanes,
+                                 numbers::invalid_unsigned_int);
+
+        const auto &partitioner = matrix_free.get_vector_partitioner(dof_index);
+        const std::vector<unsigned int> &lexicographic_numbering =
+          shape_info.lexicographic_numbering;
+        std::vector<types::global_dof_index> dof_indices(
+          fe.n_dofs_per_cell());
+
+        block_inverses->reserve(n_batches);
+        for (unsigned int batch = 0; batch < n_batches; ++batch)
+          {
+            reinit_matrices(n_patch_dofs_1d);
+            for (unsigned int v = 0;
+                 v < n_lanes && batch * n_lanes + v < patches.size();
+                 ++v)
+              {
+                const auto &patch = patches[batch * n_lanes + v];
+
+                // indices of the unknowns in the interior of the patch
+                for (unsigned int p = 0; p < n_cells_per_patch; ++p)
+                  {
+                    const auto cell_it = matrix_free.get_cell_iterator(
+                      patch[p].first, patch[p].second, dof_index);
+                    if (matrix_free.get_mg_level() !=
+                        numbers::invalid_unsigned_int)
+                      cell_it->get_mg_dof_indices(dof_indices);
+                    else
+                      cell_it->get_dof_indices(dof_indices);
+
+                    for (unsigned int i = 0; i < dof_indices.size(); ++i)
+                      {
+                        unsigned int index_within_patch = 0;
+                        bool         is_interior        = true;
+                        for (unsigned int d = 0, stride = 1; d < dim;
+                             ++d, stride *= n_patch_dofs_1d)
+                          {
+                            const unsigned int index_1d =
+                              (i / Utilities::pow(n_dofs_1d, d)) % n_dofs_1d +
+                              ((p & (1U << d)) ? fe_degree : 0);
+                            if (index_1d == 0 || index_1d == 2 * fe_degree)
+                              is_interior = false;
+                            else
+                              index_within_patch += (index_1d - 1) * stride;
+                          }
+
+                        if (is_interior)
+                          {
+                            const types::global_dof_index global_index =
+                              dof_indices[lexicographic_numbering[i]];
+                            Assert(partitioner->in_local_range(global_index),
+                                   ExcInternalError());
+                            patch_dof_indices[(batch * n_dofs_per_patch +
+                                               index_within_patch) *
+                                                n_lanes +
+                                              v] =
+                              partitioner->global_to_local(global_index);
+                          }
+                      }
+                  }
+
+                // 1d matrices of the two cells in each direction, restricted
+                // to the interior unknowns, with the extents averaged over
+                // the cells on either side of the vertex
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    std::array<Number, 2> h = {{0., 0.}};
+                    for (unsigned int p = 0; p < n_cells_per_patch; ++p)
+                      h[(p >> d) & 1] +=
+                        batch_extents[patch[p].first][d][patch[p].second] /
+                        Number(n_cells_per_patch / 2);
+
+                    Table<2, Number> mass_matrix(n_patch_dofs_1d,
+                                                 n_patch_dofs_1d);
+                    Table<2, Number> laplace_matrix(n_patch_dofs_1d,
+                                                    n_patch_dofs_1d);
+                    for (unsigned int side = 0; side < 2; ++side)
+                      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                        for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                          {
+                            const unsigned int i_patch =
+                              i + side * fe_degree;
+                            const unsigned int j_patch =
+                              j + side * fe_degree;
+                            if (i_patch == 0 || j_patch == 0 ||
+                                i_patch == 2 * fe_degree ||
+                                j_patch == 2 * fe_degree)
+                              continue;
+                            mass_matrix(i_patch - 1, j_patch - 1) +=
+                              mass_reference(i, j) * h[side];
+                            laplace_matrix(i_patch - 1, j_patch - 1) +=
+                              laplace_reference(i, j) / h[side];
+                          }
+
+                    store_lane(d, v, mass_matrix, laplace_matrix);
+                  }
+              }
+            block_inverses->insert(batch, mass_matrices, derivative_matrices);
+          }
+      }
+
+    block_inverses->finalize();
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  TensorProductBlockJacobi<dim, Number, VectorizedArrayType>::vmult(
+    VectorType       &dst,
+    const VectorType &src) const
+  {
+    Assert(matrix_free != nullptr, ExcNotInitialized());
+
+    if (additional_data.patch_type == AdditionalData::PatchType::cell)
+      {
+        matrix_free->template cell_loop<VectorType, VectorType>(
+          [&](const auto &matrix_free,
+              auto       &dst,
+              const auto &src,
+              const auto &cell_range) {
+            FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType> phi(
+              matrix_free,
+              additional_data.dof_index,
+              additional_data.quad_index);
+            AlignedVector<VectorizedArrayType> result(phi.dofs_per_cell);
+            for (unsigned int cell = cell_range.first;
+                 cell < cell_range.second;
+                 ++cell)
+              {
+                phi.reinit(cell);
+                phi.read_dof_values(src);
+                block_inverses->apply_inverse(
+                  cell,
+                  make_array_view(result.begin(), result.end()),
+                  ArrayView<const VectorizedArrayType>(phi.begin_dof_values(),
+                                                       phi.dofs_per_cell));
+                std::copy(result.begin(),
+                          result.end(),
+                          phi.begin_dof_values());
+                phi.distribute_local_to_global(dst);
+              }
+          },
+          dst,
+          src,
+          true);
+      }
+    else
+      {
+        const unsigned int n_lanes = VectorizedArrayType::size();
+        const unsigned int n_batches =
+          patch_dof_indices.size() / (n_dofs_per_patch * n_lanes);
+
+        dst = Number();
+        AlignedVector<VectorizedArrayType> src_patch(n_dofs_per_patch);
+        AlignedVector<VectorizedArrayType> dst_patch(n_dofs_per_patch);
+        for (unsigned int batch = 0; batch < n_batches; ++batch)
+          {
+            const unsigned int *indices =
+              patch_dof_indices.data() + batch * n_dofs_per_patch * n_lanes;
+            for (unsigned int i = 0; i < n_dofs_per_patch; ++i)
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                src_patch[i][v] =
+                  indices[i * n_lanes + v] != numbers::invalid_unsigned_int ?
+                    src.local_element(indices[i * n_lanes + v]) :
+                    Number();
+
+            block_inverses->apply_inverse(
+              batch,
+              make_array_view(dst_patch.begin(), dst_patch.end()),
+              make_array_view(src_patch.begin(), src_patch.end()));
+
+            for (unsigned int i = 0; i < n_dofs_per_patch; ++i)
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                if (indices[i * n_lanes + v] != numbers::invalid_unsigned_int)
+                  dst.local_element(indices[i * n_lanes + v]) +=
+                    dst_patch[i][v];
+          }
+      }
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  unsigned int
+  TensorProductBlockJacobi<dim, Number, VectorizedArrayType>::n_blocks() const
+  {
+    return n_blocks_total;
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  std::size_t
+  TensorProductBlockJacobi<dim, Number, VectorizedArrayType>::
+    memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(patch_dof_indices) +
+           (block_inverses ? block_inverses->memory_consumption() : 0);
+  }
+
 #endif // DOXYGEN
 
 } // namespace MatrixFreeTools
@@ -57,6 +57,12 @@ namespace internal
               return {ReferenceCells::get_simplex<dim>(),
                       dealii::hp::QCollection<dim - 1>(
                         QWitherdenVincentSimplex<dim - 1>(i))};
+
+          for (unsigned int i = 1; i <= 10; ++i)
+            if (quad == QGaussCollapsedSimplex<dim>(i))
+              return {ReferenceCells::get_simplex<dim>(),
+                      dealii::hp::QCollection<dim - 1>(
+                        QGaussCollapsedSimplex<dim - 1>(i))};
         }
 
       if (dim == 3)
@@ -139,6 +145,17 @@ namespace internal
                   return {Quadrature<dim - 1>(),
                           QWitherdenVincentSimplex<dim - 1>(i)};
               }
+
+          for (unsigned int i = 1; i <= 10; ++i)
+            if (quad == QGaussCollapsedSimplex<dim>(i))
+              {
+                if (dim == 2)
+                  return {QGaussCollapsedSimplex<dim - 1>(i), // line!
+                          Quadrature<dim - 1>()};
+                else
+                  return {Quadrature<dim - 1>(),
+                          QGaussCollapsedSimplex<dim - 1>(i)};
+              }
         }
 
       if (dim == 3)
@@ -138,6 +138,23 @@ namespace internal
 
         virtual void
         reset_ghost_values(const ArrayView<float> &ghost_array) const = 0;
+
+        /**
+         * Wait for the ghost data from the next process of an update started
+         * by export_to_ghosted_array_start() and return the index of that
+         * process within Utilities::MPI::Partitioner::ghost_targets(). The
+         * data of that process is then in its place in the ghost array if
+         * the ghost indices of the exchange are not a subset of a larger
+         * set. Returns numbers::invalid_unsigned_int once all data has
+         * arrived or if the implementation cannot wait for individual
+         * processes. In both cases, export_to_ghosted_array_finish() must be
+         * called to complete the update.
+         *
+         * The default implementation does not wait for anything.
+         */
+        virtual unsigned int
+        export_to_ghosted_array_finish_any(
+          std::vector<MPI_Request> &requests) const;
       };
 
 
@@ -244,6 +261,10 @@ namespace internal
         void
         reset_ghost_values(const ArrayView<float> &ghost_array) const override;
 
+        unsigned int
+        export_to_ghosted_array_finish_any(
+          std::vector<MPI_Request> &requests) const override;
+
       private:
         template <typename Number>
         void
@@ -16,6 +16,7 @@
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/lac/exceptions.h>
 
@@ -181,6 +182,88 @@ IndexSet::do_compress() const
 
 
 
+namespace
+{
+  /**
+   * The number of intervals of an index set below which operator& does all
+   * of its work on the current thread.
+   */
+  constexpr std::size_t n_ranges_per_task = 4096;
+
+
+
+  /**
+   * Return an iterator to the first range in <tt>[it, end)</tt> whose end is
+   * larger than @p index, where the ranges are sorted and disjoint as in a
+   * compressed IndexSet. We first step through the ranges following @p it
+   * with exponentially growing step size and then do a binary search in the
+   * last step, so that skipping over $k$ ranges costs $O(\log k)$ operations
+   * rather than the $O(k)$ of a linear search. This is what makes operations
+   * between a set with few and a set with many intervals cheap.
+   */
+  template <typename Iterator>
+  Iterator
+  first_range_ending_after(Iterator                  it,
+                           const Iterator            end,
+                           const IndexSet::size_type index)
+  {
+    if (it == end || it->end > index)
+      return it;
+
+    std::ptrdiff_t step = 1;
+    while (step < end - it && (it + step)->end <= index)
+      {
+        it += step;
+        step *= 2;
+      }
+    const Iterator last = (step < end - it) ? it + step + 1 : end;
+    return std::partition_point(it + 1, last, [index](const auto &range) {
+      return range.end <= index;
+    });
+  }
+
+
+
+  /**
+   * Append the intersection of the sorted and disjoint ranges in
+   * <tt>[r1, end1)</tt> and <tt>[r2, end2)</tt> to @p result.
+   */
+  template <typename Iterator, typename RangeVector>
+  void
+  intersect_ranges(Iterator       r1,
+                   const Iterator end1,
+                   Iterator       r2,
+                   const Iterator end2,
+                   RangeVector   &result)
+  {
+    while ((r1 != end1) && (r2 != end2))
+      {
+        // if r1 and r2 do not overlap at all, then move the pointer that sits
+        // to the left of the other up to the first range that might overlap
+        if (r1->end <= r2->begin)
+          r1 = first_range_ending_after(r1, end1, r2->begin);
+        else if (r2->end <= r1->begin)
+          r2 = first_range_ending_after(r2, end2, r1->begin);
+        else
+          {
+            // add the overlapping range to the result
+            result.emplace_back(std::max(r1->begin, r2->begin),
+                                std::min(r1->end, r2->end));
+
+            // now move that iterator that ends earlier one up. note that it
+            // has to be this one because a subsequent range may still have a
+            // chance of overlapping with the range that ends later
+            if (r1->end <= r2->end)
+              ++r1;
+            else
+              ++r2;
+          }
+      }
+  }
+} // namespace
+
+
+
 #ifndef DOXYGEN
 IndexSet
 IndexSet::operator&(const IndexSet &is) const
@@ -190,39 +273,60 @@ IndexSet::operator&(const IndexSet &is) const
   compress();
   is.compress();
 
-  std::vector<Range>::const_iterator r1 = ranges.begin(),
-                                     r2 = is.ranges.begin();
+  // the intersection is symmetric, so we can walk through the set with fewer
+  // ranges and skip over the ranges of the other one with a logarithmic
+  // search
+  const std::vector<Range> &few_ranges =
+    (ranges.size() <= is.ranges.size()) ? ranges : is.ranges;
+  const std::vector<Range> &many_ranges =
+    (ranges.size() <= is.ranges.size()) ? is.ranges : ranges;
+
   IndexSet result(size());
 
-  while ((r1 != ranges.end()) && (r2 != is.ranges.end()))
+  if (few_ranges.size() < 2 * n_ranges_per_task)
+    intersect_ranges(few_ranges.begin(),
+                     few_ranges.end(),
+                     many_ranges.begin(),
+                     many_ranges.end(),
+                     result.ranges);
+  else
     {
-      // if r1 and r2 do not overlap at all, then move the pointer that sits
-      // to the left of the other up by one
-      if (r1->end <= r2->begin)
-        ++r1;
-      else if (r2->end <= r1->begin)
-        ++r2;
-      else
-        {
-          // the ranges must overlap somehow
-          Assert(((r1->begin <= r2->begin) && (r1->end > r2->begin)) ||
-                   ((r2->begin <= r1->begin) && (r2->end > r1->begin)),
-                 ExcInternalError());
-
-          // add the overlapping range to the result
-          result.add_range(std::max(r1->begin, r2->begin),
-                           std::min(r1->end, r2->end));
-
-          // now move that iterator that ends earlier one up. note that it has
-          // to be this one because a subsequent range may still have a chance
-          // of overlapping with the range that ends later
-          if (r1->end <= r2->end)
-            ++r1;
-          else
-            ++r2;
-        }
+      // split the ranges of the smaller set into chunks that are intersected
+      // with the other set independently. since the chunks are sorted, the
+      // results of the chunks can then simply be concatenated
+      const std::size_t n_chunks =
+        (few_ranges.size() + n_ranges_per_task - 1) / n_ranges_per_task;
+      std::vector<std::vector<Range>> chunk_ranges(n_chunks);
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        n_chunks,
+        [&](const std::size_t begin_chunk, const std::size_t end_chunk) {
+          for (std::size_t chunk = begin_chunk; chunk < end_chunk; ++chunk)
+            {
+              const auto begin = few_ranges.begin() + chunk * n_ranges_per_task;
+              const auto end =
+                few_ranges.begin() +
+                std::min(few_ranges.size(), (chunk + 1) * n_ranges_per_task);
+              intersect_ranges(begin,
+                               end,
+                               first_range_ending_after(many_ranges.begin(),
+                                                        many_ranges.end(),
+                                                        begin->begin),
+                               many_ranges.end(),
+                               chunk_ranges[chunk]);
+            }
+        },
+        1);
+
+      std::size_t n_result_ranges = 0;
+      for (const auto &chunk : chunk_ranges)
+        n_result_ranges += chunk.size();
+      result.ranges.reserve(n_result_ranges);
+      for (const auto &chunk : chunk_ranges)
+        result.ranges.insert(result.ranges.end(), chunk.begin(), chunk.end());
     }
 
+  result.is_compressed = false;
   result.compress();
   return result;
 }
@@ -289,65 +393,44 @@ IndexSet::subtract_set(const IndexSet &other)
 {
   compress();
   other.compress();
-  is_compressed = false;
-
 
-  // we save all new ranges to our IndexSet in an temporary vector and
-  // add all of them in one go at the end.
+  // we save all new ranges to our IndexSet in a temporary vector. since both
+  // sets are sorted and disjoint, so are the new ranges and we can simply
+  // swap them in at the end.
   std::vector<Range> new_ranges;
+  new_ranges.reserve(ranges.size());
 
-  std::vector<Range>::iterator own_it   = ranges.begin();
-  std::vector<Range>::iterator other_it = other.ranges.begin();
-
-  while (own_it != ranges.end() && other_it != other.ranges.end())
+  std::vector<Range>::const_iterator other_it = other.ranges.cbegin();
+  for (const Range &own_range : ranges)
     {
-      // advance own iterator until we get an overlap
-      if (own_it->end <= other_it->begin)
-        {
-          new_ranges.push_back(*own_it);
-          ++own_it;
-          continue;
-        }
-      // we are done with other_it, so advance
-      if (own_it->begin >= other_it->end)
+      // skip over all ranges of 'other' that end before the current range
+      other_it = first_range_ending_after(other_it,
+                                          other.ranges.cend(),
+                                          own_range.begin);
+
+      // now cut out the ranges of 'other' that overlap with the current range
+      // and save the parts in between. a range of 'other' that extends beyond
+      // the end of the current range may also overlap with the next one, so
+      // do not advance past it
+      size_type begin = own_range.begin;
+      while (other_it != other.ranges.cend() && other_it->begin < own_range.end)
         {
+          if (begin < other_it->begin)
+            new_ranges.emplace_back(begin, other_it->begin);
+          begin = std::max(begin, other_it->end);
+          if (other_it->end > own_range.end)
+            break;
           ++other_it;
-          continue;
         }
 
-      // Now own_it and other_it overlap.  First save the part of own_it that
-      // is before other_it (if not empty).
-      if (own_it->begin < other_it->begin)
-        {
-          Range r(own_it->begin, other_it->begin);
-          r.nth_index_in_set = 0; // fix warning of unused variable
-          new_ranges.push_back(r);
-        }
-      // change own_it to the sub range behind other_it. Do not delete own_it
-      // in any case. As removal would invalidate iterators, we just shrink
-      // the range to an empty one.
-      own_it->begin = other_it->end;
-      if (own_it->begin > own_it->end)
-        {
-          own_it->begin = own_it->end;
-          ++own_it;
-        }
-
-      // continue without advancing iterators, the right one will be advanced
-      // next.
+      // make sure to take over the remaining part of the range
+      if (begin < own_range.end)
+        new_ranges.emplace_back(begin, own_range.end);
     }
 
-  // make sure to take over the remaining ranges
-  for (; own_it != ranges.end(); ++own_it)
-    new_ranges.push_back(*own_it);
-
-  ranges.clear();
-
-  // done, now add the temporary ranges
-  const std::vector<Range>::iterator end = new_ranges.end();
-  for (std::vector<Range>::iterator it = new_ranges.begin(); it != end; ++it)
-    add_range(it->begin, it->end);
+  ranges.swap(new_ranges);
 
+  is_compressed = false;
   compress();
 }
 
@@ -413,21 +413,38 @@ namespace Utilities
           n_ghost_indices_in_larger_set = larger_ghost_index_set.n_elements();
 
           // first translate tight ghost indices into indices within the large
-          // set:
+          // set. since the larger set contains all indices of the tight set,
+          // each interval of the tight set is also contiguous within the
+          // larger set, and we only need to look up the first index of each
+          // interval (in debug mode, we check the last index of the interval
+          // as well)
           std::vector<unsigned int> expanded_numbering;
-          for (const dealii::IndexSet::size_type index : ghost_indices_data)
+          expanded_numbering.reserve(n_ghost_indices_data);
+          for (auto interval = ghost_indices_data.begin_intervals();
+               interval != ghost_indices_data.end_intervals();
+               ++interval)
             {
-              Assert(larger_ghost_index_set.is_element(index),
+              Assert(larger_ghost_index_set.is_element(*interval->begin()),
+                     ExcMessage("The given larger ghost index set must contain "
+                                "all indices in the actual index set."));
+              const types::global_dof_index first_index =
+                larger_ghost_index_set.index_within_set(*interval->begin());
+              Assert(larger_ghost_index_set.is_element(interval->last()),
                      ExcMessage("The given larger ghost index set must contain "
                                 "all indices in the actual index set."));
+              Assert(larger_ghost_index_set.index_within_set(interval->last()) -
+                         first_index ==
+                       interval->n_elements() - 1,
+                     ExcMessage("The intervals of the ghost index set must be "
+                                "contiguous in the larger ghost index set."));
               Assert(
-                larger_ghost_index_set.index_within_set(index) <
+                first_index + interval->n_elements() <=
                   static_cast<types::global_dof_index>(
                     std::numeric_limits<unsigned int>::max()),
                 ExcMessage(
                   "Index overflow: This class supports at most 2^32-1 ghost elements"));
-              expanded_numbering.push_back(
-                larger_ghost_index_set.index_within_set(index));
+              for (unsigned int i = 0; i < interval->n_elements(); ++i)
+                expanded_numbering.push_back(first_index + i);
             }
 
           // now rework expanded_numbering into ranges and store in:
@@ -2351,6 +2351,46 @@ QIteratedSimplex<dim>::QIteratedSimplex(const Quadrature<dim> &base_quad,
 
 
 
+template <int dim>
+QGaussCollapsedSimplex<dim>::QGaussCollapsedSimplex(
+  const unsigned int n_points_1D)
+  : QSimplex<dim>(Quadrature<dim>())
+{
+  Assert(dim > 0 && dim <= 3, ExcNotImplemented());
+
+  const QGauss<1>    quad_line(n_points_1D);
+  const unsigned int n = quad_line.size();
+
+  this->quadrature_points.reserve(Utilities::pow(n, dim));
+  this->weights.reserve(Utilities::pow(n, dim));
+  for (unsigned int k = 0; k < (dim > 2 ? n : 1); ++k)
+    for (unsigned int j = 0; j < (dim > 1 ? n : 1); ++j)
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          const double xi   = quad_line.point(i)[0];
+          const double eta  = dim > 1 ? quad_line.point(j)[0] : 0.;
+          const double zeta = dim > 2 ? quad_line.point(k)[0] : 0.;
+
+          Point<dim> point;
+          double     weight = quad_line.weight(i);
+          point[0]          = xi * (1. - eta) * (1. - zeta);
+          if (dim > 1)
+            {
+              point[1] = eta * (1. - zeta);
+              weight *= quad_line.weight(j) * (1. - eta);
+            }
+          if (dim > 2)
+            {
+              point[2] = zeta;
+              weight *= quad_line.weight(k) * (1. - zeta) * (1. - zeta);
+            }
+          this->quadrature_points.push_back(point);
+          this->weights.push_back(weight);
+        }
+}
+
+
+
 template <int dim>
 QGaussWedge<dim>::QGaussWedge(const unsigned int n_points)
   : Quadrature<dim>()
@@ -2476,6 +2516,9 @@ template class QGaussSimplex<0>;
 template class QGaussSimplex<1>;
 template class QGaussSimplex<2>;
 template class QGaussSimplex<3>;
+template class QGaussCollapsedSimplex<1>;
+template class QGaussCollapsedSimplex<2>;
+template class QGaussCollapsedSimplex<3>;
 template class QGaussWedge<0>;
 template class QGaussWedge<1>;
 template class QGaussWedge<2>;
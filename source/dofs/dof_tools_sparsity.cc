@@ -13,6 +13,8 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -40,6 +42,7 @@
 #include <deal.II/hp/q_collection.h>
 
 #include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern_base.h>
 #include <deal.II/lac/vector.h>
 
@@ -52,6 +55,193 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace DoFTools
 {
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * Return the position of @p row within the rows stored by @p sparsity,
+       * or numbers::invalid_dof_index if the row is not stored.
+       */
+      types::global_dof_index
+      local_row_index(const DynamicSparsityPattern &sparsity,
+                      const types::global_dof_index row)
+      {
+        const IndexSet &stored_rows = sparsity.row_index_set();
+        if (stored_rows.size() == 0)
+          return row;
+        else if (stored_rows.is_element(row))
+          return stored_rows.index_within_set(row);
+        else
+          return numbers::invalid_dof_index;
+      }
+
+
+
+      /**
+       * A sparsity pattern that passes all rows whose position within the
+       * rows stored by a DynamicSparsityPattern lies in the range
+       * <tt>[begin,end)</tt> on to that object, and drops all other rows.
+       * Several objects of this type with disjoint ranges can be used by
+       * different threads to fill the same DynamicSparsityPattern without
+       * any synchronization.
+       */
+      class RowRangeSparsityPattern : public SparsityPatternBase
+      {
+      public:
+        RowRangeSparsityPattern(DynamicSparsityPattern       &sparsity,
+                                const types::global_dof_index begin,
+                                const types::global_dof_index end)
+          : SparsityPatternBase(sparsity.n_rows(), sparsity.n_cols())
+          , sparsity(sparsity)
+          , begin(begin)
+          , end(end)
+        {}
+
+        virtual void
+        add_row_entries(const size_type                  &row,
+                        const ArrayView<const size_type> &columns,
+                        const bool indices_are_sorted) override
+        {
+          const types::global_dof_index index = local_row_index(sparsity, row);
+          if (index >= begin && index < end)
+            sparsity.add_row_entries(row, columns, indices_are_sorted);
+        }
+
+      private:
+        DynamicSparsityPattern       &sparsity;
+        const types::global_dof_index begin;
+        const types::global_dof_index end;
+      };
+
+
+
+      /**
+       * Add the entries of the given cells to a DynamicSparsityPattern with
+       * several threads. The stored rows of the sparsity pattern are split
+       * into contiguous ranges ("buckets"), each of which is filled by a
+       * single task. In a first step, the cells are sorted into the buckets
+       * of the rows they touch, which are the rows of the degrees of freedom
+       * on the cell and of the degrees of freedom they are constrained to.
+       * This step works on chunks of cells in parallel with separate lists
+       * for each chunk. In a second step, each task runs over the cells
+       * collected for its bucket and adds the entries of the rows of that
+       * bucket only. As the rows are stored independently of each other,
+       * no locking is necessary. Since the degrees of freedom are typically
+       * enumerated cell by cell, most cells only touch a single bucket.
+       */
+      template <int dim, int spacedim, typename number>
+      void
+      make_sparsity_pattern_in_parallel(
+        const std::vector<
+          typename DoFHandler<dim, spacedim>::active_cell_iterator> &cells,
+        DynamicSparsityPattern                                     &sparsity,
+        const AffineConstraints<number> &constraints,
+        const bool                       keep_constrained_dofs)
+      {
+        const types::global_dof_index n_stored_rows =
+          sparsity.row_index_set().size() == 0 ?
+            sparsity.n_rows() :
+            sparsity.row_index_set().n_elements();
+        const unsigned int n_buckets = std::min<types::global_dof_index>(
+          4 * MultithreadInfo::n_threads(),
+          n_stored_rows /
+            dealii::internal::SparseMatrixImplementation::
+              minimum_parallel_grain_size);
+        const unsigned int n_cells = cells.size();
+
+        if (n_buckets < 2 || n_cells < n_buckets)
+          {
+            std::vector<types::global_dof_index> dof_indices;
+            for (const auto &cell : cells)
+              {
+                dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+                cell->get_dof_indices(dof_indices);
+                constraints.add_entries_local_to_global(dof_indices,
+                                                        sparsity,
+                                                        keep_constrained_dofs);
+              }
+            return;
+          }
+
+        const types::global_dof_index bucket_size =
+          (n_stored_rows + n_buckets - 1) / n_buckets;
+
+        // step 1: sort the cells into the buckets, with one list per bucket
+        // and chunk of cells
+        const unsigned int n_chunks = n_buckets;
+        std::vector<std::vector<std::vector<unsigned int>>> cells_in_bucket(
+          n_chunks, std::vector<std::vector<unsigned int>>(n_buckets));
+        parallel::apply_to_subranges(
+          0U,
+          n_chunks,
+          [&](const unsigned int begin_chunk, const unsigned int end_chunk) {
+            std::vector<types::global_dof_index> dof_indices;
+            std::vector<unsigned int>            buckets;
+            const auto add_bucket = [&](const types::global_dof_index row) {
+              const types::global_dof_index index =
+                local_row_index(sparsity, row);
+              if (index != numbers::invalid_dof_index)
+                buckets.push_back(index / bucket_size);
+            };
+
+            for (unsigned int chunk = begin_chunk; chunk < end_chunk; ++chunk)
+              for (unsigned int c = std::size_t(n_cells) * chunk / n_chunks;
+                   c < std::size_t(n_cells) * (chunk + 1) / n_chunks;
+                   ++c)
+                {
+                  dof_indices.resize(cells[c]->get_fe().n_dofs_per_cell());
+                  cells[c]->get_dof_indices(dof_indices);
+
+                  buckets.clear();
+                  for (const types::global_dof_index dof : dof_indices)
+                    {
+                      add_bucket(dof);
+                      if (const auto *entries =
+                            constraints.get_constraint_entries(dof))
+                        for (const auto &entry : *entries)
+                          add_bucket(entry.first);
+                    }
+                  std::sort(buckets.begin(), buckets.end());
+                  buckets.erase(std::unique(buckets.begin(), buckets.end()),
+                                buckets.end());
+
+                  for (const unsigned int bucket : buckets)
+                    cells_in_bucket[chunk][bucket].push_back(c);
+                }
+          },
+          1);
+
+        // step 2: fill the rows of each bucket
+        parallel::apply_to_subranges(
+          0U,
+          n_buckets,
+          [&](const unsigned int begin_bucket, const unsigned int end_bucket) {
+            std::vector<types::global_dof_index> dof_indices;
+            for (unsigned int bucket = begin_bucket; bucket < end_bucket;
+                 ++bucket)
+              {
+                RowRangeSparsityPattern bucket_sparsity(
+                  sparsity,
+                  bucket * bucket_size,
+                  std::min(n_stored_rows, (bucket + 1) * bucket_size));
+                for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+                  for (const unsigned int c : cells_in_bucket[chunk][bucket])
+                    {
+                      dof_indices.resize(cells[c]->get_fe().n_dofs_per_cell());
+                      cells[c]->get_dof_indices(dof_indices);
+                      constraints.add_entries_local_to_global(
+                        dof_indices, bucket_sparsity, keep_constrained_dofs);
+                    }
+              }
+          },
+          1);
+      }
+    } // namespace
+  }   // namespace internal
+
+
+
   template <int dim, int spacedim, typename number>
   void
   make_sparsity_pattern(const DoFHandler<dim, spacedim> &dof,
@@ -83,6 +273,24 @@ namespace DoFTools
                  "locally owned one does not make sense."));
       }
 
+    // The rows of a DynamicSparsityPattern can be filled by several threads
+    // concurrently, see the helper function above.
+    if (auto *dsp = dynamic_cast<DynamicSparsityPattern *>(&sparsity);
+        dsp != nullptr && MultithreadInfo::n_threads() > 1)
+      {
+        std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+          cells;
+        for (const auto &cell : dof.active_cell_iterators())
+          if (((subdomain_id == numbers::invalid_subdomain_id) ||
+               (subdomain_id == cell->subdomain_id())) &&
+              cell->is_locally_owned())
+            cells.push_back(cell);
+
+        internal::make_sparsity_pattern_in_parallel<dim, spacedim>(
+          cells, *dsp, constraints, keep_constrained_dofs);
+        return;
+      }
+
     std::vector<types::global_dof_index> dofs_on_this_cell;
     dofs_on_this_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
 
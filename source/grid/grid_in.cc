@@ -15,6 +15,7 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/patterns.h>
 #include <deal.II/base/utilities.h>
@@ -132,6 +133,160 @@ namespace
     if (is_only_hypercube)
       GridTools::consistently_order_cells(cells);
   }
+
+
+
+  /**
+   * A map from the node tags of a gmsh file to the indices of the vertices.
+   * Gmsh usually numbers the nodes consecutively in the order in which they
+   * appear in the file, in which case only the first tag is stored. Otherwise,
+   * the map is stored as a vector indexed by the tag relative to the
+   * smallest tag, which makes the lookups for the cells much cheaper than
+   * with a std::map. Only if the tags are spread out too much, a std::map is
+   * used instead.
+   */
+  class GmshNodeTagMap
+  {
+  public:
+    /**
+     * Add the node with the given tag as the next vertex. If a tag appears
+     * more than once, the last vertex is used.
+     */
+    void
+    push_back(const std::int64_t tag)
+    {
+      if (n_vertices == 0)
+        first_tag = tag;
+      if (tags.empty() && tag != first_tag + n_vertices)
+        {
+          // the tags are not consecutive, so we need to store all of them
+          tags.resize(n_vertices);
+          for (unsigned int i = 0; i < n_vertices; ++i)
+            tags[i] = first_tag + i;
+        }
+      if (tags.empty() == false)
+        tags.push_back(tag);
+      ++n_vertices;
+    }
+
+    /**
+     * Set up the data structures for the lookup of the tags, to be called
+     * after all nodes have been added.
+     */
+    void
+    compress()
+    {
+      dense_indices.clear();
+      sparse_indices.clear();
+      if (tags.empty())
+        return;
+
+      const auto [min, max]    = std::minmax_element(tags.begin(), tags.end());
+      first_tag                = *min;
+      const std::int64_t range = *max - first_tag + 1;
+      if (range <= 2 * std::int64_t(tags.size()) + 1024)
+        {
+          dense_indices.resize(range, numbers::invalid_unsigned_int);
+          for (unsigned int i = 0; i < tags.size(); ++i)
+            dense_indices[tags[i] - first_tag] = i;
+        }
+      else
+        for (unsigned int i = 0; i < tags.size(); ++i)
+          sparse_indices[tags[i]] = i;
+
+      std::vector<std::int64_t>().swap(tags);
+    }
+
+    /**
+     * Return the index of the vertex with the given tag, or
+     * numbers::invalid_unsigned_int if there is no such node.
+     */
+    unsigned int
+    operator[](const std::int64_t tag) const
+    {
+      if (dense_indices.empty() && sparse_indices.empty())
+        {
+          const std::int64_t offset = tag - first_tag;
+          return (offset >= 0 && offset < std::int64_t(n_vertices)) ?
+                   offset :
+                   numbers::invalid_unsigned_int;
+        }
+      else if (dense_indices.empty() == false)
+        {
+          const std::int64_t offset = tag - first_tag;
+          return (offset >= 0 &&
+                  offset < static_cast<std::int64_t>(dense_indices.size())) ?
+                   dense_indices[offset] :
+                   numbers::invalid_unsigned_int;
+        }
+
+      const auto it = sparse_indices.find(tag);
+      return it != sparse_indices.end() ? it->second :
+                                          numbers::invalid_unsigned_int;
+    }
+
+  private:
+    unsigned int                         n_vertices = 0;
+    std::int64_t                         first_tag  = 0;
+    std::vector<std::int64_t>            tags;
+    std::vector<unsigned int>            dense_indices;
+    std::map<std::int64_t, unsigned int> sparse_indices;
+  };
+
+
+
+  /**
+   * Read the number of the node (if @p has_tag is true) and the three
+   * coordinates from a line of the $Nodes section of a gmsh file. Further
+   * numbers on the line, i.e., parametric coordinates, are ignored.
+   */
+  void
+  parse_gmsh_node_line(const std::string     &line,
+                       const bool             has_tag,
+                       int                   &tag,
+                       std::array<double, 3> &coordinates)
+  {
+    const char *position = line.c_str();
+    char       *end      = nullptr;
+    if (has_tag)
+      {
+        tag = std::strtol(position, &end, 10);
+        AssertThrow(end != position, ExcMessage("Invalid gmsh input: " + line));
+        position = end;
+      }
+    for (double &x : coordinates)
+      {
+        x = std::strtod(position, &end);
+        AssertThrow(end != position, ExcMessage("Invalid gmsh input: " + line));
+        position = end;
+      }
+  }
+
+
+
+  /**
+   * Convert all integers on a line of the $Elements section of a gmsh file,
+   * which describes one element, to numbers.
+   */
+  void
+  parse_gmsh_element_line(const std::string         &line,
+                          std::vector<std::int64_t> &numbers)
+  {
+    numbers.clear();
+    const char *position = line.c_str();
+    char       *end      = nullptr;
+    while (true)
+      {
+        const std::int64_t number = std::strtoll(position, &end, 10);
+        if (end == position)
+          break;
+        numbers.push_back(number);
+        position = end;
+      }
+    AssertThrow(line.find_first_not_of(" \t\r", position - line.c_str()) ==
+                  std::string::npos,
+                ExcMessage("Invalid gmsh input: " + line));
+  }
 } // namespace
 
 template <int dim, int spacedim>
@@ -2004,14 +2159,20 @@ GridIn<dim, spacedim>::read_comsol_mphtxt(std::istream &in)
 
 template <int dim, int spacedim>
 void
-GridIn<dim, spacedim>::read_msh(std::istream &in)
+GridIn<dim, spacedim>::read_msh_data(
+  std::istream                               &in,
+  const unsigned int                          slice,
+  const unsigned int                          n_slices,
+  std::vector<Point<spacedim>>               &vertices,
+  std::vector<CellData<dim>>                 &cells,
+  SubCellData                                &subcelldata,
+  std::map<unsigned int, types::boundary_id> &boundary_ids_1d,
+  std::map<unsigned int, unsigned int>       &vertex_counts)
 {
-  Assert(tria != nullptr, ExcNoTriangulationSelected());
   AssertThrow(in.fail() == false, ExcIO());
 
   unsigned int n_vertices;
   unsigned int n_cells;
-  unsigned int dummy;
   std::string  line;
   // This array stores maps from the 'entities' to the 'physical tags' for
   // points, curves, surfaces and volumes. We use this information later to
@@ -2217,75 +2378,118 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
     }
   else
     in >> n_vertices;
-  std::vector<Point<spacedim>> vertices(n_vertices);
+
+  // the vertices of this slice
+  const unsigned int begin_vertex =
+    static_cast<std::uint64_t>(n_vertices) * slice / n_slices;
+  const unsigned int end_vertex =
+    static_cast<std::uint64_t>(n_vertices) * (slice + 1) / n_slices;
+  vertices.resize(end_vertex - begin_vertex);
+
   // set up mapping between numbering
   // in msh-file (nod) and in the
   // vertices vector
-  std::map<int, int> vertex_indices;
+  GmshNodeTagMap vertex_indices;
+
+  // converting the text to numbers is the expensive part of reading large
+  // files. we therefore read the lines of the nodes and of the elements
+  // (gmsh writes one of them per line) in chunks and convert the lines of
+  // each chunk in parallel
+  constexpr unsigned int   chunk_size = 65536;
+  std::vector<std::string> lines;
+  const auto               read_lines = [&](const unsigned int n_lines) {
+    if (lines.size() < n_lines)
+      lines.resize(n_lines);
+    // skip empty lines
+    for (unsigned int l = 0; l < n_lines; ++l)
+      do
+        std::getline(in, lines[l]);
+      while (in && lines[l].find_first_not_of(" \t\r") == std::string::npos);
+    AssertThrow(in.fail() == false, ExcIO());
+  };
 
   {
+    std::vector<int> chunk_tags;
+
     unsigned int global_vertex = 0;
     for (int entity_block = 0; entity_block < n_entity_blocks; ++entity_block)
       {
-        int           parametric;
         unsigned long numNodes;
 
         if (gmsh_file_format < 40)
-          {
-            numNodes   = n_vertices;
-            parametric = 0;
-          }
+          numNodes = n_vertices;
         else
           {
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
-            // but we are ignoring both anyway.
-            int tagEntity, dimEntity;
+            // but we are ignoring both anyway. the parametric coordinates
+            // are ignored below as well
+            int tagEntity, dimEntity, parametric;
             in >> tagEntity >> dimEntity >> parametric >> numNodes;
           }
 
-        std::vector<int> vertex_numbers;
-        int              vertex_number;
-        if (gmsh_file_format > 40)
-          for (unsigned long vertex_per_entity = 0;
-               vertex_per_entity < numNodes;
-               ++vertex_per_entity)
+        AssertThrow(global_vertex + numNodes <= n_vertices,
+                    ExcMessage("The number of nodes in the $Nodes section "
+                               "is larger than announced."));
+
+        // from version 4.1 on, the tags of the nodes of a block are given
+        // before their coordinates
+        const bool tags_in_lines = (gmsh_file_format <= 40);
+        if (!tags_in_lines)
+          for (unsigned long v = 0; v < numNodes; ++v)
             {
-              in >> vertex_number;
-              vertex_numbers.push_back(vertex_number);
+              int tag;
+              in >> tag;
+              vertex_indices.push_back(tag);
             }
 
-        for (unsigned long vertex_per_entity = 0; vertex_per_entity < numNodes;
-             ++vertex_per_entity, ++global_vertex)
-          {
-            int    vertex_number;
-            double x[3];
-
-            // read vertex
-            if (gmsh_file_format > 40)
-              {
-                vertex_number = vertex_numbers[vertex_per_entity];
-                in >> x[0] >> x[1] >> x[2];
-              }
-            else
-              in >> vertex_number >> x[0] >> x[1] >> x[2];
+        // skip the rest of the previous line
+        in >> std::ws;
 
-            for (unsigned int d = 0; d < spacedim; ++d)
-              vertices[global_vertex](d) = x[d];
-            // store mapping
-            vertex_indices[vertex_number] = global_vertex;
+        for (unsigned long first = 0; first < numNodes; first += chunk_size)
+          {
+            const unsigned int n_lines =
+              std::min<unsigned long>(chunk_size, numNodes - first);
+            read_lines(n_lines);
+
+            const unsigned int offset = global_vertex + first;
+            chunk_tags.resize(n_lines);
+            parallel::apply_to_subranges(
+              0U,
+              n_lines,
+              [&](const unsigned int begin, const unsigned int end) {
+                std::array<double, 3> x;
+                for (unsigned int l = begin; l < end; ++l)
+                  if (offset + l >= begin_vertex && offset + l < end_vertex)
+                    {
+                      parse_gmsh_node_line(lines[l],
+                                           tags_in_lines,
+                                           chunk_tags[l],
+                                           x);
+                      for (unsigned int d = 0; d < spacedim; ++d)
+                        vertices[offset + l - begin_vertex](d) = x[d];
+                    }
+                  else if (tags_in_lines)
+                    {
+                      // only the tag is needed for nodes outside the slice
+                      char *end = nullptr;
+                      chunk_tags[l] =
+                        std::strtol(lines[l].c_str(), &end, 10);
+                      AssertThrow(end != lines[l].c_str(),
+                                  ExcMessage("Invalid gmsh input: " +
+                                             lines[l]));
+                    }
+              },
+              512);
 
-            // ignore parametric coordinates
-            if (parametric != 0)
-              {
-                double u = 0.;
-                double v = 0.;
-                in >> u >> v;
-                (void)u;
-                (void)v;
-              }
+            if (tags_in_lines)
+              for (unsigned int l = 0; l < n_lines; ++l)
+                vertex_indices.push_back(chunk_tags[l]);
           }
+        global_vertex += numNodes;
       }
     AssertDimension(global_vertex, n_vertices);
+
+    vertex_indices.compress();
   }
 
   // Assert we reached the end of the block
@@ -2317,22 +2521,26 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       in >> n_cells;
     }
 
+  // the elements of this slice
+  const unsigned int begin_cell =
+    static_cast<std::uint64_t>(n_cells) * slice / n_slices;
+  const unsigned int end_cell =
+    static_cast<std::uint64_t>(n_cells) * (slice + 1) / n_slices;
+
   // set up array of cells and subcells (faces). In 1d, there is currently no
   // standard way in deal.II to pass boundary indicators attached to
-  // individual vertices, so do this by hand via the boundary_ids_1d array
-  std::vector<CellData<dim>>                 cells;
-  SubCellData                                subcelldata;
-  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
-
-  // Track the number of times each vertex is used in 1D. This determines
-  // whether or not we can assign a boundary id to a vertex. This is necessary
-  // because sometimes gmsh saves internal vertices in the $ELEM list in codim
-  // 1 or codim 2.
-  std::map<unsigned int, unsigned int> vertex_counts;
-
+  // individual vertices, so do this by hand via the boundary_ids_1d array.
+  // Track the number of times each vertex is used in 1D in vertex_counts.
+  // This determines whether or not we can assign a boundary id to a vertex.
+  // This is necessary because sometimes gmsh saves internal vertices in the
+  // $ELEM list in codim 1 or codim 2.
   {
     static constexpr std::array<unsigned int, 8> local_vertex_numbering = {
       {0, 1, 5, 4, 2, 3, 7, 6}};
+
+    // the numbers on the lines of the elements of a chunk
+    std::vector<std::vector<std::int64_t>> element_numbers;
+
     unsigned int global_cell = 0;
     for (int entity_block = 0; entity_block < n_entity_blocks; ++entity_block)
       {
@@ -2360,300 +2568,321 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             material_id = tag_maps[dimEntity][tagEntity];
           }
 
-        for (unsigned int cell_per_entity = 0; cell_per_entity < numElements;
-             ++cell_per_entity, ++global_cell)
+        // note that since in the input file we found the number of cells at
+        // the top, there should still be input here, so check this:
+        AssertThrow(in.fail() == false, ExcIO());
+        AssertThrow(global_cell + numElements <= n_cells,
+                    ExcMessage("The number of elements in the $Elements "
+                               "section is larger than announced."));
+
+        // skip the rest of the previous line
+        in >> std::ws;
+
+        for (unsigned long first = 0; first < numElements; first += chunk_size)
           {
-            // note that since in the input
-            // file we found the number of
-            // cells at the top, there
-            // should still be input here,
-            // so check this:
-            AssertThrow(in.fail() == false, ExcIO());
-
-            unsigned int nod_num;
-
-            /*
-              For file format version 1, the format of each cell is as
-              follows: elm-number elm-type reg-phys reg-elem number-of-nodes
-              node-number-list
-
-              However, for version 2, the format reads like this:
-                elm-number elm-type number-of-tags < tag > ...
-              node-number-list
-
-              For version 4, we have:
-                tag(int) numVert(int) ...
-
-              In the following, we will ignore the element number (we simply
-              enumerate them in the order in which we read them, and we will
-              take reg-phys (version 1) or the first tag (version 2, if any
-              tag is given at all) as material id. For version 4, we already
-              read the material and the cell type in above.
-            */
-
-            unsigned int elm_number = 0;
-            if (gmsh_file_format < 40)
+            const unsigned int n_lines =
+              std::min<unsigned long>(chunk_size, numElements - first);
+            read_lines(n_lines);
+
+            // the lines of the chunk that are part of the slice
+            const unsigned int offset = global_cell + first;
+            const unsigned int begin_line =
+              std::min(std::max(offset, begin_cell) - offset, n_lines);
+            const unsigned int end_line =
+              std::max(std::min(offset + n_lines, end_cell), offset) - offset;
+            if (begin_line >= end_line)
+              continue;
+
+            if (element_numbers.size() < n_lines)
+              element_numbers.resize(n_lines);
+            parallel::apply_to_subranges(
+              begin_line,
+              end_line,
+              [&](const unsigned int begin, const unsigned int end) {
+                for (unsigned int l = begin; l < end; ++l)
+                  parse_gmsh_element_line(lines[l], element_numbers[l]);
+              },
+              512);
+
+            for (unsigned int l = begin_line; l < end_line; ++l)
               {
-                in >> elm_number // ELM-NUMBER
-                  >> cell_type;  // ELM-TYPE
-              }
+                const unsigned int cell_per_entity = first + l;
+
+                const std::vector<std::int64_t> &numbers = element_numbers[l];
+                unsigned int                     position = 0;
+                const auto                       next     = [&]() {
+                  AssertThrow(position < numbers.size(),
+                              ExcInvalidGMSHInput(lines[l]));
+                  return numbers[position++];
+                };
+
+                unsigned int nod_num = 0;
+
+                /*
+                  For file format version 1, the format of each cell is as
+                  follows: elm-number elm-type reg-phys reg-elem
+                  number-of-nodes node-number-list
+
+                  However, for version 2, the format reads like this:
+                    elm-number elm-type number-of-tags < tag > ...
+                  node-number-list
+
+                  For version 4, we have:
+                    tag(int) numVert(int) ...
+
+                  In the following, we will ignore the element number (we
+                  simply enumerate them in the order in which we read them,
+                  and we will take reg-phys (version 1) or the first tag
+                  (version 2, if any tag is given at all) as material id. For
+                  version 4, we already read the material and the cell type
+                  in above.
+                */
+
+                unsigned int elm_number = 0;
+                if (gmsh_file_format < 40)
+                  {
+                    elm_number = next(); // ELM-NUMBER
+                    cell_type  = next(); // ELM-TYPE
+                  }
 
-            if (gmsh_file_format < 20)
-              {
-                in >> material_id // REG-PHYS
-                  >> dummy        // reg_elm
-                  >> nod_num;
-              }
-            else if (gmsh_file_format < 40)
-              {
-                // read the tags; ignore all but the first one which we will
-                // interpret as the material_id (for cells) or boundary_id
-                // (for faces)
-                unsigned int n_tags;
-                in >> n_tags;
-                if (n_tags > 0)
-                  in >> material_id;
-                else
-                  material_id = 0;
-
-                for (unsigned int i = 1; i < n_tags; ++i)
-                  in >> dummy;
-
-                if (cell_type == 1) // line
-                  nod_num = 2;
-                else if (cell_type == 2) // tri
-                  nod_num = 3;
-                else if (cell_type == 3) // quad
-                  nod_num = 4;
-                else if (cell_type == 4) // tet
-                  nod_num = 4;
-                else if (cell_type == 5) // hex
-                  nod_num = 8;
-              }
-            else // file format version 4.0 and later
-              {
-                // ignore tag
-                int tag;
-                in >> tag;
+                if (gmsh_file_format < 20)
+                  {
+                    material_id = next(); // REG-PHYS
+                    next();               // reg_elm
+                    nod_num = next();
+                  }
+                else if (gmsh_file_format < 40)
+                  {
+                    // read the tags; ignore all but the first one which we
+                    // will interpret as the material_id (for cells) or
+                    // boundary_id (for faces)
+                    const unsigned int n_tags = next();
+                    if (n_tags > 0)
+                      material_id = next();
+                    else
+                      material_id = 0;
 
-                if (cell_type == 1) // line
-                  nod_num = 2;
-                else if (cell_type == 2) // tri
-                  nod_num = 3;
-                else if (cell_type == 3) // quad
-                  nod_num = 4;
-                else if (cell_type == 4) // tet
-                  nod_num = 4;
-                else if (cell_type == 5) // hex
-                  nod_num = 8;
-              }
+                    for (unsigned int i = 1; i < n_tags; ++i)
+                      next();
+                  }
+                else // file format version 4.0 and later
+                  {
+                    // ignore tag
+                    next();
+                  }
 
+                if (gmsh_file_format >= 20)
+                  {
+                    if (cell_type == 1) // line
+                      nod_num = 2;
+                    else if (cell_type == 2) // tri
+                      nod_num = 3;
+                    else if (cell_type == 3) // quad
+                      nod_num = 4;
+                    else if (cell_type == 4) // tet
+                      nod_num = 4;
+                    else if (cell_type == 5) // hex
+                      nod_num = 8;
+                  }
 
-            /*       `ELM-TYPE'
-                     defines the geometrical type of the N-th element:
-                     `1'
-                     Line (2 nodes, 1 edge).
 
-                     `2'
-                     Triangle (3 nodes, 3 edges).
+                /*       `ELM-TYPE'
+                         defines the geometrical type of the N-th element:
+                         `1'
+                         Line (2 nodes, 1 edge).
 
-                     `3'
-                     Quadrangle (4 nodes, 4 edges).
+                         `2'
+                         Triangle (3 nodes, 3 edges).
 
-                     `4'
-                     Tetrahedron (4 nodes, 6 edges, 6 faces).
+                         `3'
+                         Quadrangle (4 nodes, 4 edges).
 
-                     `5'
-                     Hexahedron (8 nodes, 12 edges, 6 faces).
+                         `4'
+                         Tetrahedron (4 nodes, 6 edges, 6 faces).
 
-                     `15'
-                     Point (1 node).
-            */
+                         `5'
+                         Hexahedron (8 nodes, 12 edges, 6 faces).
 
-            if (((cell_type == 1) && (dim == 1)) || // a line in 1d
-                ((cell_type == 2) && (dim == 2)) || // a triangle in 2d
-                ((cell_type == 3) && (dim == 2)) || // a quadrilateral in 2d
-                ((cell_type == 4) && (dim == 3)) || // a tet in 3d
-                ((cell_type == 5) && (dim == 3)))   // a hex in 3d
-              // found a cell
-              {
-                unsigned int vertices_per_cell = 0;
-                if (cell_type == 1) // line
-                  vertices_per_cell = 2;
-                else if (cell_type == 2) // tri
-                  vertices_per_cell = 3;
-                else if (cell_type == 3) // quad
-                  vertices_per_cell = 4;
-                else if (cell_type == 4) // tet
-                  vertices_per_cell = 4;
-                else if (cell_type == 5) // hex
-                  vertices_per_cell = 8;
-
-                AssertThrow(nod_num == vertices_per_cell,
-                            ExcMessage(
-                              "Number of nodes does not coincide with the "
-                              "number required for this object"));
-
-                // allocate and read indices
-                cells.emplace_back();
-                CellData<dim> &cell = cells.back();
-                cell.vertices.resize(vertices_per_cell);
-                for (unsigned int i = 0; i < vertices_per_cell; ++i)
-                  {
-                    // hypercube cells need to be reordered
-                    if (vertices_per_cell ==
-                        GeometryInfo<dim>::vertices_per_cell)
-                      in >> cell.vertices[dim == 3 ?
-                                            local_vertex_numbering[i] :
-                                            GeometryInfo<dim>::ucd_to_deal[i]];
-                    else
-                      in >> cell.vertices[i];
-                  }
+                         `15'
+                         Point (1 node).
+                */
 
-                // to make sure that the cast won't fail
-                Assert(material_id <=
-                         std::numeric_limits<types::material_id>::max(),
-                       ExcIndexRange(
-                         material_id,
-                         0,
-                         std::numeric_limits<types::material_id>::max()));
-                // we use only material_ids in the range from 0 to
-                // numbers::invalid_material_id-1
-                AssertIndexRange(material_id, numbers::invalid_material_id);
-
-                cell.material_id = material_id;
-
-                // transform from gmsh to consecutive numbering
-                for (unsigned int i = 0; i < vertices_per_cell; ++i)
+                if (((cell_type == 1) && (dim == 1)) || // a line in 1d
+                    ((cell_type == 2) && (dim == 2)) || // a triangle in 2d
+                    ((cell_type == 3) && (dim == 2)) || // a quadrilateral
+                    ((cell_type == 4) && (dim == 3)) || // a tet in 3d
+                    ((cell_type == 5) && (dim == 3)))   // a hex in 3d
+                  // found a cell
                   {
-                    AssertThrow(vertex_indices.find(cell.vertices[i]) !=
-                                  vertex_indices.end(),
-                                ExcInvalidVertexIndexGmsh(cell_per_entity,
-                                                          elm_number,
-                                                          cell.vertices[i]));
+                    unsigned int vertices_per_cell = 0;
+                    if (cell_type == 1) // line
+                      vertices_per_cell = 2;
+                    else if (cell_type == 2) // tri
+                      vertices_per_cell = 3;
+                    else if (cell_type == 3) // quad
+                      vertices_per_cell = 4;
+                    else if (cell_type == 4) // tet
+                      vertices_per_cell = 4;
+                    else if (cell_type == 5) // hex
+                      vertices_per_cell = 8;
+
+                    AssertThrow(nod_num == vertices_per_cell,
+                                ExcMessage(
+                                  "Number of nodes does not coincide with the "
+                                  "number required for this object"));
+
+                    // allocate and read indices
+                    cells.emplace_back();
+                    CellData<dim> &cell = cells.back();
+                    cell.vertices.resize(vertices_per_cell);
+                    for (unsigned int i = 0; i < vertices_per_cell; ++i)
+                      {
+                        // hypercube cells need to be reordered
+                        if (vertices_per_cell ==
+                            GeometryInfo<dim>::vertices_per_cell)
+                          cell.vertices[dim == 3 ?
+                                          local_vertex_numbering[i] :
+                                          GeometryInfo<dim>::ucd_to_deal[i]] =
+                            next();
+                        else
+                          cell.vertices[i] = next();
+                      }
 
-                    const auto vertex = vertex_indices[cell.vertices[i]];
-                    if (dim == 1)
-                      vertex_counts[vertex] += 1u;
-                    cell.vertices[i] = vertex;
+                    // to make sure that the cast won't fail
+                    Assert(material_id <=
+                             std::numeric_limits<types::material_id>::max(),
+                           ExcIndexRange(
+                             material_id,
+                             0,
+                             std::numeric_limits<types::material_id>::max()));
+                    // we use only material_ids in the range from 0 to
+                    // numbers::invalid_material_id-1
+                    AssertIndexRange(material_id, numbers::invalid_material_id);
+
+                    cell.material_id = material_id;
+
+                    // transform from gmsh to consecutive numbering
+                    for (unsigned int i = 0; i < vertices_per_cell; ++i)
+                      {
+                        const unsigned int vertex =
+                          vertex_indices[cell.vertices[i]];
+                        AssertThrow(vertex != numbers::invalid_unsigned_int,
+                                    ExcInvalidVertexIndexGmsh(
+                                      cell_per_entity,
+                                      elm_number,
+                                      cell.vertices[i]));
+
+                        if (dim == 1)
+                          vertex_counts[vertex] += 1u;
+                        cell.vertices[i] = vertex;
+                      }
                   }
-              }
-            else if ((cell_type == 1) &&
-                     ((dim == 2) || (dim == 3))) // a line in 2d or 3d
-              // boundary info
-              {
-                subcelldata.boundary_lines.emplace_back();
-                in >> subcelldata.boundary_lines.back().vertices[0] >>
-                  subcelldata.boundary_lines.back().vertices[1];
-
-                // to make sure that the cast won't fail
-                Assert(material_id <=
-                         std::numeric_limits<types::boundary_id>::max(),
-                       ExcIndexRange(
-                         material_id,
-                         0,
-                         std::numeric_limits<types::boundary_id>::max()));
-                // we use only boundary_ids in the range from 0 to
-                // numbers::internal_face_boundary_id-1
-                AssertIndexRange(material_id,
-                                 numbers::internal_face_boundary_id);
-
-                subcelldata.boundary_lines.back().boundary_id =
-                  static_cast<types::boundary_id>(material_id);
-
-                // transform from ucd to
-                // consecutive numbering
-                for (unsigned int &vertex :
-                     subcelldata.boundary_lines.back().vertices)
-                  if (vertex_indices.find(vertex) != vertex_indices.end())
-                    // vertex with this index exists
-                    vertex = vertex_indices[vertex];
-                  else
-                    {
-                      // no such vertex index
-                      AssertThrow(false,
-                                  ExcInvalidVertexIndex(cell_per_entity,
-                                                        vertex));
-                      vertex = numbers::invalid_unsigned_int;
-                    }
-              }
-            else if ((cell_type == 2 || cell_type == 3) &&
-                     (dim == 3)) // a triangle or a quad in 3d
-              // boundary info
-              {
-                unsigned int vertices_per_cell = 0;
-                // check cell type
-                if (cell_type == 2) // tri
-                  vertices_per_cell = 3;
-                else if (cell_type == 3) // quad
-                  vertices_per_cell = 4;
-
-                subcelldata.boundary_quads.emplace_back();
-
-                // resize vertices
-                subcelldata.boundary_quads.back().vertices.resize(
-                  vertices_per_cell);
-                // for loop
-                for (unsigned int i = 0; i < vertices_per_cell; ++i)
-                  in >> subcelldata.boundary_quads.back().vertices[i];
-
-                // to make sure that the cast won't fail
-                Assert(material_id <=
-                         std::numeric_limits<types::boundary_id>::max(),
-                       ExcIndexRange(
-                         material_id,
-                         0,
-                         std::numeric_limits<types::boundary_id>::max()));
-                // we use only boundary_ids in the range from 0 to
-                // numbers::internal_face_boundary_id-1
-                AssertIndexRange(material_id,
-                                 numbers::internal_face_boundary_id);
-
-                subcelldata.boundary_quads.back().boundary_id =
-                  static_cast<types::boundary_id>(material_id);
-
-                // transform from gmsh to
-                // consecutive numbering
-                for (unsigned int &vertex :
-                     subcelldata.boundary_quads.back().vertices)
-                  if (vertex_indices.find(vertex) != vertex_indices.end())
-                    // vertex with this index exists
-                    vertex = vertex_indices[vertex];
-                  else
-                    {
-                      // no such vertex index
-                      Assert(false,
-                             ExcInvalidVertexIndex(cell_per_entity, vertex));
-                      vertex = numbers::invalid_unsigned_int;
-                    }
-              }
-            else if (cell_type == 15)
-              {
-                // read the indices of nodes given
-                unsigned int node_index = 0;
-                if (gmsh_file_format < 20)
+                else if ((cell_type == 1) &&
+                         ((dim == 2) || (dim == 3))) // a line in 2d or 3d
+                  // boundary info
+                  {
+                    subcelldata.boundary_lines.emplace_back();
+                    for (unsigned int &vertex :
+                         subcelldata.boundary_lines.back().vertices)
+                      vertex = next();
+
+                    // to make sure that the cast won't fail
+                    Assert(material_id <=
+                             std::numeric_limits<types::boundary_id>::max(),
+                           ExcIndexRange(
+                             material_id,
+                             0,
+                             std::numeric_limits<types::boundary_id>::max()));
+                    // we use only boundary_ids in the range from 0 to
+                    // numbers::internal_face_boundary_id-1
+                    AssertIndexRange(material_id,
+                                     numbers::internal_face_boundary_id);
+
+                    subcelldata.boundary_lines.back().boundary_id =
+                      static_cast<types::boundary_id>(material_id);
+
+                    // transform from ucd to
+                    // consecutive numbering
+                    for (unsigned int &vertex :
+                         subcelldata.boundary_lines.back().vertices)
+                      {
+                        // no such vertex index
+                        AssertThrow(vertex_indices[vertex] !=
+                                      numbers::invalid_unsigned_int,
+                                    ExcInvalidVertexIndex(cell_per_entity,
+                                                          vertex));
+                        vertex = vertex_indices[vertex];
+                      }
+                  }
+                else if ((cell_type == 2 || cell_type == 3) &&
+                         (dim == 3)) // a triangle or a quad in 3d
+                  // boundary info
                   {
-                    // For points (cell_type==15), we can only ever
-                    // list one node index.
-                    AssertThrow(nod_num == 1, ExcInternalError());
-                    in >> node_index;
+                    unsigned int vertices_per_cell = 0;
+                    // check cell type
+                    if (cell_type == 2) // tri
+                      vertices_per_cell = 3;
+                    else if (cell_type == 3) // quad
+                      vertices_per_cell = 4;
+
+                    subcelldata.boundary_quads.emplace_back();
+
+                    // resize vertices
+                    subcelldata.boundary_quads.back().vertices.resize(
+                      vertices_per_cell);
+                    // for loop
+                    for (unsigned int i = 0; i < vertices_per_cell; ++i)
+                      subcelldata.boundary_quads.back().vertices[i] = next();
+
+                    // to make sure that the cast won't fail
+                    Assert(material_id <=
+                             std::numeric_limits<types::boundary_id>::max(),
+                           ExcIndexRange(
+                             material_id,
+                             0,
+                             std::numeric_limits<types::boundary_id>::max()));
+                    // we use only boundary_ids in the range from 0 to
+                    // numbers::internal_face_boundary_id-1
+                    AssertIndexRange(material_id,
+                                     numbers::internal_face_boundary_id);
+
+                    subcelldata.boundary_quads.back().boundary_id =
+                      static_cast<types::boundary_id>(material_id);
+
+                    // transform from gmsh to
+                    // consecutive numbering
+                    for (unsigned int &vertex :
+                         subcelldata.boundary_quads.back().vertices)
+                      {
+                        // no such vertex index
+                        Assert(vertex_indices[vertex] !=
+                                 numbers::invalid_unsigned_int,
+                               ExcInvalidVertexIndex(cell_per_entity, vertex));
+                        vertex = vertex_indices[vertex];
+                      }
+                  }
+                else if (cell_type == 15)
+                  {
+                    // For points (cell_type==15), we can only ever list one
+                    // node index.
+                    if (gmsh_file_format < 20)
+                      AssertThrow(nod_num == 1, ExcInternalError());
+                    const unsigned int node_index = next();
+
+                    // we only care about boundary indicators assigned to
+                    // individual vertices in 1d (because otherwise the
+                    // vertices are not faces)
+                    if (dim == 1)
+                      boundary_ids_1d[vertex_indices[node_index]] =
+                        material_id;
                   }
                 else
                   {
-                    in >> node_index;
+                    AssertThrow(false, ExcGmshUnsupportedGeometry(cell_type));
                   }
-
-                // we only care about boundary indicators assigned to
-                // individual vertices in 1d (because otherwise the vertices
-                // are not faces)
-                if (dim == 1)
-                  boundary_ids_1d[vertex_indices[node_index]] = material_id;
-              }
-            else
-              {
-                AssertThrow(false, ExcGmshUnsupportedGeometry(cell_type));
               }
           }
+        global_cell += numElements;
       }
     AssertDimension(global_cell, n_cells);
   }
@@ -2663,6 +2892,29 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   AssertThrow(line == end_elements_marker[gmsh_file_format == 10 ? 0 : 1],
               ExcInvalidGMSHInput(line));
   AssertThrow(in.fail() == false, ExcIO());
+}
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_msh(std::istream &in)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
+
+  std::vector<Point<spacedim>>               vertices;
+  std::vector<CellData<dim>>                 cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+  std::map<unsigned int, unsigned int>       vertex_counts;
+  read_msh_data(in,
+                0,
+                1,
+                vertices,
+                cells,
+                subcelldata,
+                boundary_ids_1d,
+                vertex_counts);
 
   // check that we actually read some cells.
   AssertThrow(cells.size() > 0,
@@ -2690,6 +2942,36 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
 
 
 
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_msh_slice(std::istream                 &in,
+                                      const unsigned int            slice,
+                                      const unsigned int            n_slices,
+                                      std::vector<Point<spacedim>> &vertices,
+                                      std::vector<CellData<dim>>   &cells,
+                                      SubCellData &subcell_data)
+{
+  AssertIndexRange(slice, n_slices);
+
+  vertices.clear();
+  cells.clear();
+  subcell_data = SubCellData();
+
+  // the boundary ids of vertices in 1d are not passed on
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+  std::map<unsigned int, unsigned int>       vertex_counts;
+  read_msh_data(in,
+                slice,
+                n_slices,
+                vertices,
+                cells,
+                subcell_data,
+                boundary_ids_1d,
+                vertex_counts);
+}
+
+
+
 #ifdef DEAL_II_GMSH_WITH_API
 template <int dim, int spacedim>
 void
@@ -2047,6 +2047,177 @@ namespace GridTools
   }
 
 
+
+  template <int dim, int spacedim>
+  void
+  order_cells_along_space_filling_curve(Triangulation<dim, spacedim> &tria)
+  {
+    AssertThrow(
+      (dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+         &tria) == nullptr),
+      ExcMessage("This function is only implemented for serial "
+                 "triangulations."));
+    AssertThrow(tria.get_periodic_face_map().empty(),
+                ExcMessage("This function is not implemented for "
+                           "triangulations with periodic faces."));
+
+    using cell_iterator = typename Triangulation<dim, spacedim>::cell_iterator;
+
+    auto [vertices, cells, subcell_data] = get_coarse_mesh_description(tria);
+
+    // sort the coarse cells along the Hilbert curve through their centers
+    std::vector<Point<spacedim>> centers(cells.size());
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      {
+        for (const unsigned int v : cells[c].vertices)
+          centers[c] += vertices[v];
+        centers[c] /= cells[c].vertices.size();
+      }
+    const std::vector<std::array<std::uint64_t, spacedim>> hilbert_indices =
+      Utilities::inverse_Hilbert_space_filling_curve(centers);
+
+    std::vector<unsigned int> new_to_old_cell(cells.size());
+    std::iota(new_to_old_cell.begin(), new_to_old_cell.end(), 0U);
+    std::stable_sort(new_to_old_cell.begin(),
+                     new_to_old_cell.end(),
+                     [&](const unsigned int a, const unsigned int b) {
+                       return std::lexicographical_compare(
+                         hilbert_indices[a].begin(),
+                         hilbert_indices[a].end(),
+                         hilbert_indices[b].begin(),
+                         hilbert_indices[b].end());
+                     });
+
+    // reorder the cells and number the vertices in the order in which they
+    // are first used by the sorted cells
+    std::vector<CellData<dim>> sorted_cells;
+    sorted_cells.reserve(cells.size());
+    for (const unsigned int c : new_to_old_cell)
+      sorted_cells.push_back(std::move(cells[c]));
+
+    std::vector<unsigned int> new_vertex_index(vertices.size(),
+                                               numbers::invalid_unsigned_int);
+    std::vector<Point<spacedim>> sorted_vertices;
+    sorted_vertices.reserve(vertices.size());
+    for (CellData<dim> &cell : sorted_cells)
+      for (unsigned int &v : cell.vertices)
+        {
+          if (new_vertex_index[v] == numbers::invalid_unsigned_int)
+            {
+              new_vertex_index[v] = sorted_vertices.size();
+              sorted_vertices.push_back(vertices[v]);
+            }
+          v = new_vertex_index[v];
+        }
+    for (CellData<1> &line : subcell_data.boundary_lines)
+      for (unsigned int &v : line.vertices)
+        v = new_vertex_index[v];
+    for (CellData<2> &quad : subcell_data.boundary_quads)
+      for (unsigned int &v : quad.vertices)
+        v = new_vertex_index[v];
+
+    // create the coarse mesh with the manifolds of the old triangulation,
+    // which we need to recreate the same refined mesh
+    Triangulation<dim, spacedim> new_tria(
+      Triangulation<dim, spacedim>::MeshSmoothing::none);
+    std::set<types::manifold_id> manifold_ids;
+    for (const auto &cell : tria.cell_iterators())
+      {
+        manifold_ids.insert(cell->manifold_id());
+        for (const auto &face : cell->face_iterators())
+          manifold_ids.insert(face->manifold_id());
+        if (dim == 3)
+          for (unsigned int l = 0; l < cell->n_lines(); ++l)
+            manifold_ids.insert(cell->line(l)->manifold_id());
+      }
+    for (const types::manifold_id id : manifold_ids)
+      if (id != numbers::flat_manifold_id)
+        new_tria.set_manifold(id, tria.get_manifold(id));
+
+    new_tria.create_triangulation(sorted_vertices, sorted_cells, subcell_data);
+
+    // then replay the refinement of the old triangulation level by level,
+    // keeping track of which new cell corresponds to which old one
+    std::vector<std::pair<cell_iterator, cell_iterator>> cell_pairs;
+    for (unsigned int c = 0; c < new_to_old_cell.size(); ++c)
+      cell_pairs.emplace_back(cell_iterator(&new_tria, 0, c),
+                              cell_iterator(&tria, 0, new_to_old_cell[c]));
+
+    std::vector<std::pair<cell_iterator, cell_iterator>> all_cell_pairs;
+    all_cell_pairs.reserve(tria.n_cells());
+    while (cell_pairs.empty() == false)
+      {
+        bool any_refined = false;
+        for (const auto &[new_cell, old_cell] : cell_pairs)
+          if (old_cell->has_children())
+            {
+              new_cell->set_refine_flag(old_cell->refinement_case());
+              any_refined = true;
+            }
+        if (any_refined)
+          new_tria.execute_coarsening_and_refinement();
+
+        std::vector<std::pair<cell_iterator, cell_iterator>> child_pairs;
+        for (const auto &[new_cell, old_cell] : cell_pairs)
+          if (old_cell->has_children())
+            {
+              AssertThrow(new_cell->has_children() &&
+                            new_cell->n_children() == old_cell->n_children(),
+                          ExcInternalError());
+              for (unsigned int c = 0; c < old_cell->n_children(); ++c)
+                child_pairs.emplace_back(new_cell->child(c),
+                                         old_cell->child(c));
+            }
+
+        all_cell_pairs.insert(all_cell_pairs.end(),
+                              cell_pairs.begin(),
+                              cell_pairs.end());
+        cell_pairs = std::move(child_pairs);
+      }
+    AssertThrow(new_tria.n_active_cells() == tria.n_active_cells(),
+                ExcInternalError());
+
+    // copy the data that may have been changed after the refinement: the
+    // ids of cells, faces, and lines, and the vertex locations
+    for (const auto &[new_cell, old_cell] : all_cell_pairs)
+      {
+        new_cell->set_material_id(old_cell->material_id());
+        new_cell->set_manifold_id(old_cell->manifold_id());
+        new_cell->set_level_subdomain_id(old_cell->level_subdomain_id());
+        if (old_cell->is_active())
+          {
+            new_cell->set_subdomain_id(old_cell->subdomain_id());
+            for (const unsigned int v : old_cell->vertex_indices())
+              new_cell->vertex(v) = old_cell->vertex(v);
+          }
+
+        for (const unsigned int f : old_cell->face_indices())
+          {
+            if (old_cell->face(f)->at_boundary())
+              new_cell->face(f)->set_boundary_id(
+                old_cell->face(f)->boundary_id());
+            new_cell->face(f)->set_manifold_id(
+              old_cell->face(f)->manifold_id());
+          }
+
+        if (dim == 3)
+          for (unsigned int l = 0; l < old_cell->n_lines(); ++l)
+            {
+              const auto old_line = old_cell->line(l);
+              if (old_line->boundary_id() !=
+                  numbers::internal_face_boundary_id)
+                new_cell->line(l)->set_boundary_id(old_line->boundary_id());
+              new_cell->line(l)->set_manifold_id(old_line->manifold_id());
+            }
+      }
+
+    const auto mesh_smoothing = tria.get_mesh_smoothing();
+    tria.clear();
+    tria.copy_triangulation(new_tria);
+    tria.set_mesh_smoothing(mesh_smoothing);
+  }
+
+
   // define some transformations
   namespace internal
   {
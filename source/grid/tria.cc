@@ -19,6 +19,7 @@
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/mpi_large_count.h>
 #include <deal.II/base/mpi_stub.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
@@ -125,6 +126,328 @@ namespace internal
               MemoryConsumption::memory_consumption(n_active_hexes) +
               MemoryConsumption::memory_consumption(n_active_hexes_level));
     }
+
+
+
+    namespace
+    {
+      /**
+       * The string at the beginning of the files written by
+       * Triangulation::save(), which distinguishes them from the text
+       * archives written by earlier versions of that function.
+       */
+      const std::string binary_file_identifier =
+        "deal.II Triangulation binary format\n";
+
+      /**
+       * The version of the binary format, to be increased whenever the
+       * layout of the files changes.
+       */
+      constexpr std::uint32_t binary_file_version = 1;
+
+
+
+      /**
+       * Write the bytes of a single object to a binary stream.
+       */
+      template <typename T>
+      void
+      write_value(std::ostream &out, const T &value)
+      {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Only trivially copyable objects can be written.");
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+      }
+
+
+
+      /**
+       * Read a single object written by write_value().
+       */
+      template <typename T>
+      void
+      read_value(std::istream &in, T &value)
+      {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Only trivially copyable objects can be read.");
+        in.read(reinterpret_cast<char *>(&value), sizeof(T));
+        AssertThrow(in, ExcIO());
+      }
+
+
+
+      /**
+       * Write the size of a vector and its elements as one contiguous block
+       * of bytes, such that reading the vector back in is a single copy.
+       */
+      template <typename T>
+      void
+      write_vector(std::ostream &out, const std::vector<T> &data)
+      {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Only trivially copyable objects can be written.");
+        write_value(out, static_cast<std::uint64_t>(data.size()));
+        out.write(reinterpret_cast<const char *>(data.data()),
+                  data.size() * sizeof(T));
+      }
+
+
+
+      /**
+       * Read a vector written by write_vector().
+       */
+      template <typename T>
+      void
+      read_vector(std::istream &in, std::vector<T> &data)
+      {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Only trivially copyable objects can be read.");
+        std::uint64_t size = 0;
+        read_value(in, size);
+        data.resize(size);
+        in.read(reinterpret_cast<char *>(data.data()), size * sizeof(T));
+        AssertThrow(in, ExcIO());
+      }
+
+
+
+      /**
+       * Same as above, but for a vector of bools, which is written with
+       * eight entries per byte.
+       */
+      void
+      write_vector(std::ostream &out, const std::vector<bool> &data)
+      {
+        std::vector<std::uint8_t> packed((data.size() + 7) / 8, 0);
+        for (std::size_t i = 0; i < data.size(); ++i)
+          if (data[i])
+            packed[i / 8] |= (1U << (i % 8));
+        write_value(out, static_cast<std::uint64_t>(data.size()));
+        write_vector(out, packed);
+      }
+
+
+
+      void
+      read_vector(std::istream &in, std::vector<bool> &data)
+      {
+        std::uint64_t size = 0;
+        read_value(in, size);
+        std::vector<std::uint8_t> packed;
+        read_vector(in, packed);
+        AssertThrow(packed.size() == (size + 7) / 8, ExcIO());
+        data.resize(size);
+        for (std::size_t i = 0; i < size; ++i)
+          data[i] = (packed[i / 8] >> (i % 8)) & 1U;
+      }
+
+
+
+      /**
+       * Same as above, but for the neighbors of the cells, which are stored
+       * as pairs of integers.
+       */
+      void
+      write_vector(std::ostream                           &out,
+                   const std::vector<std::pair<int, int>> &data)
+      {
+        std::vector<int> flat(2 * data.size());
+        for (std::size_t i = 0; i < data.size(); ++i)
+          {
+            flat[2 * i]     = data[i].first;
+            flat[2 * i + 1] = data[i].second;
+          }
+        write_vector(out, flat);
+      }
+
+
+
+      void
+      read_vector(std::istream &in, std::vector<std::pair<int, int>> &data)
+      {
+        std::vector<int> flat;
+        read_vector(in, flat);
+        AssertThrow(flat.size() % 2 == 0, ExcIO());
+        data.resize(flat.size() / 2);
+        for (std::size_t i = 0; i < data.size(); ++i)
+          data[i] = {flat[2 * i], flat[2 * i + 1]};
+      }
+
+
+
+      /**
+       * Write the orientation flags of a TriaObjectsOrientations object.
+       */
+      void
+      write_orientations(std::ostream                  &out,
+                         const TriaObjectsOrientations &orientations)
+      {
+        std::vector<unsigned char> flags(orientations.n_objects());
+        for (unsigned int i = 0; i < flags.size(); ++i)
+          flags[i] = orientations.get_combined_orientation(i);
+        write_vector(out, flags);
+      }
+
+
+
+      void
+      read_orientations(std::istream &in, TriaObjectsOrientations &orientations)
+      {
+        std::vector<unsigned char> flags;
+        read_vector(in, flags);
+        orientations.reinit(flags.size());
+        for (unsigned int i = 0; i < flags.size(); ++i)
+          orientations.set_combined_orientation(i, flags[i]);
+      }
+
+
+
+      /**
+       * Write all fields of a TriaObjects object, in the same order as
+       * TriaObjects::serialize().
+       */
+      void
+      write_objects(std::ostream &out, const TriaObjects &objects)
+      {
+        write_value(out, objects.structdim);
+        write_vector(out, objects.cells);
+        write_vector(out, objects.children);
+        write_vector(out, objects.refinement_cases);
+        write_vector(out, objects.used);
+        write_vector(out, objects.user_flags);
+        write_vector(out, objects.boundary_or_material_id);
+        write_vector(out, objects.manifold_id);
+        write_value(out, objects.next_free_single);
+        write_value(out, objects.next_free_pair);
+        write_value(out, objects.reverse_order_next_free_single);
+        write_vector(out, objects.user_data);
+        write_value(out, objects.user_data_type);
+      }
+
+
+
+      void
+      read_objects(std::istream &in, TriaObjects &objects)
+      {
+        read_value(in, objects.structdim);
+        read_vector(in, objects.cells);
+        read_vector(in, objects.children);
+        read_vector(in, objects.refinement_cases);
+        read_vector(in, objects.used);
+        read_vector(in, objects.user_flags);
+        read_vector(in, objects.boundary_or_material_id);
+        read_vector(in, objects.manifold_id);
+        read_value(in, objects.next_free_single);
+        read_value(in, objects.next_free_pair);
+        read_value(in, objects.reverse_order_next_free_single);
+        read_vector(in, objects.user_data);
+        read_value(in, objects.user_data_type);
+      }
+
+
+
+      /**
+       * Write all fields of a TriaLevel object that TriaLevel::serialize()
+       * writes. The caches are rebuilt after loading.
+       */
+      void
+      write_level(std::ostream &out, const TriaLevel &level)
+      {
+        write_value(out, level.dim);
+        write_vector(out, level.refine_flags);
+        write_vector(out, level.coarsen_flags);
+        write_vector(out, level.neighbors);
+        write_vector(out, level.subdomain_ids);
+        write_vector(out, level.level_subdomain_ids);
+        write_vector(out, level.parents);
+        write_vector(out, level.direction_flags);
+        write_objects(out, level.cells);
+        write_orientations(out, level.face_orientations);
+        write_vector(out, level.reference_cell);
+      }
+
+
+
+      void
+      read_level(std::istream &in, TriaLevel &level)
+      {
+        read_value(in, level.dim);
+        read_vector(in, level.refine_flags);
+        read_vector(in, level.coarsen_flags);
+        read_vector(in, level.neighbors);
+        read_vector(in, level.subdomain_ids);
+        read_vector(in, level.level_subdomain_ids);
+        read_vector(in, level.parents);
+        read_vector(in, level.direction_flags);
+        read_objects(in, level.cells);
+        read_orientations(in, level.face_orientations);
+        read_vector(in, level.reference_cell);
+      }
+
+
+
+      /**
+       * Write all fields of a TriaFaces object.
+       */
+      void
+      write_faces(std::ostream &out, const TriaFaces &faces)
+      {
+        write_value(out, faces.dim);
+        write_objects(out, faces.quads);
+        write_objects(out, faces.lines);
+        write_vector(out, faces.quads_line_orientations);
+        write_vector(out, faces.quad_is_quadrilateral);
+      }
+
+
+
+      void
+      read_faces(std::istream &in, TriaFaces &faces)
+      {
+        read_value(in, faces.dim);
+        read_objects(in, faces.quads);
+        read_objects(in, faces.lines);
+        read_vector(in, faces.quads_line_orientations);
+        read_vector(in, faces.quad_is_quadrilateral);
+      }
+
+
+
+      /**
+       * Write the entries of one of the maps from vertex indices to ids
+       * used in 1d.
+       */
+      template <typename IdType>
+      void
+      write_map(std::ostream &out, const std::map<unsigned int, IdType> &map)
+      {
+        write_value(out, static_cast<std::uint64_t>(map.size()));
+        for (const auto &[vertex, id] : map)
+          {
+            write_value(out, vertex);
+            write_value(out, id);
+          }
+      }
+
+
+
+      template <typename IdType>
+      void
+      read_map(std::istream &in, std::map<unsigned int, IdType> &map)
+      {
+        std::uint64_t size = 0;
+        read_value(in, size);
+        map.clear();
+        for (std::uint64_t i = 0; i < size; ++i)
+          {
+            unsigned int vertex;
+            IdType       id;
+            read_value(in, vertex);
+            read_value(in, id);
+            map.emplace_hint(map.end(), vertex, id);
+          }
+      }
+    } // namespace
   } // namespace TriangulationImplementation
 
 
@@ -3048,6 +3371,38 @@ namespace internal
       }
 
 
+      /**
+       * Call @p operation for all used cells of @p triangulation, where the
+       * cells of each level are split into chunks that are worked on in
+       * parallel. The @p operation may only write to the data of the cell
+       * it is called with, such that the result does not depend on the
+       * order in which the cells are visited.
+       */
+      template <int dim, int spacedim, typename Operation>
+      static void
+      for_each_used_cell_in_parallel(
+        const Triangulation<dim, spacedim> &triangulation,
+        const Operation                    &operation)
+      {
+        for (unsigned int level = 0; level < triangulation.levels.size();
+             ++level)
+          dealii::parallel::apply_to_subranges(
+            0U,
+            triangulation.levels[level]->refine_flags.size(),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int index = begin; index < end; ++index)
+                {
+                  const typename Triangulation<dim, spacedim>::
+                    raw_cell_iterator cell(&triangulation, level, index);
+                  if (cell->used())
+                    operation(cell);
+                }
+            },
+            /* grainsize = */ 512);
+      }
+
+
+
       template <int spacedim>
       static void
       update_neighbors(Triangulation<1, spacedim> &)
@@ -3216,7 +3571,12 @@ namespace internal
         // have to use the opposite of the
         // left_right_offset in this case as we want
         // the offset of the neighbor, not our own.
-        for (const auto &cell : triangulation.cell_iterators())
+        // Since each cell only sets its own
+        // neighbors, this loop can run in parallel,
+        // as opposed to the loop above where cells
+        // on finer levels overwrite the entries of
+        // coarser ones.
+        for_each_used_cell_in_parallel(triangulation, [&](const auto &cell) {
           for (auto f : cell->face_indices())
             {
               const unsigned int offset =
@@ -3227,6 +3587,7 @@ namespace internal
               cell->set_neighbor(
                 f, adjacent_cells[2 * cell->face(f)->index() + 1 - offset]);
             }
+        });
       }
 
 
@@ -12015,9 +12376,11 @@ namespace internal
                   set_entry(face->child(c)->index(), cell);
             }
 
-        for (const auto &cell : triangulation.cell_iterators())
-          for (auto f : cell->face_indices())
-            cell->set_neighbor(f, get_entry(cell->face(f)->index(), cell));
+        Implementation::for_each_used_cell_in_parallel(
+          triangulation, [&](const auto &cell) {
+            for (auto f : cell->face_indices())
+              cell->set_neighbor(f, get_entry(cell->face(f)->index(), cell));
+          });
       }
 
       template <int dim, int spacedim>
@@ -13719,20 +14082,143 @@ template <int dim, int spacedim>
 DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
 void Triangulation<dim, spacedim>::save(const std::string &filename) const
 {
-  // Create boost archive then call alternative version of the save function
-  std::ofstream                 ofs(filename);
-  boost::archive::text_oarchive oa(ofs, boost::archive::no_header);
-  save(oa, 0);
+  using namespace internal::TriangulationImplementation;
+
+  std::ofstream out(filename, std::ios::binary);
+  AssertThrow(out, ExcFileNotOpen(filename));
+
+  // write a header that identifies the format and the dimensions, then the
+  // same data as save(Archive &), with each array as one block of bytes
+  out.write(binary_file_identifier.data(), binary_file_identifier.size());
+  write_value(out, binary_file_version);
+  write_value(out, static_cast<std::uint32_t>(dim));
+  write_value(out, static_cast<std::uint32_t>(spacedim));
+
+  write_value(out, smooth_grid);
+  write_value(out, anisotropic_refinement);
+  write_value(out, check_for_distorted_cells);
+
+  write_vector(out, vertices);
+  write_vector(out, vertices_used);
+
+  write_value(out, static_cast<std::uint32_t>(levels.size()));
+  for (const auto &level : levels)
+    write_level(out, *level);
+
+  // the faces are only allocated once cells have been created, so an empty
+  // triangulation does not have them
+  const bool has_faces = (faces != nullptr);
+  write_value(out, has_faces);
+  if (has_faces)
+    write_faces(out, *faces);
+
+  if (dim == 1)
+    {
+      write_map(out, *vertex_to_boundary_id_map_1d);
+      write_map(out, *vertex_to_manifold_id_map_1d);
+    }
+
+  AssertThrow(out, ExcIO());
 }
 
 template <int dim, int spacedim>
 DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
 void Triangulation<dim, spacedim>::load(const std::string &filename)
 {
-  // Create boost archive then call alternative version of the load function
-  std::ifstream                 ifs(filename);
-  boost::archive::text_iarchive ia(ifs, boost::archive::no_header);
-  load(ia, 0);
+  using namespace internal::TriangulationImplementation;
+
+  std::ifstream in(filename, std::ios::binary);
+  AssertThrow(in, ExcFileNotOpen(filename));
+
+  std::string identifier(binary_file_identifier.size(), '\0');
+  in.read(&identifier[0], identifier.size());
+  if (!in || identifier != binary_file_identifier)
+    {
+      // files written by earlier versions of save() contain a text archive
+      // of BOOST. create the archive and call the alternative version of
+      // this function
+      in.close();
+      std::ifstream                 ifs(filename);
+      boost::archive::text_iarchive ia(ifs, boost::archive::no_header);
+      load(ia, 0);
+      return;
+    }
+
+  std::uint32_t version = 0, file_dim = 0, file_spacedim = 0;
+  read_value(in, version);
+  read_value(in, file_dim);
+  read_value(in, file_spacedim);
+  AssertThrow(version == binary_file_version,
+              ExcMessage("The file <" + filename +
+                         "> was written with an incompatible version of "
+                         "Triangulation::save()."));
+  AssertThrow(file_dim == dim && file_spacedim == spacedim,
+              ExcMessage("The file <" + filename +
+                         "> contains a triangulation of different "
+                         "dimensions."));
+
+  // clear previous content. this also calls the respective signal
+  clear();
+
+  read_value(in, smooth_grid);
+  read_value(in, anisotropic_refinement);
+
+  bool my_check_for_distorted_cells;
+  read_value(in, my_check_for_distorted_cells);
+  Assert(my_check_for_distorted_cells == check_for_distorted_cells,
+         ExcMessage("The triangulation loaded into here must have the "
+                    "same setting with regard to reporting distorted "
+                    "cell as the one previously stored."));
+
+  read_vector(in, vertices);
+  read_vector(in, vertices_used);
+
+  std::uint32_t n_levels = 0;
+  read_value(in, n_levels);
+  levels.resize(n_levels);
+  for (auto &level : levels)
+    {
+      level = std::make_unique<TriaLevel>(dim);
+      read_level(in, *level);
+    }
+
+  bool has_faces = false;
+  read_value(in, has_faces);
+  if (has_faces)
+    {
+      faces = std::make_unique<TriaFaces>(dim);
+      read_faces(in, *faces);
+    }
+
+  if (dim == 1)
+    {
+      read_map(in, *vertex_to_boundary_id_map_1d);
+      read_map(in, *vertex_to_manifold_id_map_1d);
+    }
+
+  // rebuild the caches that are not stored in the file, as in
+  // load(Archive &). an empty triangulation has no levels, and its caches
+  // and policy are left as set up by clear()
+  if (!levels.empty())
+    {
+      for (auto &level : levels)
+        {
+          level->active_cell_indices.resize(level->refine_flags.size());
+          level->global_active_cell_indices.resize(
+            level->refine_flags.size());
+          level->global_level_cell_indices.resize(level->refine_flags.size());
+        }
+      reset_cell_vertex_indices_cache();
+      internal::TriangulationImplementation::Implementation::
+        compute_number_cache(*this, levels.size(), number_cache);
+      reset_active_cell_indices();
+      reset_global_cell_indices();
+      reset_policy();
+    }
+
+  // trigger the create signal to indicate that new content has been
+  // imported into the triangulation
+  signals.create();
 }
 
 namespace
@@ -15718,72 +16204,78 @@ template <int dim, int spacedim>
 DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
 void Triangulation<dim, spacedim>::reset_cell_vertex_indices_cache()
 {
+  constexpr unsigned int max_vertices_per_cell = 1 << dim;
   for (unsigned int l = 0; l < levels.size(); ++l)
     {
-      constexpr unsigned int     max_vertices_per_cell = 1 << dim;
       std::vector<unsigned int> &cache = levels[l]->cell_vertex_indices_cache;
       cache.clear();
       cache.resize(levels[l]->refine_flags.size() * max_vertices_per_cell,
                    numbers::invalid_unsigned_int);
-      for (const auto &cell : cell_iterators_on_level(l))
+    }
+
+  // each cell only writes its own entries, so we can fill the caches in
+  // parallel
+  internal::TriangulationImplementation::Implementation::
+    for_each_used_cell_in_parallel(*this, [&](const auto &cell) {
+      const unsigned int l        = cell->level();
+      const unsigned int my_index = cell->index() * max_vertices_per_cell;
+
+      std::vector<unsigned int> &cache = levels[l]->cell_vertex_indices_cache;
+
+      // to reduce the cost of this function when passing down into quads,
+      // then lines, then vertices, we use a more low-level access method
+      // for hexahedral cells, where we can streamline most of the logic
+      const ReferenceCell ref_cell = cell->reference_cell();
+      if (ref_cell == ReferenceCells::Hexahedron)
+        for (unsigned int face = 4; face < 6; ++face)
+          {
+            const auto                face_iter = cell->face(face);
+            const std::array<bool, 2> line_orientations{
+              {face_iter->line_orientation(0),
+               face_iter->line_orientation(1)}};
+            std::array<unsigned int, 4> raw_vertex_indices{
+              {face_iter->line(0)->vertex_index(1 - line_orientations[0]),
+               face_iter->line(1)->vertex_index(1 - line_orientations[1]),
+               face_iter->line(0)->vertex_index(line_orientations[0]),
+               face_iter->line(1)->vertex_index(line_orientations[1])}};
+
+            const unsigned char combined_orientation =
+              levels[l]->face_orientations.get_combined_orientation(
+                cell->index() * GeometryInfo<3>::faces_per_cell + face);
+            std::array<unsigned int, 4> vertex_order{
+              {ref_cell.standard_to_real_face_vertex(0,
+                                                     face,
+                                                     combined_orientation),
+               ref_cell.standard_to_real_face_vertex(1,
+                                                     face,
+                                                     combined_orientation),
+               ref_cell.standard_to_real_face_vertex(2,
+                                                     face,
+                                                     combined_orientation),
+               ref_cell.standard_to_real_face_vertex(
+                 3, face, combined_orientation)}};
+
+            const unsigned int index = my_index + 4 * (face - 4);
+            for (unsigned int i = 0; i < 4; ++i)
+              cache[index + i] = raw_vertex_indices[vertex_order[i]];
+          }
+      else if (ref_cell == ReferenceCells::Quadrilateral)
         {
-          const unsigned int my_index = cell->index() * max_vertices_per_cell;
-
-          // to reduce the cost of this function when passing down into quads,
-          // then lines, then vertices, we use a more low-level access method
-          // for hexahedral cells, where we can streamline most of the logic
-          const ReferenceCell ref_cell = cell->reference_cell();
-          if (ref_cell == ReferenceCells::Hexahedron)
-            for (unsigned int face = 4; face < 6; ++face)
-              {
-                const auto                face_iter = cell->face(face);
-                const std::array<bool, 2> line_orientations{
-                  {face_iter->line_orientation(0),
-                   face_iter->line_orientation(1)}};
-                std::array<unsigned int, 4> raw_vertex_indices{
-                  {face_iter->line(0)->vertex_index(1 - line_orientations[0]),
-                   face_iter->line(1)->vertex_index(1 - line_orientations[1]),
-                   face_iter->line(0)->vertex_index(line_orientations[0]),
-                   face_iter->line(1)->vertex_index(line_orientations[1])}};
-
-                const unsigned char combined_orientation =
-                  levels[l]->face_orientations.get_combined_orientation(
-                    cell->index() * GeometryInfo<3>::faces_per_cell + face);
-                std::array<unsigned int, 4> vertex_order{
-                  {ref_cell.standard_to_real_face_vertex(0,
-                                                         face,
-                                                         combined_orientation),
-                   ref_cell.standard_to_real_face_vertex(1,
-                                                         face,
-                                                         combined_orientation),
-                   ref_cell.standard_to_real_face_vertex(2,
-                                                         face,
-                                                         combined_orientation),
-                   ref_cell.standard_to_real_face_vertex(
-                     3, face, combined_orientation)}};
-
-                const unsigned int index = my_index + 4 * (face - 4);
-                for (unsigned int i = 0; i < 4; ++i)
-                  cache[index + i] = raw_vertex_indices[vertex_order[i]];
-              }
-          else if (ref_cell == ReferenceCells::Quadrilateral)
-            {
-              const std::array<bool, 2> line_orientations{
-                {cell->line_orientation(0), cell->line_orientation(1)}};
-              std::array<unsigned int, 4> raw_vertex_indices{
-                {cell->line(0)->vertex_index(1 - line_orientations[0]),
-                 cell->line(1)->vertex_index(1 - line_orientations[1]),
-                 cell->line(0)->vertex_index(line_orientations[0]),
-                 cell->line(1)->vertex_index(line_orientations[1])}};
-              for (unsigned int i = 0; i < 4; ++i)
-                cache[my_index + i] = raw_vertex_indices[i];
-            }
-          else
-            for (const unsigned int i : cell->vertex_indices())
-              cache[my_index + i] = internal::TriaAccessorImplementation::
-                Implementation::vertex_index(*cell, i);
+          const std::array<bool, 2> line_orientations{
+            {cell->line_orientation(0), cell->line_orientation(1)}};
+          std::array<unsigned int, 4> raw_vertex_indices{
+            {cell->line(0)->vertex_index(1 - line_orientations[0]),
+             cell->line(1)->vertex_index(1 - line_orientations[1]),
+             cell->line(0)->vertex_index(line_orientations[0]),
+             cell->line(1)->vertex_index(line_orientations[1])}};
+          for (unsigned int i = 0; i < 4; ++i)
+            cache[my_index + i] = raw_vertex_indices[i];
         }
-    }
+      else
+        for (const unsigned int i : cell->vertex_indices())
+          cache[my_index + i] = internal::TriaAccessorImplementation::
+            Implementation::vertex_index(*cell, i);
+    });
 }
 
 
@@ -17,6 +17,7 @@
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi_consensus_algorithms.h>
+#include <deal.II/base/utilities.h>
 
 #include <deal.II/distributed/fully_distributed_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -28,6 +29,9 @@
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_description.h>
 
+#include <numeric>
+#include <set>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -1094,6 +1098,730 @@ namespace TriangulationDescription
                                         settings);
     }
 
+
+    namespace internal
+    {
+      /**
+       * A coarse cell, as sent between the processes by
+       * create_description_from_distributed_coarse_mesh().
+       */
+      template <int dim>
+      struct DistributedCoarseCell
+      {
+        /**
+         * Serialization function for packing and unpacking the content of this
+         * class.
+         */
+        template <class Archive>
+        void
+        serialize(Archive &ar, const unsigned int /*version*/)
+        {
+          ar &key;
+          ar &id;
+          ar &owner;
+          ar &cell;
+        }
+
+        /**
+         * Index of the center of the cell along the space-filling curve.
+         */
+        std::uint64_t key;
+
+        /**
+         * Global index of the cell: its position in the input before the
+         * partitioning, and its coarse-cell id afterwards.
+         */
+        types::coarse_cell_id id;
+
+        /**
+         * Rank of the process owning the cell.
+         */
+        types::subdomain_id owner;
+
+        /**
+         * Global vertex indices, material id, and manifold id of the cell.
+         */
+        dealii::CellData<dim> cell;
+      };
+
+      /**
+       * Boundary id and manifold id of a face or a line, identified by its
+       * sorted global vertex indices.
+       */
+      struct DistributedSubCellObject
+      {
+        /**
+         * Serialization function for packing and unpacking the content of this
+         * class.
+         */
+        template <class Archive>
+        void
+        serialize(Archive &ar, const unsigned int /*version*/)
+        {
+          ar &vertices;
+          ar &boundary_id;
+          ar &manifold_id;
+        }
+
+        std::vector<unsigned int> vertices;
+        types::boundary_id        boundary_id;
+        types::manifold_id        manifold_id;
+      };
+
+      /**
+       * Return the rank of the process storing the vertex with global index
+       * @p vertex, given the offsets of the slices of the global vertex array
+       * stored on each process.
+       */
+      unsigned int
+      vertex_owner(const std::vector<unsigned int> &vertex_offsets,
+                   const unsigned int               vertex)
+      {
+        AssertIndexRange(vertex, vertex_offsets.back());
+        return std::distance(vertex_offsets.begin(),
+                             std::upper_bound(vertex_offsets.begin(),
+                                              vertex_offsets.end(),
+                                              vertex)) -
+               1;
+      }
+
+      /**
+       * Split the sorted list of global vertex indices @p vertex_indices into
+       * the ranges of indices stored on each process.
+       */
+      std::map<unsigned int, std::pair<unsigned int, unsigned int>>
+      split_by_vertex_owner(const std::vector<unsigned int> &vertex_indices,
+                            const std::vector<unsigned int> &vertex_offsets)
+      {
+        std::map<unsigned int, std::pair<unsigned int, unsigned int>> ranges;
+        for (unsigned int i = 0; i < vertex_indices.size();)
+          {
+            const unsigned int owner =
+              vertex_owner(vertex_offsets, vertex_indices[i]);
+            unsigned int end = i;
+            while (end < vertex_indices.size() &&
+                   vertex_indices[end] < vertex_offsets[owner + 1])
+              ++end;
+            ranges[owner] = {i, end};
+            i             = end;
+          }
+        return ranges;
+      }
+
+      /**
+       * Return the coordinates of the vertices with the sorted global
+       * indices @p vertex_indices, requesting them from the processes
+       * storing them.
+       */
+      template <int spacedim>
+      std::vector<Point<spacedim>>
+      request_vertices(
+        const std::vector<unsigned int>    &vertex_indices,
+        const std::vector<Point<spacedim>> &locally_stored_vertices,
+        const std::vector<unsigned int>    &vertex_offsets,
+        const MPI_Comm                      comm)
+      {
+        const unsigned int my_rank =
+          dealii::Utilities::MPI::this_mpi_process(comm);
+
+        const auto ranges =
+          split_by_vertex_owner(vertex_indices, vertex_offsets);
+        std::vector<unsigned int> targets;
+        for (const auto &range : ranges)
+          targets.push_back(range.first);
+
+        std::vector<Point<spacedim>> points(vertex_indices.size());
+
+        dealii::Utilities::MPI::ConsensusAlgorithms::selector<
+          std::vector<unsigned int>,
+          std::vector<Point<spacedim>>>(
+          targets,
+          [&](const unsigned int other_rank) {
+            const auto &range = ranges.at(other_rank);
+            return std::vector<unsigned int>(vertex_indices.begin() +
+                                               range.first,
+                                             vertex_indices.begin() +
+                                               range.second);
+          },
+          [&](const unsigned int, const std::vector<unsigned int> &request) {
+            std::vector<Point<spacedim>> answer;
+            answer.reserve(request.size());
+            for (const unsigned int v : request)
+              {
+                AssertIndexRange(v - vertex_offsets[my_rank],
+                                 locally_stored_vertices.size());
+                answer.push_back(
+                  locally_stored_vertices[v - vertex_offsets[my_rank]]);
+              }
+            return answer;
+          },
+          [&](const unsigned int                  other_rank,
+              const std::vector<Point<spacedim>> &answer) {
+            const auto &range = ranges.at(other_rank);
+            AssertDimension(answer.size(), range.second - range.first);
+            std::copy(answer.begin(),
+                      answer.end(),
+                      points.begin() + range.first);
+          },
+          comm);
+
+        return points;
+      }
+
+      /**
+       * Return the sorted global vertex indices of the given cells, without
+       * duplicates.
+       */
+      template <int dim>
+      std::vector<unsigned int>
+      collect_vertices(const std::vector<DistributedCoarseCell<dim>> &cells)
+      {
+        std::vector<unsigned int> vertex_indices;
+        for (const auto &cell : cells)
+          vertex_indices.insert(vertex_indices.end(),
+                                cell.cell.vertices.begin(),
+                                cell.cell.vertices.end());
+        std::sort(vertex_indices.begin(), vertex_indices.end());
+        vertex_indices.erase(std::unique(vertex_indices.begin(),
+                                         vertex_indices.end()),
+                             vertex_indices.end());
+        return vertex_indices;
+      }
+
+      /**
+       * Return the sorted global vertex indices of the faces (in 2d and 3d)
+       * and of the lines (in 3d) of a cell.
+       */
+      template <int dim>
+      std::vector<std::vector<unsigned int>>
+      sub_cell_object_keys(const dealii::CellData<dim> &cell)
+      {
+        const ReferenceCell reference_cell =
+          ReferenceCell::n_vertices_to_type(dim, cell.vertices.size());
+
+        std::vector<std::vector<unsigned int>> keys;
+        if (dim == 1)
+          return keys;
+
+        for (const unsigned int f : reference_cell.face_indices())
+          {
+            std::vector<unsigned int> key;
+            for (const unsigned int v :
+                 reference_cell.face_reference_cell(f).vertex_indices())
+              key.push_back(cell.vertices[reference_cell.face_to_cell_vertices(
+                f, v, ReferenceCell::default_combined_face_orientation())]);
+            std::sort(key.begin(), key.end());
+            keys.push_back(key);
+          }
+
+        if (dim == 3)
+          for (const unsigned int l : reference_cell.line_indices())
+            {
+              std::vector<unsigned int> key = {
+                cell.vertices[reference_cell.line_to_cell_vertices(l, 0)],
+                cell.vertices[reference_cell.line_to_cell_vertices(l, 1)]};
+              std::sort(key.begin(), key.end());
+              keys.push_back(key);
+            }
+
+        return keys;
+      }
+    } // namespace internal
+
+
+
+    template <int dim, int spacedim>
+    Description<dim, spacedim>
+    create_description_from_distributed_coarse_mesh(
+      const std::vector<Point<spacedim>>       &vertices,
+      const std::vector<dealii::CellData<dim>> &cells,
+      const SubCellData                        &subcell_data,
+      const MPI_Comm                            comm,
+      const typename Triangulation<dim, spacedim>::MeshSmoothing smoothing,
+      const TriangulationDescription::Settings                   settings)
+    {
+      AssertThrow(subcell_data.check_consistency(dim),
+                  ExcMessage("The subcell data does not fit the dimension."));
+
+      using CoarseCell = internal::DistributedCoarseCell<dim>;
+
+      const unsigned int my_rank =
+        dealii::Utilities::MPI::this_mpi_process(comm);
+      const unsigned int n_procs =
+        dealii::Utilities::MPI::n_mpi_processes(comm);
+
+      // 1) determine the slices of the global vertex array and of the
+      //    global cell array given on each process
+      std::vector<unsigned int>          vertex_offsets(n_procs + 1, 0);
+      std::vector<types::coarse_cell_id> cell_offsets(n_procs + 1, 0);
+      {
+        const auto sizes = dealii::Utilities::MPI::all_gather(
+          comm,
+          std::pair<std::uint64_t, std::uint64_t>(vertices.size(),
+                                                  cells.size()));
+        std::uint64_t n_global_vertices = 0;
+        for (unsigned int p = 0; p < n_procs; ++p)
+          {
+            n_global_vertices += sizes[p].first;
+            AssertThrow(n_global_vertices < numbers::invalid_unsigned_int,
+                        ExcMessage("The number of vertices is too large."));
+            vertex_offsets[p + 1] = n_global_vertices;
+            cell_offsets[p + 1]   = cell_offsets[p] + sizes[p].second;
+          }
+      }
+
+      std::vector<CoarseCell> local_cells(cells.size());
+      for (unsigned int c = 0; c < cells.size(); ++c)
+        {
+          local_cells[c].id    = cell_offsets[my_rank] + c;
+          local_cells[c].owner = numbers::invalid_subdomain_id;
+          local_cells[c].cell  = cells[c];
+        }
+
+      // 2) compute the centers of the cells given on this process, and the
+      //    bounding box of the centers of all cells
+      std::vector<Point<spacedim>> centers(cells.size());
+      {
+        const auto vertex_indices = internal::collect_vertices(local_cells);
+        const auto points = internal::request_vertices(vertex_indices,
+                                                       vertices,
+                                                       vertex_offsets,
+                                                       comm);
+
+        for (unsigned int c = 0; c < cells.size(); ++c)
+          {
+            for (const unsigned int v : cells[c].vertices)
+              centers[c] += points[std::distance(
+                vertex_indices.begin(),
+                std::lower_bound(vertex_indices.begin(),
+                                 vertex_indices.end(),
+                                 v))];
+            centers[c] /= cells[c].vertices.size();
+          }
+      }
+
+      // store the lower corner in the first entries and the negative of the
+      // upper corner in the last entries, such that a single reduction
+      // suffices
+      std::vector<double> bounds(2 * spacedim,
+                                 std::numeric_limits<double>::max());
+      for (const auto &center : centers)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            bounds[d]            = std::min(bounds[d], center[d]);
+            bounds[spacedim + d] = std::min(bounds[spacedim + d], -center[d]);
+          }
+      dealii::Utilities::MPI::min(bounds, comm, bounds);
+
+      // 3) assign to each cell the index of its center along a Hilbert
+      //    curve in the common bounding box (using at most 63 bits to make
+      //    sure that the packed index fits into a 64-bit integer)
+      {
+        constexpr int       bits_per_dim = 63 / spacedim;
+        const std::uint64_t max_int = (std::uint64_t(1) << bits_per_dim) - 1;
+
+        std::vector<std::array<std::uint64_t, spacedim>> int_points(
+          cells.size());
+        for (unsigned int c = 0; c < cells.size(); ++c)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              const long double extent =
+                static_cast<long double>(-bounds[spacedim + d]) -
+                static_cast<long double>(bounds[d]);
+              const long double v =
+                extent > 0. ? (static_cast<long double>(centers[c][d]) -
+                               static_cast<long double>(bounds[d])) /
+                                extent :
+                              0.;
+              int_points[c][d] = std::min<std::uint64_t>(
+                static_cast<std::uint64_t>(
+                  v * static_cast<long double>(max_int)),
+                max_int);
+            }
+
+        const auto hilbert_indices =
+          dealii::Utilities::inverse_Hilbert_space_filling_curve<spacedim>(
+            int_points, bits_per_dim);
+        for (unsigned int c = 0; c < cells.size(); ++c)
+          local_cells[c].key =
+            dealii::Utilities::pack_integers<spacedim>(hilbert_indices[c],
+                                                       bits_per_dim);
+      }
+
+      const auto compare_along_curve = [](const auto &a, const auto &b) {
+        return std::make_pair(a.key, a.id) < std::make_pair(b.key, b.id);
+      };
+      std::sort(local_cells.begin(), local_cells.end(), compare_along_curve);
+
+      // 4) cut the curve into pieces with the same number of cells: piece
+      //    p ends at the smallest index on the curve such that at least
+      //    (p+1)/n_procs of all cells have an index that is not larger. The
+      //    ends are found by simultaneous bisections over the index space
+      //    of the curve, which need one reduction of the number of cells
+      //    up to the current guesses per step.
+      std::vector<std::uint64_t> piece_ends(n_procs - 1, 0);
+      {
+        const std::uint64_t n_global_cells = cell_offsets[n_procs];
+
+        std::vector<std::uint64_t> target_counts(n_procs - 1);
+        for (unsigned int p = 0; p < n_procs - 1; ++p)
+          target_counts[p] = (n_global_cells / n_procs) * (p + 1) +
+                             (n_global_cells % n_procs) * (p + 1) / n_procs;
+
+        std::vector<std::uint64_t> upper(
+          n_procs - 1, std::numeric_limits<std::uint64_t>::max());
+        std::vector<std::uint64_t> counts(n_procs - 1);
+        while (piece_ends != upper)
+          {
+            for (unsigned int p = 0; p < n_procs - 1; ++p)
+              {
+                const std::uint64_t middle =
+                  piece_ends[p] + (upper[p] - piece_ends[p]) / 2;
+                counts[p] = std::distance(
+                  local_cells.begin(),
+                  std::upper_bound(local_cells.begin(),
+                                   local_cells.end(),
+                                   middle,
+                                   [](const std::uint64_t key,
+                                      const auto         &cell) {
+                                     return key < cell.key;
+                                   }));
+              }
+
+            dealii::Utilities::MPI::sum(counts, comm, counts);
+
+            for (unsigned int p = 0; p < n_procs - 1; ++p)
+              {
+                const std::uint64_t middle =
+                  piece_ends[p] + (upper[p] - piece_ends[p]) / 2;
+                if (counts[p] >= target_counts[p])
+                  upper[p] = middle;
+                else
+                  piece_ends[p] = middle + 1;
+              }
+          }
+      }
+
+      // 5) send the cells to their owners, and number the cells along the
+      //    curve
+      std::vector<CoarseCell> owned_cells;
+      {
+        std::map<unsigned int, std::vector<CoarseCell>> cells_to_send;
+        for (const auto &cell : local_cells)
+          cells_to_send[std::distance(piece_ends.begin(),
+                                      std::lower_bound(piece_ends.begin(),
+                                                       piece_ends.end(),
+                                                       cell.key))]
+            .push_back(cell);
+        local_cells.clear();
+
+        std::vector<unsigned int> targets;
+        for (const auto &target : cells_to_send)
+          targets.push_back(target.first);
+
+        dealii::Utilities::MPI::ConsensusAlgorithms::selector<
+          std::vector<CoarseCell>>(
+          targets,
+          [&](const unsigned int other_rank) {
+            return cells_to_send[other_rank];
+          },
+          [&](const unsigned int, const std::vector<CoarseCell> &request) {
+            owned_cells.insert(owned_cells.end(),
+                               request.begin(),
+                               request.end());
+          },
+          comm);
+
+        std::sort(owned_cells.begin(), owned_cells.end(), compare_along_curve);
+
+        const auto n_owned_cells = dealii::Utilities::MPI::all_gather(
+          comm, static_cast<types::coarse_cell_id>(owned_cells.size()));
+        const types::coarse_cell_id first_id =
+          std::accumulate(n_owned_cells.begin(),
+                          n_owned_cells.begin() + my_rank,
+                          types::coarse_cell_id(0));
+        for (unsigned int c = 0; c < owned_cells.size(); ++c)
+          {
+            owned_cells[c].id    = first_id + c;
+            owned_cells[c].owner = my_rank;
+          }
+      }
+
+      // 6) set up the ghost layer: the processes storing the vertices
+      //    collect which processes own cells adjacent to them, and tell
+      //    every such process about all other processes sharing a vertex
+      //    with it
+      std::vector<CoarseCell> ghost_cells;
+      {
+        const auto owned_vertices = internal::collect_vertices(owned_cells);
+        const auto ranges =
+          internal::split_by_vertex_owner(owned_vertices, vertex_offsets);
+        std::vector<unsigned int> targets;
+        for (const auto &range : ranges)
+          targets.push_back(range.first);
+
+        std::map<unsigned int, std::vector<unsigned int>>
+          vertex_to_adjacent_ranks;
+        dealii::Utilities::MPI::ConsensusAlgorithms::selector<
+          std::vector<unsigned int>>(
+          targets,
+          [&](const unsigned int other_rank) {
+            const auto &range = ranges.at(other_rank);
+            return std::vector<unsigned int>(owned_vertices.begin() +
+                                               range.first,
+                                             owned_vertices.begin() +
+                                               range.second);
+          },
+          [&](const unsigned int               other_rank,
+              const std::vector<unsigned int> &request) {
+            for (const unsigned int v : request)
+              vertex_to_adjacent_ranks[v].push_back(other_rank);
+          },
+          comm);
+
+        using SharedVertices =
+          std::vector<std::pair<unsigned int, std::vector<unsigned int>>>;
+        std::map<unsigned int, SharedVertices> shared_vertices_to_send;
+        for (const auto &vertex : vertex_to_adjacent_ranks)
+          if (vertex.second.size() > 1)
+            for (const unsigned int rank : vertex.second)
+              shared_vertices_to_send[rank].push_back(vertex);
+        vertex_to_adjacent_ranks.clear();
+
+        targets.clear();
+        for (const auto &target : shared_vertices_to_send)
+          targets.push_back(target.first);
+
+        std::map<unsigned int, std::vector<unsigned int>> shared_vertices;
+        dealii::Utilities::MPI::ConsensusAlgorithms::selector<SharedVertices>(
+          targets,
+          [&](const unsigned int other_rank) {
+            return shared_vertices_to_send[other_rank];
+          },
+          [&](const unsigned int, const SharedVertices &request) {
+            for (const auto &vertex : request)
+              shared_vertices.insert(vertex);
+          },
+          comm);
+
+        // send each locally owned cell to all other processes owning a
+        // cell that shares a vertex with it
+        std::map<unsigned int, std::vector<CoarseCell>> cells_to_send;
+        for (const auto &cell : owned_cells)
+          {
+            std::set<unsigned int> adjacent_ranks;
+            for (const unsigned int v : cell.cell.vertices)
+              {
+                const auto shared_vertex = shared_vertices.find(v);
+                if (shared_vertex != shared_vertices.end())
+                  adjacent_ranks.insert(shared_vertex->second.begin(),
+                                        shared_vertex->second.end());
+              }
+            adjacent_ranks.erase(my_rank);
+
+            for (const unsigned int rank : adjacent_ranks)
+              cells_to_send[rank].push_back(cell);
+          }
+
+        targets.clear();
+        for (const auto &target : cells_to_send)
+          targets.push_back(target.first);
+
+        dealii::Utilities::MPI::ConsensusAlgorithms::selector<
+          std::vector<CoarseCell>>(
+          targets,
+          [&](const unsigned int other_rank) {
+            return cells_to_send[other_rank];
+          },
+          [&](const unsigned int, const std::vector<CoarseCell> &request) {
+            ghost_cells.insert(ghost_cells.end(),
+                               request.begin(),
+                               request.end());
+          },
+          comm);
+      }
+
+      // the locally relevant cells, sorted by their coarse-cell id
+      std::vector<CoarseCell> relevant_cells = std::move(owned_cells);
+      relevant_cells.insert(relevant_cells.end(),
+                            ghost_cells.begin(),
+                            ghost_cells.end());
+      ghost_cells.clear();
+      std::sort(relevant_cells.begin(),
+                relevant_cells.end(),
+                [](const auto &a, const auto &b) { return a.id < b.id; });
+
+      // 7) collect the boundary ids and manifold ids of the faces and lines
+      //    of the locally relevant cells: the objects given in the subcell
+      //    data are sent to the process storing their first vertex, where
+      //    they are requested by the processes that need them
+      std::map<std::vector<unsigned int>,
+               std::pair<types::boundary_id, types::manifold_id>>
+        relevant_sub_cell_objects;
+      if (dim > 1)
+        {
+          using SubCellObjects =
+            std::vector<internal::DistributedSubCellObject>;
+          std::map<unsigned int, SubCellObjects> objects_to_send;
+          const auto add_object = [&](const auto &object) {
+            internal::DistributedSubCellObject sub_cell_object;
+            sub_cell_object.vertices = object.vertices;
+            std::sort(sub_cell_object.vertices.begin(),
+                      sub_cell_object.vertices.end());
+            sub_cell_object.boundary_id = object.boundary_id;
+            sub_cell_object.manifold_id = object.manifold_id;
+            const unsigned int owner = internal::vertex_owner(
+              vertex_offsets, sub_cell_object.vertices[0]);
+            objects_to_send[owner].push_back(sub_cell_object);
+          };
+          for (const auto &line : subcell_data.boundary_lines)
+            add_object(line);
+          for (const auto &quad : subcell_data.boundary_quads)
+            add_object(quad);
+
+          std::vector<unsigned int> targets;
+          for (const auto &target : objects_to_send)
+            targets.push_back(target.first);
+
+          std::map<std::vector<unsigned int>,
+                   std::pair<types::boundary_id, types::manifold_id>>
+            stored_sub_cell_objects;
+          dealii::Utilities::MPI::ConsensusAlgorithms::selector<SubCellObjects>(
+            targets,
+            [&](const unsigned int other_rank) {
+              return objects_to_send[other_rank];
+            },
+            [&](const unsigned int, const SubCellObjects &request) {
+              for (const auto &object : request)
+                stored_sub_cell_objects[object.vertices] = {
+                  object.boundary_id, object.manifold_id};
+            },
+            comm);
+          objects_to_send.clear();
+
+          std::map<unsigned int, std::vector<std::vector<unsigned int>>>
+            keys_to_request;
+          {
+            std::set<std::vector<unsigned int>> keys;
+            for (const auto &cell : relevant_cells)
+              for (const auto &key : internal::sub_cell_object_keys(cell.cell))
+                keys.insert(key);
+            for (const auto &key : keys)
+              keys_to_request[internal::vertex_owner(vertex_offsets, key[0])]
+                .push_back(key);
+          }
+
+          targets.clear();
+          for (const auto &target : keys_to_request)
+            targets.push_back(target.first);
+
+          dealii::Utilities::MPI::ConsensusAlgorithms::selector<
+            std::vector<std::vector<unsigned int>>,
+            std::vector<std::pair<types::boundary_id, types::manifold_id>>>(
+            targets,
+            [&](const unsigned int other_rank) {
+              return keys_to_request[other_rank];
+            },
+            [&](const unsigned int,
+                const std::vector<std::vector<unsigned int>> &request) {
+              std::vector<std::pair<types::boundary_id, types::manifold_id>>
+                answer;
+              answer.reserve(request.size());
+              for (const auto &key : request)
+                {
+                  const auto object = stored_sub_cell_objects.find(key);
+                  if (object != stored_sub_cell_objects.end())
+                    answer.push_back(object->second);
+                  else
+                    answer.emplace_back(numbers::internal_face_boundary_id,
+                                        numbers::flat_manifold_id);
+                }
+              return answer;
+            },
+            [&](const unsigned int other_rank,
+                const std::vector<
+                  std::pair<types::boundary_id, types::manifold_id>> &answer) {
+              const auto &keys = keys_to_request[other_rank];
+              AssertDimension(answer.size(), keys.size());
+              for (unsigned int i = 0; i < keys.size(); ++i)
+                relevant_sub_cell_objects[keys[i]] = answer[i];
+            },
+            comm);
+        }
+
+      // 8) fill the description with the locally relevant cells and their
+      //    vertices, which are requested from the processes storing them
+      Description<dim, spacedim> description;
+      description.comm      = comm;
+      description.settings  = settings;
+      description.smoothing = smoothing;
+      description.cell_infos.resize(1);
+
+      const bool construct_multigrid =
+        (settings &
+         TriangulationDescription::Settings::construct_multigrid_hierarchy) !=
+        0u;
+
+      const auto relevant_vertices = internal::collect_vertices(relevant_cells);
+      description.coarse_cell_vertices =
+        internal::request_vertices(relevant_vertices,
+                                   vertices,
+                                   vertex_offsets,
+                                   comm);
+
+      for (const auto &cell : relevant_cells)
+        {
+          dealii::CellData<dim> coarse_cell = cell.cell;
+          for (unsigned int &v : coarse_cell.vertices)
+            v = std::distance(relevant_vertices.begin(),
+                              std::lower_bound(relevant_vertices.begin(),
+                                               relevant_vertices.end(),
+                                               v));
+          description.coarse_cells.push_back(coarse_cell);
+          description.coarse_cell_index_to_coarse_cell_id.push_back(cell.id);
+
+          CellData<dim> cell_info;
+          cell_info.id = CellId(cell.id, std::vector<std::uint8_t>())
+                           .template to_binary<dim>();
+          cell_info.subdomain_id       = cell.owner;
+          cell_info.level_subdomain_id = construct_multigrid ?
+                                           cell.owner :
+                                           numbers::artificial_subdomain_id;
+          cell_info.manifold_id        = cell.cell.manifold_id;
+          std::fill(cell_info.manifold_line_ids.begin(),
+                    cell_info.manifold_line_ids.end(),
+                    numbers::flat_manifold_id);
+          std::fill(cell_info.manifold_quad_ids.begin(),
+                    cell_info.manifold_quad_ids.end(),
+                    numbers::flat_manifold_id);
+
+          // the keys are ordered as the faces, followed by the lines in 3d
+          const auto         keys = internal::sub_cell_object_keys(cell.cell);
+          const unsigned int n_faces =
+            ReferenceCell::n_vertices_to_type(dim, cell.cell.vertices.size())
+              .n_faces();
+          for (unsigned int i = 0; i < keys.size(); ++i)
+            {
+              const auto &object = relevant_sub_cell_objects.at(keys[i]);
+              if (i >= n_faces)
+                cell_info.manifold_line_ids[i - n_faces] = object.second;
+              else
+                {
+                  if (object.first != numbers::internal_face_boundary_id)
+                    cell_info.boundary_ids.emplace_back(i, object.first);
+                  if (dim == 2)
+                    cell_info.manifold_line_ids[i] = object.second;
+                  else
+                    cell_info.manifold_quad_ids[i] = object.second;
+                }
+            }
+
+          description.cell_infos[0].push_back(cell_info);
+        }
+
+      return description;
+    }
+
   } // namespace Utilities
 } // namespace TriangulationDescription
 
@@ -444,7 +444,8 @@ DynamicSparsityPattern::get_view(const IndexSet &rows) const
         rowset.size() == 0 ? *it : rowset.index_within_set(*it);
 
       view.lines[view_row].entries = lines[rowindex].entries;
-      view.have_entries |= (lines[rowindex].entries.size() > 0);
+      if (lines[rowindex].entries.size() > 0)
+        view.have_entries = true;
     }
   return view;
 }
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
@@ -479,7 +480,10 @@ SparsityPattern::copy_from(const SparsityPattern &sp)
 // the column_number method to gain faster access to the
 // entries. DynamicSparsityPattern::iterator can show quadratic complexity in
 // case many rows are empty and the begin() method needs to jump to the next
-// free row. Otherwise, the code is exactly the same as above.
+// free row. Otherwise, the code is exactly the same as above, except that
+// the rows of the DynamicSparsityPattern, which are stored independently of
+// each other, are processed in parallel. The only serial part is the prefix
+// sum over the row lengths in reinit().
 void
 SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
 {
@@ -488,20 +492,13 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
 
   std::vector<unsigned int> row_lengths(dsp.n_rows());
 
-  if (row_index_set.size() == 0)
-    {
-      for (size_type i = 0; i < dsp.n_rows(); ++i)
+  parallel::apply_to_subranges(
+    size_type(0),
+    dsp.n_rows(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type i = begin; i < end; ++i)
         {
-          row_lengths[i] = dsp.row_length(i);
-          if (do_diag_optimize && !dsp.exists(i, i))
-            ++row_lengths[i];
-        }
-    }
-  else
-    {
-      for (size_type i = 0; i < dsp.n_rows(); ++i)
-        {
-          if (row_index_set.is_element(i))
+          if (row_index_set.size() == 0 || row_index_set.is_element(i))
             {
               row_lengths[i] = dsp.row_length(i);
               if (do_diag_optimize && !dsp.exists(i, i))
@@ -516,21 +513,29 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
               row_lengths[i] = do_diag_optimize ? 1 : 0;
             }
         }
-    }
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
   reinit(dsp.n_rows(), dsp.n_cols(), row_lengths);
 
   if (n_rows() != 0 && n_cols() != 0)
-    for (size_type row = 0; row < dsp.n_rows(); ++row)
-      {
-        size_type *cols = &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
-        const unsigned int row_length = dsp.row_length(row);
-        for (unsigned int index = 0; index < row_length; ++index)
+    parallel::apply_to_subranges(
+      size_type(0),
+      dsp.n_rows(),
+      [&](const size_type begin, const size_type end) {
+        for (size_type row = begin; row < end; ++row)
           {
-            const size_type col = dsp.column_number(row, index);
-            if ((col != row) || !do_diag_optimize)
-              *cols++ = col;
+            size_type *cols =
+              &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
+            const unsigned int row_length = dsp.row_length(row);
+            for (unsigned int index = 0; index < row_length; ++index)
+              {
+                const size_type col = dsp.column_number(row, index);
+                if ((col != row) || !do_diag_optimize)
+                  *cols++ = col;
+              }
           }
-      }
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
 
   // do not need to compress the sparsity pattern since we already have
   // allocated the right amount of data, and the SparsityPatternType data is
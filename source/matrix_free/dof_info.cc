@@ -75,6 +75,8 @@ namespace internal
       cell_active_fe_index.clear();
       max_fe_index = 0;
       fe_index_conversion.clear();
+      cell_ghost_target_list_index.clear();
+      cell_ghost_target_list.clear();
     }
 
 
@@ -1534,6 +1536,9 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(row_starts_plain_indices);
       memory += MemoryConsumption::memory_consumption(plain_dof_indices);
       memory += MemoryConsumption::memory_consumption(constraint_indicator);
+      memory +=
+        MemoryConsumption::memory_consumption(cell_ghost_target_list_index);
+      memory += MemoryConsumption::memory_consumption(cell_ghost_target_list);
       memory += MemoryConsumption::memory_consumption(*vector_partitioner);
       return memory;
     }
@@ -1623,6 +1628,32 @@ namespace internal
       const TaskInfo &,
       const std::vector<FaceToCellTopology<16>> &);
 
+    template void
+    DoFInfo::compute_ghost_target_access_pattern<1>(
+      const TaskInfo &,
+      const std::vector<DoFInfo> &,
+      const FaceInfo<1> &);
+    template void
+    DoFInfo::compute_ghost_target_access_pattern<2>(
+      const TaskInfo &,
+      const std::vector<DoFInfo> &,
+      const FaceInfo<2> &);
+    template void
+    DoFInfo::compute_ghost_target_access_pattern<4>(
+      const TaskInfo &,
+      const std::vector<DoFInfo> &,
+      const FaceInfo<4> &);
+    template void
+    DoFInfo::compute_ghost_target_access_pattern<8>(
+      const TaskInfo &,
+      const std::vector<DoFInfo> &,
+      const FaceInfo<8> &);
+    template void
+    DoFInfo::compute_ghost_target_access_pattern<16>(
+      const TaskInfo &,
+      const std::vector<DoFInfo> &,
+      const FaceInfo<16> &);
+
     template void
     DoFInfo::print_memory_consumption<std::ostream>(std::ostream &,
                                                     const TaskInfo &) const;
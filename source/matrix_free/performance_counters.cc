@@ -0,0 +1,326 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/thread_local_storage.h>
+
+#include <deal.II/matrix_free/performance_counters.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  using PhaseArray =
+    std::array<MatrixFreeTools::PerformanceCounters::PhaseData,
+               MatrixFreeTools::PerformanceCounters::n_phases>;
+
+  /**
+   * The global state of the performance counters: the counters of each
+   * thread, and a list of the counters of all threads that have ever
+   * collected data, used to sum up the counters.
+   */
+  struct CounterStorage
+  {
+    Threads::ThreadLocalStorage<std::shared_ptr<PhaseArray>> thread_data;
+    std::vector<std::shared_ptr<PhaseArray>>                 all_data;
+    std::mutex                                               mutex;
+  };
+
+  CounterStorage &
+  get_counter_storage()
+  {
+    static CounterStorage storage;
+    return storage;
+  }
+} // namespace
+
+
+
+namespace MatrixFreeTools
+{
+  namespace PerformanceCounters
+  {
+    void
+    enable()
+    {
+      internal::MatrixFreeFunctions::performance_counters_enabled = true;
+    }
+
+
+
+    void
+    disable()
+    {
+      internal::MatrixFreeFunctions::performance_counters_enabled = false;
+    }
+
+
+
+    void
+    reset()
+    {
+      CounterStorage             &storage = get_counter_storage();
+      std::lock_guard<std::mutex> lock(storage.mutex);
+      for (const auto &data : storage.all_data)
+        *data = PhaseArray();
+    }
+
+
+
+    std::array<PhaseData, n_phases>
+    get_data()
+    {
+      CounterStorage             &storage = get_counter_storage();
+      std::lock_guard<std::mutex> lock(storage.mutex);
+      PhaseArray                  sum;
+      for (const auto &data : storage.all_data)
+        for (unsigned int p = 0; p < n_phases; ++p)
+          {
+            sum[p].n_calls += (*data)[p].n_calls;
+            sum[p].flops += (*data)[p].flops;
+            sum[p].bytes += (*data)[p].bytes;
+            sum[p].time += (*data)[p].time;
+          }
+      return sum;
+    }
+
+
+
+    std::string
+    get_phase_name(const Phase phase)
+    {
+      switch (phase)
+        {
+          case Phase::reinit:
+            return "reinit";
+          case Phase::read_dof_values:
+            return "read_dof_values";
+          case Phase::evaluate:
+            return "evaluate";
+          case Phase::integrate:
+            return "integrate";
+          case Phase::distribute_local_to_global:
+            return "distribute_local_to_global";
+          case Phase::loop:
+            return "loop";
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+      return "";
+    }
+
+
+
+    void
+    print_report(std::ostream &out,
+                 const double  peak_gflops,
+                 const double  peak_gbytes_per_second)
+    {
+      AssertThrow(peak_gflops > 0 && peak_gbytes_per_second > 0,
+                  ExcMessage("The peak performance numbers must be positive."));
+
+      const PhaseArray data = get_data();
+
+      // the phases of the kernels, summed up; the loop phase contains the
+      // time of the complete loops instead
+      PhaseData kernels;
+      for (unsigned int p = 0; p < static_cast<unsigned int>(Phase::loop); ++p)
+        {
+          kernels.n_calls += data[p].n_calls;
+          kernels.flops += data[p].flops;
+          kernels.bytes += data[p].bytes;
+          kernels.time += data[p].time;
+        }
+
+      const std::uint64_t n_loops =
+        data[static_cast<unsigned int>(Phase::loop)].n_calls;
+      const double machine_balance = peak_gflops / peak_gbytes_per_second;
+
+      const std::ios_base::fmtflags old_flags     = out.flags();
+      const std::streamsize         old_precision = out.precision();
+
+      out << "Matrix-free performance counters for " << n_loops
+          << " loops, machine balance " << std::setprecision(3)
+          << machine_balance << " Flop/B (" << peak_gflops << " GFlop/s, "
+          << peak_gbytes_per_second << " GB/s)" << std::endl;
+      out << std::left << std::setw(28) << "phase" << std::right
+          << std::setw(12) << "calls" << std::setw(12) << "GFlop/loop"
+          << std::setw(12) << "GB/loop" << std::setw(12) << "time/loop"
+          << std::setw(10) << "GFlop/s" << std::setw(10) << "GB/s"
+          << std::setw(10) << "Flop/B" << std::setw(16) << "bound"
+          << std::setw(10) << "% peak" << std::endl;
+
+      const auto print_line = [&](const std::string &name,
+                                  const PhaseData   &phase_data) {
+        const double per_loop = n_loops > 0 ? 1. / n_loops : 1.;
+        const double gflops_per_second =
+          phase_data.time > 0 ? 1e-9 * phase_data.flops / phase_data.time : 0.;
+        const double gbytes_per_second =
+          phase_data.time > 0 ? 1e-9 * phase_data.bytes / phase_data.time : 0.;
+
+        out << std::left << std::setw(28) << name << std::right
+            << std::setw(12) << phase_data.n_calls << std::scientific
+            << std::setprecision(3) << std::setw(12)
+            << 1e-9 * phase_data.flops * per_loop << std::setw(12)
+            << 1e-9 * phase_data.bytes * per_loop << std::setw(12)
+            << phase_data.time * per_loop << std::fixed << std::setprecision(1)
+            << std::setw(10) << gflops_per_second << std::setw(10)
+            << gbytes_per_second;
+
+        // classify according to the roofline model: the attainable
+        // performance is the minimum of the peak arithmetic throughput and
+        // the product of the arithmetic intensity with the peak bandwidth
+        if (phase_data.flops > 0 && phase_data.bytes > 0)
+          {
+            const double intensity = phase_data.flops / phase_data.bytes;
+            const double attainable =
+              std::min(peak_gflops, intensity * peak_gbytes_per_second);
+            out << std::setprecision(2) << std::setw(10) << intensity
+                << std::setw(16)
+                << (intensity > machine_balance ? "compute" : "memory")
+                << std::setprecision(1) << std::setw(10)
+                << 100. * gflops_per_second / attainable;
+          }
+        else if (phase_data.flops > 0)
+          out << std::setw(10) << "-" << std::setw(16) << "compute"
+              << std::setprecision(1) << std::setw(10)
+              << 100. * gflops_per_second / peak_gflops;
+        else if (phase_data.bytes > 0)
+          out << std::setw(10) << "0" << std::setw(16) << "memory"
+              << std::setprecision(1) << std::setw(10)
+              << 100. * gbytes_per_second / peak_gbytes_per_second;
+        else
+          out << std::setw(10) << "-" << std::setw(16) << "-" << std::setw(10)
+              << "-";
+        out << std::endl;
+      };
+
+      for (unsigned int p = 0; p < n_phases; ++p)
+        print_line(get_phase_name(static_cast<Phase>(p)), data[p]);
+      print_line("sum of kernels", kernels);
+
+      out.flags(old_flags);
+      out.precision(old_precision);
+    }
+  } // namespace PerformanceCounters
+} // namespace MatrixFreeTools
+
+
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    void
+    add_to_performance_counters(
+      const MatrixFreeTools::PerformanceCounters::Phase phase,
+      const double                                      flops,
+      const double                                      bytes,
+      const double                                      time)
+    {
+      CounterStorage &storage = get_counter_storage();
+
+      bool                         exists = false;
+      std::shared_ptr<PhaseArray> &data   = storage.thread_data.get(exists);
+      if (!exists || data == nullptr)
+        {
+          data = std::make_shared<PhaseArray>();
+          std::lock_guard<std::mutex> lock(storage.mutex);
+          storage.all_data.push_back(data);
+        }
+
+      auto &phase_data = (*data)[static_cast<unsigned int>(phase)];
+      ++phase_data.n_calls;
+      phase_data.flops += flops;
+      phase_data.bytes += bytes;
+      phase_data.time += time;
+    }
+
+
+
+    double
+    estimate_cell_evaluation_flops(
+      const unsigned int                     dim,
+      const unsigned int                     n_components,
+      const unsigned int                     element_type,
+      const unsigned int                     n_dofs_1d,
+      const unsigned int                     n_q_points_1d,
+      const unsigned int                     dofs_per_component,
+      const unsigned int                     n_q_points,
+      const EvaluationFlags::EvaluationFlags evaluation_flag)
+    {
+      const bool need_values = evaluation_flag & EvaluationFlags::values;
+      const bool need_gradients =
+        evaluation_flag & EvaluationFlags::gradients;
+      const bool need_hessians = evaluation_flag & EvaluationFlags::hessians;
+      const unsigned int n_second_derivatives = dim * (dim + 1) / 2;
+
+      double flops = 0;
+      if (element_type < ElementType::tensor_raviart_thomas)
+        {
+          // interpolation from the coefficients to the quadrature points,
+          // one direction at a time, which is skipped for collocation
+          if ((need_values || need_gradients || need_hessians) &&
+              element_type != ElementType::tensor_symmetric_collocation)
+            {
+              double size_of_other_directions = 1.;
+              for (unsigned int d = 1; d < dim; ++d)
+                size_of_other_directions *= n_dofs_1d;
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  flops += 2. * n_dofs_1d * n_q_points_1d *
+                           size_of_other_directions;
+                  if (d + 1 < dim)
+                    size_of_other_directions *=
+                      static_cast<double>(n_q_points_1d) / n_dofs_1d;
+                }
+            }
+
+          // derivatives with the collocation derivative matrix in each
+          // direction on the quadrature points
+          const double derivative_pass = 2. * n_q_points_1d * n_q_points;
+          if (need_gradients)
+            flops += dim * derivative_pass;
+          if (need_hessians)
+            flops += n_second_derivatives * derivative_pass;
+        }
+      else
+        {
+          // dense evaluation with the matrix of all shape functions
+          const double dense_pass = 2. * dofs_per_component * n_q_points;
+          if (need_values)
+            flops += dense_pass;
+          if (need_gradients)
+            flops += dim * dense_pass;
+          if (need_hessians)
+            flops += n_second_derivatives * dense_pass;
+        }
+
+      return n_components * flops;
+    }
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
+
+DEAL_II_NAMESPACE_CLOSE
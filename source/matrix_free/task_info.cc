@@ -23,6 +23,7 @@
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 
+#include <deal.II/matrix_free/performance_counters.h>
 #include <deal.II/matrix_free/task_info.h>
 #include <deal.II/matrix_free/util.h>
 
@@ -350,6 +351,9 @@ namespace internal
     void
     TaskInfo::loop(MFWorkerInterface &funct) const
     {
+      PerformanceCounterScope counter(
+        MatrixFreeTools::PerformanceCounters::Phase::loop);
+
       // If we use thread parallelism, we do not currently support to schedule
       // pieces of updates within the loop, so this index will collect all
       // calls in that case and work like a single complete loop over all
@@ -610,7 +614,41 @@ namespace internal
                ++part)
             {
               if (part == 1)
-                funct.vector_update_ghosts_finish();
+                {
+                  // the cells of the second part access ghost data, so let
+                  // the worker interleave the cell work with the arrival of
+                  // the data from the individual processes, and run the work
+                  // on faces afterwards
+                  for (unsigned int i = partition_row_index[part];
+                       i < partition_row_index[part + 1];
+                       ++i)
+                    {
+                      funct.cell_loop_pre_range(i);
+                      funct.zero_dst_vector_range(i);
+                    }
+
+                  funct.vector_update_ghosts_finish_and_cell(
+                    partition_row_index[part], partition_row_index[part + 1]);
+
+                  for (unsigned int i = partition_row_index[part];
+                       i < partition_row_index[part + 1];
+                       ++i)
+                    {
+                      if (face_partition_data.empty() == false)
+                        {
+                          if (face_partition_data[i + 1] >
+                              face_partition_data[i])
+                            funct.face(i);
+                          if (boundary_partition_data[i + 1] >
+                              boundary_partition_data[i])
+                            funct.boundary(i);
+                        }
+                      funct.cell_loop_post_range(i);
+                    }
+
+                  funct.vector_compress_start();
+                  continue;
+                }
 
               for (unsigned int i = partition_row_index[part];
                    i < partition_row_index[part + 1];
@@ -634,9 +672,6 @@ namespace internal
                     }
                   funct.cell_loop_post_range(i);
                 }
-
-              if (part == 1)
-                funct.vector_compress_start();
             }
         }
       funct.vector_compress_finish();
@@ -37,6 +37,16 @@ namespace internal
   {
     namespace VectorDataExchange
     {
+      unsigned int
+      Base::export_to_ghosted_array_finish_any(
+        std::vector<MPI_Request> &requests) const
+      {
+        (void)requests;
+        return numbers::invalid_unsigned_int;
+      }
+
+
+
       PartitionerWrapper::PartitionerWrapper(
         const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
         : partitioner(partitioner)
@@ -306,6 +316,33 @@ namespace internal
 
 
 
+      unsigned int
+      PartitionerWrapper::export_to_ghosted_array_finish_any(
+        std::vector<MPI_Request> &requests) const
+      {
+#ifndef DEAL_II_WITH_MPI
+        (void)requests;
+#else
+        // the receive requests are stored before the send requests
+        const unsigned int n_ghost_targets =
+          partitioner->ghost_targets().size();
+        if (n_ghost_targets > 0 && requests.size() >= n_ghost_targets)
+          {
+            int       index = MPI_UNDEFINED;
+            const int ierr  = MPI_Waitany(n_ghost_targets,
+                                         requests.data(),
+                                         &index,
+                                         MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+            if (index != MPI_UNDEFINED)
+              return index;
+          }
+#endif
+        return numbers::invalid_unsigned_int;
+      }
+
+
+
       template <typename Number>
       void
       PartitionerWrapper::reset_ghost_values_impl(
@@ -0,0 +1,119 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check operator& and subtract_set for index sets with many intervals, where
+// the intersection is split among several threads, as well as the
+// constructor from a vector of indices. compare against the result of the
+// same operations on sorted vectors of indices
+
+#include <deal.II/base/index_set.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "../tests.h"
+
+
+std::vector<types::global_dof_index>
+random_indices(const types::global_dof_index size, const unsigned int stride)
+{
+  std::vector<types::global_dof_index> indices;
+  for (types::global_dof_index i = 0; i < size; ++i)
+    if (Testing::rand() % stride == 0)
+      indices.push_back(i);
+  return indices;
+}
+
+
+
+void
+test(const unsigned int stride_1, const unsigned int stride_2)
+{
+  const types::global_dof_index size = 200000;
+
+  const std::vector<types::global_dof_index> indices_1 =
+    random_indices(size, stride_1);
+  const std::vector<types::global_dof_index> indices_2 =
+    random_indices(size, stride_2);
+
+  const IndexSet set_1(size, indices_1);
+  const IndexSet set_2(size, indices_2);
+  AssertDimension(set_1.n_elements(), indices_1.size());
+  AssertDimension(set_2.n_elements(), indices_2.size());
+
+  std::vector<types::global_dof_index> intersection, difference;
+  std::set_intersection(indices_1.begin(),
+                        indices_1.end(),
+                        indices_2.begin(),
+                        indices_2.end(),
+                        std::back_inserter(intersection));
+  std::set_difference(indices_1.begin(),
+                      indices_1.end(),
+                      indices_2.begin(),
+                      indices_2.end(),
+                      std::back_inserter(difference));
+
+  const IndexSet set_intersection = set_1 & set_2;
+  IndexSet       set_difference   = set_1;
+  set_difference.subtract_set(set_2);
+
+  deallog << "strides " << stride_1 << ' ' << stride_2
+          << ": intervals " << (set_1.n_intervals() > 8192 ? "many" : "few")
+          << ' ' << (set_2.n_intervals() > 8192 ? "many" : "few") << std::endl;
+  deallog << "intersection "
+          << (set_intersection.get_index_vector() == intersection ? "OK" :
+                                                                    "FAILED")
+          << std::endl;
+  deallog << "intersection commutes "
+          << ((set_2 & set_1) == set_intersection ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "difference "
+          << (set_difference.get_index_vector() == difference ? "OK" :
+                                                                "FAILED")
+          << std::endl;
+  deallog << "index_within_set "
+          << (set_intersection.is_empty() ||
+                  set_1.index_within_set(set_intersection.nth_index_in_set(
+                    0)) == static_cast<types::global_dof_index>(
+                             std::lower_bound(indices_1.begin(),
+                                              indices_1.end(),
+                                              intersection[0]) -
+                             indices_1.begin()) ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // two sets with many intervals each
+  test(2, 3);
+  test(3, 2);
+
+  // one set with many intervals and one with few intervals
+  test(2, 1000);
+  test(1000, 2);
+
+  // contiguous set against a set with many intervals
+  test(1, 4);
+}
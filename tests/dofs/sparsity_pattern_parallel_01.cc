@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that DoFTools::make_sparsity_pattern, which fills the rows of a
+// DynamicSparsityPattern with several threads, and SparsityPattern::copy_from
+// give the same result as with a single thread, for a mesh with hanging node
+// constraints and for a DynamicSparsityPattern that only stores some rows
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+make_pattern(const DoFHandler<dim>           &dof_handler,
+             const AffineConstraints<double> &constraints,
+             const bool                       keep_constrained_dofs,
+             const IndexSet                  &stored_rows,
+             const unsigned int               n_threads,
+             SparsityPattern                 &sparsity)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs(),
+                             dof_handler.n_dofs(),
+                             stored_rows);
+  DoFTools::make_sparsity_pattern(dof_handler,
+                                  dsp,
+                                  constraints,
+                                  keep_constrained_dofs);
+  sparsity.copy_from(dsp);
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(6 - dim);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  IndexSet some_rows(dof_handler.n_dofs());
+  some_rows.add_range(dof_handler.n_dofs() / 5, dof_handler.n_dofs() / 2);
+  some_rows.add_range(2 * dof_handler.n_dofs() / 3, dof_handler.n_dofs());
+
+  for (const bool keep_constrained_dofs : {true, false})
+    for (const IndexSet &stored_rows : {IndexSet(), some_rows})
+      {
+        SparsityPattern serial, parallel;
+        make_pattern(dof_handler,
+                     constraints,
+                     keep_constrained_dofs,
+                     stored_rows,
+                     1,
+                     serial);
+        make_pattern(dof_handler,
+                     constraints,
+                     keep_constrained_dofs,
+                     stored_rows,
+                     testing_max_num_threads(),
+                     parallel);
+
+        bool identical = serial.n_nonzero_elements() ==
+                           parallel.n_nonzero_elements() &&
+                         serial.n_nonzero_elements() > dof_handler.n_dofs();
+        for (unsigned int row = 0; identical && row < serial.n_rows(); ++row)
+          {
+            if (serial.row_length(row) != parallel.row_length(row))
+              identical = false;
+            for (unsigned int i = 0; identical && i < serial.row_length(row);
+                 ++i)
+              if (serial.column_number(row, i) !=
+                  parallel.column_number(row, i))
+                identical = false;
+          }
+
+        deallog << "dim=" << dim
+                << ", keep_constrained_dofs=" << keep_constrained_dofs
+                << ", all rows stored=" << (stored_rows.size() == 0) << ": "
+                << (identical ? "identical" : "different") << std::endl;
+      }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // use small row ranges to get many row ranges per thread also for the
+  // small meshes of this test
+  internal::SparseMatrixImplementation::minimum_parallel_grain_size = 8;
+
+  test<2>();
+  test<3>();
+}
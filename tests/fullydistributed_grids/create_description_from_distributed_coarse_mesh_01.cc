@@ -0,0 +1,200 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Create a parallel::fullydistributed::Triangulation from a coarse mesh of
+// which each process only knows a slice of the vertices, of the cells, and
+// of the boundary information, via
+// TriangulationDescription::Utilities::create_description_from_distributed_coarse_mesh(),
+// and compare it with the serial coarse mesh.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <numeric>
+
+#include "../tests.h"
+
+
+template <int dim>
+typename Triangulation<dim>::active_cell_iterator
+find_cell(const Triangulation<dim> &tria, const Point<dim> &center)
+{
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().distance(center) < 1e-10)
+      return cell;
+  return tria.end();
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n_subdivisions, const MPI_Comm comm)
+{
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+  Triangulation<dim> basetria;
+  GridGenerator::subdivided_hyper_cube(basetria, n_subdivisions, 0, 1, true);
+  for (const auto &cell : basetria.active_cell_iterators())
+    {
+      cell->set_material_id(cell->active_cell_index() % 3);
+      for (const auto &face : cell->face_iterators())
+        if (face->at_boundary() && face->center()[0] > 0.5)
+          face->set_manifold_id(1);
+    }
+
+  // give each process a slice of the vertices, and distribute the cells and
+  // the boundary information in a round-robin fashion
+  const auto [vertices, cells, subcell_data] =
+    GridTools::get_coarse_mesh_description(basetria);
+
+  std::vector<Point<dim>> local_vertices(
+    vertices.begin() + vertices.size() * my_rank / n_procs,
+    vertices.begin() + vertices.size() * (my_rank + 1) / n_procs);
+
+  std::vector<CellData<dim>> local_cells;
+  for (unsigned int c = my_rank; c < cells.size(); c += n_procs)
+    local_cells.push_back(cells[c]);
+
+  SubCellData local_subcell_data;
+  for (unsigned int i = 0; i < subcell_data.boundary_lines.size(); ++i)
+    if (i % n_procs == (my_rank + 1) % n_procs)
+      local_subcell_data.boundary_lines.push_back(
+        subcell_data.boundary_lines[i]);
+  for (unsigned int i = 0; i < subcell_data.boundary_quads.size(); ++i)
+    if (i % n_procs == (my_rank + 1) % n_procs)
+      local_subcell_data.boundary_quads.push_back(
+        subcell_data.boundary_quads[i]);
+
+  const auto description = TriangulationDescription::Utilities::
+    create_description_from_distributed_coarse_mesh<dim, dim>(
+      local_vertices, local_cells, local_subcell_data, comm);
+
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.create_triangulation(description);
+
+  deallog << "n_global_active_cells: " << tria.n_global_active_cells()
+          << std::endl;
+
+  const unsigned int n_owned_cells = tria.n_locally_owned_active_cells();
+  deallog << "balanced: "
+          << (Utilities::MPI::max(n_owned_cells, comm) -
+                    Utilities::MPI::min(n_owned_cells, comm) <=
+                  1 ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  // all locally relevant cells must match the cells of the serial mesh, and
+  // the locally owned cells also in their faces
+  bool cells_match = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      if (cell->is_artificial())
+        continue;
+
+      const auto base_cell = find_cell(basetria, cell->center());
+      if (base_cell == basetria.end() ||
+          base_cell->material_id() != cell->material_id())
+        {
+          cells_match = false;
+          continue;
+        }
+
+      if (cell->is_locally_owned())
+        for (const unsigned int f : cell->face_indices())
+          if (base_cell->face(f)->at_boundary() !=
+                cell->face(f)->at_boundary() ||
+              base_cell->face(f)->boundary_id() !=
+                cell->face(f)->boundary_id() ||
+              base_cell->face(f)->manifold_id() !=
+                cell->face(f)->manifold_id())
+            cells_match = false;
+    }
+  deallog << "cells match: " << (cells_match ? "yes" : "no") << std::endl;
+
+  // all cells of the serial mesh sharing a vertex with a locally owned cell
+  // must be present
+  const auto vertex_to_cells = GridTools::vertex_to_cell_map(basetria);
+  bool       ghost_layer_complete = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const auto base_cell = find_cell(basetria, cell->center());
+        if (base_cell == basetria.end())
+          continue;
+        for (const unsigned int v : base_cell->vertex_indices())
+          for (const auto &neighbor :
+               vertex_to_cells[base_cell->vertex_index(v)])
+            {
+              const auto local_neighbor = find_cell(tria, neighbor->center());
+              if (local_neighbor == tria.end() ||
+                  local_neighbor->is_artificial())
+                ghost_layer_complete = false;
+            }
+      }
+  deallog << "ghost layer complete: " << (ghost_layer_complete ? "yes" : "no")
+          << std::endl;
+
+  // the coarse-cell ids of the locally owned cells form a contiguous range,
+  // and the ranges of the processes follow each other
+  std::vector<types::coarse_cell_id> owned_ids;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      owned_ids.push_back(cell->id().get_coarse_cell_id());
+  std::sort(owned_ids.begin(), owned_ids.end());
+  const auto n_owned_before =
+    Utilities::MPI::all_gather(comm, static_cast<unsigned int>(n_owned_cells));
+  bool ids_contiguous = true;
+  for (unsigned int i = 0; i < owned_ids.size(); ++i)
+    if (owned_ids[i] !=
+        std::accumulate(n_owned_before.begin(),
+                        n_owned_before.begin() + my_rank,
+                        0u) +
+          i)
+      ids_contiguous = false;
+  deallog << "coarse-cell ids contiguous: " << (ids_contiguous ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  {
+    deallog.push("2d");
+    test<2>(8, comm);
+    deallog.pop();
+  }
+  {
+    deallog.push("3d");
+    test<3>(4, comm);
+    deallog.pop();
+  }
+}
@@ -0,0 +1,108 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// GridIn::read_msh reads the nodes in chunks of lines that are converted in
+// parallel and looks up the node tags in a vector if they are contiguous.
+// Check a mesh with more nodes than fit into one chunk, as well as a mesh
+// with node tags so far apart that they are looked up in a map and with
+// empty lines between the nodes.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+
+void
+test_many_nodes()
+{
+  Triangulation<2> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 260, -1., 1.);
+
+  std::stringstream stream;
+  GridOut().write_msh(tria, stream);
+
+  Triangulation<2> tria_in;
+  GridIn<2>        grid_in;
+  grid_in.attach_triangulation(tria_in);
+  grid_in.read_msh(stream);
+
+  bool same_cells = tria.n_active_cells() == tria_in.n_active_cells();
+  for (auto cell = tria.begin_active(), cell_in = tria_in.begin_active();
+       same_cells && cell != tria.end();
+       ++cell, ++cell_in)
+    if (cell->center().distance(cell_in->center()) > 1e-5)
+      same_cells = false;
+
+  deallog << "Read " << tria_in.n_active_cells() << " cells with "
+          << tria_in.n_vertices() << " vertices, same cells: "
+          << (same_cells ? "yes" : "no") << std::endl;
+}
+
+
+
+void
+test_sparse_tags()
+{
+  std::stringstream stream;
+  stream << "$MeshFormat" << std::endl
+         << "2.2 0 8" << std::endl
+         << "$EndMeshFormat" << std::endl
+         << "$Nodes" << std::endl
+         << "4" << std::endl
+         << "7 0 0 0" << std::endl
+         << std::endl
+         << "1000000 1 0 0" << std::endl
+         << "  \t" << std::endl
+         << "2000000000 1 1 0" << std::endl
+         << "42 0 1 0" << std::endl
+         << "$EndNodes" << std::endl
+         << "$Elements" << std::endl
+         << "1" << std::endl
+         << "1 3 2 5 1 7 1000000 2000000000 42" << std::endl
+         << "$EndElements" << std::endl;
+
+  Triangulation<2> tria;
+  GridIn<2>        grid_in;
+  grid_in.attach_triangulation(tria);
+  grid_in.read_msh(stream);
+
+  const auto cell = tria.begin_active();
+  deallog << "Read " << tria.n_active_cells() << " cell with material id "
+          << cell->material_id() << ", vertices at the unit square: "
+          << (cell->vertex(0).distance(Point<2>(0, 0)) < 1e-12 &&
+                  cell->vertex(1).distance(Point<2>(1, 0)) < 1e-12 &&
+                  cell->vertex(2).distance(Point<2>(0, 1)) < 1e-12 &&
+                  cell->vertex(3).distance(Point<2>(1, 1)) < 1e-12 ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_many_nodes();
+  test_sparse_tags();
+}
@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// GridIn::read_msh_slice() reads a part of the vertices and elements of a
+// gmsh file. Check for the different versions of the format that the slices
+// together give the vertices, cells, and boundary data of the whole file,
+// with the vertex indices referring to the global numbering, and that the
+// cells are the same as the ones read by GridIn::read_msh().
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const std::string &filename, const unsigned int n_slices)
+{
+  deallog << "Reading " << filename << " in " << n_slices << " slices"
+          << std::endl;
+
+  std::vector<Point<dim>>    vertices_all;
+  std::vector<CellData<dim>> cells_all;
+  SubCellData                subcell_data_all;
+  {
+    std::ifstream in(SOURCE_DIR "/grids/" + filename);
+    GridIn<dim>::read_msh_slice(
+      in, 0, 1, vertices_all, cells_all, subcell_data_all);
+  }
+
+  std::vector<Point<dim>>    vertices;
+  std::vector<CellData<dim>> cells;
+  SubCellData                subcell_data;
+  for (unsigned int slice = 0; slice < n_slices; ++slice)
+    {
+      std::vector<Point<dim>>    vertices_slice;
+      std::vector<CellData<dim>> cells_slice;
+      SubCellData                subcell_data_slice;
+      std::ifstream              in(SOURCE_DIR "/grids/" + filename);
+      GridIn<dim>::read_msh_slice(in,
+                                  slice,
+                                  n_slices,
+                                  vertices_slice,
+                                  cells_slice,
+                                  subcell_data_slice);
+      deallog << "Slice " << slice << ": " << vertices_slice.size()
+              << " vertices, " << cells_slice.size() << " cells, "
+              << subcell_data_slice.boundary_lines.size() << " lines, "
+              << subcell_data_slice.boundary_quads.size() << " quads"
+              << std::endl;
+
+      vertices.insert(vertices.end(),
+                      vertices_slice.begin(),
+                      vertices_slice.end());
+      cells.insert(cells.end(), cells_slice.begin(), cells_slice.end());
+      subcell_data.boundary_lines.insert(
+        subcell_data.boundary_lines.end(),
+        subcell_data_slice.boundary_lines.begin(),
+        subcell_data_slice.boundary_lines.end());
+      subcell_data.boundary_quads.insert(
+        subcell_data.boundary_quads.end(),
+        subcell_data_slice.boundary_quads.begin(),
+        subcell_data_slice.boundary_quads.end());
+    }
+
+  bool same = vertices == vertices_all && cells == cells_all &&
+              subcell_data.boundary_lines.size() ==
+                subcell_data_all.boundary_lines.size() &&
+              subcell_data.boundary_quads.size() ==
+                subcell_data_all.boundary_quads.size();
+  for (unsigned int i = 0; same && i < subcell_data.boundary_lines.size(); ++i)
+    same = subcell_data.boundary_lines[i] == subcell_data_all.boundary_lines[i];
+  for (unsigned int i = 0; same && i < subcell_data.boundary_quads.size(); ++i)
+    same = subcell_data.boundary_quads[i] == subcell_data_all.boundary_quads[i];
+  deallog << "Slices give the whole mesh: " << (same ? "yes" : "no")
+          << std::endl;
+
+  // the centers of the cells are the same as in the triangulation created
+  // by read_msh()
+  Triangulation<dim> tria;
+  {
+    GridIn<dim> grid_in;
+    grid_in.attach_triangulation(tria);
+    std::ifstream in(SOURCE_DIR "/grids/" + filename);
+    grid_in.read_msh(in);
+  }
+  bool same_cells = tria.n_active_cells() == cells.size();
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      if (!same_cells)
+        break;
+      const CellData<dim> &cell_data = cells[cell->active_cell_index()];
+      Point<dim>           center;
+      for (const unsigned int v : cell_data.vertices)
+        center += vertices[v] / double(cell_data.vertices.size());
+      same_cells =
+        cell->center().distance(center) < 1e-12 * (1. + center.norm()) &&
+        cell->material_id() == cell_data.material_id;
+    }
+  deallog << "Same cells as read_msh(): " << (same_cells ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>("grid_in_msh_01.2da.msh", 3);
+  test<2>("grid_in_msh_01.2da.v4.msh", 3);
+  test<2>("grid_in_msh_01.2da.v41.msh", 4);
+  test<2>("find_cell_10.msh", 4);
+  test<3>("grid_in_msh_01.3da.msh", 3);
+  test<3>("grid_in_msh_01.3da.v4.msh", 5);
+  test<3>("grid_in_msh_01.3da.v41.msh", 2);
+}
@@ -0,0 +1,175 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check GridTools::order_cells_along_space_filling_curve on adaptively
+// refined meshes with curved manifolds, moved vertices, and non-default
+// ids: the mesh must stay the same, including after further refinement,
+// while consecutive active cells get closer to each other.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../tests.h"
+
+
+// collect the centers, measures, and ids of the active cells and the
+// boundary ids of their faces in a sorted list. the new vertices of a
+// refinement depend on the order in which the manifolds see the
+// surrounding points, so round the geometric quantities
+template <int dim>
+std::vector<std::vector<double>>
+describe_mesh(const Triangulation<dim> &tria)
+{
+  const auto round = [](const double x) { return std::round(x * 1e10); };
+
+  std::vector<std::vector<double>> description;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      std::vector<double> data;
+      for (unsigned int d = 0; d < dim; ++d)
+        data.push_back(round(cell->center()[d]));
+      data.push_back(round(cell->measure()));
+      data.push_back(cell->material_id());
+      data.push_back(cell->manifold_id());
+      for (const auto &face : cell->face_iterators())
+        data.push_back(face->at_boundary() ? face->boundary_id() : -1.);
+      description.push_back(data);
+    }
+  std::sort(description.begin(), description.end());
+  return description;
+}
+
+
+
+// the sum of the distances between consecutive active cells
+template <int dim>
+double
+distance_of_consecutive_cells(const Triangulation<dim> &tria)
+{
+  double distance = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (std::next(cell) != tria.end())
+      distance += cell->center().distance(std::next(cell)->center());
+  return distance;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., 0, true);
+  tria.refine_global(1);
+
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (random_value<double>() < 0.3)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  // change some ids and move the interior vertices after the refinement
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      if (cell->center()[0] > 0)
+        cell->set_material_id(3);
+      for (const auto &face : cell->face_iterators())
+        if (face->at_boundary() && face->center()[1] > 0)
+          face->set_boundary_id(face->boundary_id() + 4);
+    }
+  GridTools::distort_random(0.1, tria, true);
+
+  const std::vector<std::vector<double>> description = describe_mesh(tria);
+  const double       distance   = distance_of_consecutive_cells(tria);
+  const unsigned int n_vertices = tria.n_used_vertices();
+  const unsigned int n_levels   = tria.n_levels();
+
+  Triangulation<dim> original_tria;
+  original_tria.copy_triangulation(tria);
+
+  GridTools::order_cells_along_space_filling_curve(tria);
+
+  deallog << "Testing " << dim << "D" << std::endl;
+  deallog << "Same mesh: "
+          << (describe_mesh(tria) == description &&
+                  tria.n_used_vertices() == n_vertices &&
+                  tria.n_levels() == n_levels ?
+                "yes" :
+                "no")
+          << std::endl;
+  deallog << "Consecutive cells closer: "
+          << (distance_of_consecutive_cells(tria) < distance ? "yes" : "no")
+          << std::endl;
+
+  // the coarse cells are sorted along the Hilbert curve through their
+  // centers
+  std::vector<Point<dim>> centers;
+  for (const auto &cell : tria.cell_iterators_on_level(0))
+    centers.push_back(cell->center());
+  const auto hilbert_indices =
+    Utilities::inverse_Hilbert_space_filling_curve(centers);
+  deallog << "Coarse cells sorted: "
+          << (std::is_sorted(hilbert_indices.begin(), hilbert_indices.end()) ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  // the children of each cell are stored consecutively in the order of the
+  // parents
+  bool children_in_order = true;
+  for (unsigned int level = 0; level + 1 < tria.n_levels(); ++level)
+    {
+      int next_child_index = 0;
+      for (const auto &cell : tria.cell_iterators_on_level(level))
+        if (cell->has_children())
+          for (unsigned int c = 0; c < cell->n_children(); ++c)
+            {
+              if (cell->child(c)->index() != next_child_index)
+                children_in_order = false;
+              ++next_child_index;
+            }
+    }
+  deallog << "Children in order: " << (children_in_order ? "yes" : "no")
+          << std::endl;
+
+  // the manifolds must still be attached: refine both meshes once more and
+  // compare them again
+  tria.refine_global(1);
+  original_tria.refine_global(1);
+  deallog << "Same mesh after refinement: "
+          << (describe_mesh(tria) == describe_mesh(original_tria) ? "yes" :
+                                                                    "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
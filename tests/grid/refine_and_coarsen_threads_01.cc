@@ -0,0 +1,106 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that the neighbor information and the vertex indices of the cells
+// set up in parallel during Triangulation::execute_coarsening_and_refinement
+// do not depend on the number of threads. The meshes have several thousand
+// cells per level, such that the work on the cells of a level is split into
+// several chunks of the parallel loops
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+std::vector<std::array<int, 2 * dim + (1 << dim)>>
+refine_and_extract(const unsigned int n_threads)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., dim == 2 ? 8 : 12);
+  tria.refine_global(dim == 2 ? 4 : 2);
+
+  Testing::srand(42);
+  for (unsigned int cycle = 0; cycle < 2; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (Testing::rand() % 3 == 0)
+          cell->set_refine_flag();
+        else if (Testing::rand() % 3 == 0)
+          cell->set_coarsen_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  // the mesh is the same for all numbers of threads, so only output its
+  // size once
+  if (n_threads == 1)
+    {
+      deallog << dim << "D: cells per level:";
+      for (unsigned int level = 0; level < tria.n_levels(); ++level)
+        deallog << ' ' << tria.n_cells(level);
+      deallog << std::endl;
+    }
+
+  std::vector<std::array<int, 2 * dim + (1 << dim)>> data;
+  for (const auto &cell : tria.cell_iterators())
+    {
+      std::array<int, 2 * dim + (1 << dim)> entry;
+      for (const unsigned int f : cell->face_indices())
+        if (cell->at_boundary(f))
+          entry[f] = -1;
+        else if (cell->neighbor(f).state() != IteratorState::valid)
+          entry[f] = -2;
+        else
+          entry[f] = cell->neighbor_index(f);
+      for (const unsigned int v : cell->vertex_indices())
+        entry[2 * dim + v] = cell->vertex_index(v);
+      data.push_back(entry);
+    }
+  return data;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const auto serial_data = refine_and_extract<dim>(1);
+  const auto parallel_data =
+    refine_and_extract<dim>(MultithreadInfo::n_cores() > 1 ?
+                              MultithreadInfo::n_cores() :
+                              4);
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  deallog << dim << "D: identical results: "
+          << (serial_data == parallel_data ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
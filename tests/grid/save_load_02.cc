@@ -0,0 +1,224 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test the binary format of Triangulation::save()/load() on adaptively
+// refined meshes with non-default ids, user flags, and user indices: the
+// loaded triangulation must be identical to the saved one, including its
+// internal numbering, and must behave the same under further refinement.
+// Also check that files in the text format of earlier versions can still
+// be loaded, and that empty triangulations can be saved and loaded.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <boost/archive/text_oarchive.hpp>
+
+#include <fstream>
+
+#include "../tests.h"
+
+
+template <int dim, int spacedim>
+bool
+identical(const Triangulation<dim, spacedim> &tria_1,
+          const Triangulation<dim, spacedim> &tria_2)
+{
+  if (tria_1.n_levels() != tria_2.n_levels() ||
+      tria_1.n_cells() != tria_2.n_cells() ||
+      tria_1.n_active_cells() != tria_2.n_active_cells() ||
+      tria_1.n_vertices() != tria_2.n_vertices() ||
+      tria_1.get_vertices() != tria_2.get_vertices())
+    return false;
+
+  for (auto cell_1 = tria_1.begin(), cell_2 = tria_2.begin();
+       cell_1 != tria_1.end();
+       ++cell_1, ++cell_2)
+    {
+      if (cell_1->level() != cell_2->level() ||
+          cell_1->index() != cell_2->index() ||
+          cell_1->material_id() != cell_2->material_id() ||
+          cell_1->manifold_id() != cell_2->manifold_id() ||
+          cell_1->user_flag_set() != cell_2->user_flag_set() ||
+          cell_1->user_index() != cell_2->user_index() ||
+          cell_1->has_children() != cell_2->has_children())
+        return false;
+      if (cell_1->is_active() &&
+          cell_1->active_cell_index() != cell_2->active_cell_index())
+        return false;
+      for (const unsigned int v : cell_1->vertex_indices())
+        if (cell_1->vertex_index(v) != cell_2->vertex_index(v))
+          return false;
+      for (const unsigned int f : cell_1->face_indices())
+        {
+          if (cell_1->face_index(f) != cell_2->face_index(f) ||
+              cell_1->face(f)->boundary_id() !=
+                cell_2->face(f)->boundary_id() ||
+              cell_1->at_boundary(f) != cell_2->at_boundary(f))
+            return false;
+          if (!cell_1->at_boundary(f) &&
+              (cell_1->neighbor_level(f) != cell_2->neighbor_level(f) ||
+               cell_1->neighbor_index(f) != cell_2->neighbor_index(f)))
+            return false;
+        }
+    }
+  return true;
+}
+
+
+
+// refine and coarsen cells depending on their index, such that two
+// identical triangulations are modified in the same way
+template <int dim, int spacedim>
+void
+refine_adaptively(Triangulation<dim, spacedim> &tria, const unsigned int seed)
+{
+  // simplex meshes only support global refinement
+  if (!tria.all_reference_cells_are_hyper_cube())
+    {
+      if (seed % 2 == 0)
+        tria.refine_global(1);
+      return;
+    }
+
+  for (const auto &cell : tria.active_cell_iterators())
+    if ((cell->active_cell_index() * 7 + seed) % 4 == 0)
+      cell->set_refine_flag();
+    else if (cell->level() > 1 &&
+             (cell->active_cell_index() + seed) % 3 == 0)
+      cell->set_coarsen_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim, int spacedim>
+void
+test(Triangulation<dim, spacedim> &tria, const std::string &name)
+{
+  for (unsigned int cycle = 0; cycle < 4; ++cycle)
+    refine_adaptively(tria, cycle);
+
+  unsigned int counter = 0;
+  for (const auto &cell : tria.cell_iterators())
+    {
+      cell->set_user_index(++counter);
+      if (counter % 3 == 0)
+        cell->set_material_id(counter % 7);
+    }
+  tria.clear_user_flags();
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->active_cell_index() % 5 == 0)
+      cell->set_user_flag();
+
+  const std::string filename = "save_load_02_" + name;
+  tria.save(filename);
+
+  // the manifolds are not saved, so attach them after loading
+  Triangulation<dim, spacedim> loaded_tria;
+  loaded_tria.load(filename);
+  for (const auto manifold_id : tria.get_manifold_ids())
+    if (manifold_id != numbers::flat_manifold_id)
+      loaded_tria.set_manifold(manifold_id, tria.get_manifold(manifold_id));
+  deallog << name << ": identical after load: "
+          << (identical(tria, loaded_tria) ? "yes" : "no") << std::endl;
+
+  // both triangulations must refine and coarsen in the same way
+  refine_adaptively(tria, 4);
+  refine_adaptively(loaded_tria, 4);
+  deallog << name << ": identical after refinement: "
+          << (identical(tria, loaded_tria) ? "yes" : "no") << std::endl;
+
+  // files in the text format of earlier versions can still be read
+  {
+    std::ofstream                 out(filename);
+    boost::archive::text_oarchive archive(out, boost::archive::no_header);
+    tria.save(archive, 0);
+  }
+  Triangulation<dim, spacedim> text_tria;
+  text_tria.load(filename);
+  deallog << name << ": identical after load from text format: "
+          << (identical(tria, text_tria) ? "yes" : "no") << std::endl;
+}
+
+
+
+// an empty triangulation has no faces, save and load it into a
+// triangulation with cells, which must be empty afterwards and usable to
+// create a new mesh
+template <int dim>
+void
+test_empty()
+{
+  const std::string filename = "save_load_02_empty_" + std::to_string(dim);
+  {
+    Triangulation<dim> tria;
+    tria.save(filename);
+  }
+
+  Triangulation<dim> loaded_tria;
+  GridGenerator::hyper_cube(loaded_tria);
+  loaded_tria.load(filename);
+  deallog << dim << "d empty: n_cells after load: " << loaded_tria.n_cells()
+          << ", n_vertices: " << loaded_tria.n_vertices() << std::endl;
+
+  GridGenerator::hyper_cube(loaded_tria);
+  loaded_tria.refine_global(1);
+  deallog << dim << "d empty: n_active_cells after creating a mesh: "
+          << loaded_tria.n_active_cells() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_empty<1>();
+  test_empty<2>();
+  test_empty<3>();
+
+  {
+    Triangulation<1> tria;
+    GridGenerator::hyper_cube(tria, -1, 1, true);
+    tria.refine_global(2);
+    test(tria, "1d");
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_shell(tria, Point<2>(), 0.5, 1., 6, true);
+    tria.refine_global(1);
+    test(tria, "2d");
+  }
+  {
+    Triangulation<2, 3> tria;
+    GridGenerator::hyper_sphere(tria);
+    tria.refine_global(1);
+    test(tria, "2d3d");
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(1);
+    test(tria, "3d");
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 1);
+    test(tria, "3d_simplex");
+  }
+}
@@ -0,0 +1,124 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check BlockCSRMatrix against SparseMatrix: assemble both through
+// AffineConstraints::distribute_local_to_global() and compare the
+// entries and the matrix-vector products
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/affine_constraints.templates.h>
+#include <deal.II/lac/block_csr_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int block_size>
+void
+test()
+{
+  // a 1d chain of "elements" with two nodes each, where every node carries
+  // block_size unknowns numbered consecutively
+  const unsigned int n_nodes = 41;
+  const unsigned int n_dofs  = n_nodes * block_size;
+
+  AffineConstraints<double> constraints;
+  constraints.add_line(0);
+  constraints.add_line(n_dofs - 1);
+  constraints.add_entry(n_dofs - 1, n_dofs - 2, 0.5);
+  constraints.close();
+
+  std::vector<std::vector<types::global_dof_index>> element_dofs;
+  for (unsigned int e = 0; e + 1 < n_nodes; ++e)
+    {
+      std::vector<types::global_dof_index> dofs;
+      for (unsigned int node = e; node < e + 2; ++node)
+        for (unsigned int c = 0; c < block_size; ++c)
+          dofs.push_back(node * block_size + c);
+      element_dofs.push_back(dofs);
+    }
+
+  DynamicSparsityPattern dsp(n_dofs, n_dofs);
+  for (const auto &dofs : element_dofs)
+    constraints.add_entries_local_to_global(dofs, dsp, true);
+  SparsityPattern sp;
+  sp.copy_from(dsp);
+
+  SparseMatrix<double>               A(sp);
+  BlockCSRMatrix<double, block_size> B(dsp);
+  deallog << "Blocks: " << B.n_nonzero_blocks()
+          << ", entries: " << B.n_nonzero_elements() << std::endl;
+
+  FullMatrix<double> cell_matrix(2 * block_size, 2 * block_size);
+  for (const auto &dofs : element_dofs)
+    {
+      for (unsigned int i = 0; i < cell_matrix.m(); ++i)
+        for (unsigned int j = 0; j < cell_matrix.n(); ++j)
+          cell_matrix(i, j) = random_value<double>(-1., 1.);
+      constraints.distribute_local_to_global(cell_matrix, dofs, A);
+      constraints.distribute_local_to_global(cell_matrix, dofs, B);
+    }
+
+  bool entries_equal = true;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    for (unsigned int j = 0; j < n_dofs; ++j)
+      if (A.el(i, j) != B.el(i, j))
+        entries_equal = false;
+  deallog << "Entries: " << (entries_equal ? "OK" : "FAILED") << std::endl;
+
+  Vector<double> src(n_dofs), dst1(n_dofs), dst2(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    src(i) = random_value<double>();
+
+  A.vmult(dst1, src);
+  B.vmult(dst2, src);
+  dst2 -= dst1;
+  deallog << "vmult: " << (dst2.linfty_norm() < 1e-13 ? "OK" : "FAILED")
+          << std::endl;
+
+  A.vmult_add(dst1, src);
+  B.vmult(dst2, src);
+  B.vmult_add(dst2, src);
+  dst2 -= dst1;
+  deallog << "vmult_add: " << (dst2.linfty_norm() < 1e-13 ? "OK" : "FAILED")
+          << std::endl;
+
+  A.Tvmult(dst1, src);
+  B.Tvmult(dst2, src);
+  dst2 -= dst1;
+  deallog << "Tvmult: " << (dst2.linfty_norm() < 1e-13 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("block_size=2");
+  test<2>();
+  deallog.pop();
+  deallog.push("block_size=3");
+  test<3>();
+  deallog.pop();
+}
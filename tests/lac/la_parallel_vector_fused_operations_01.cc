@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check LinearAlgebra::distributed::fused_operation against the separate
+// vector operations, for vector sizes that span several chunks, and check
+// SolverBicgstab, which uses the fused operations for these vectors
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/la_parallel_vector_fused_operations.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_bicgstab.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+void
+test_operation(const unsigned int size)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  VectorType x(size), p(size), r(size), v(size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      x(i) = random_value<double>();
+      p(i) = random_value<double>();
+      r(i) = random_value<double>();
+      v(i) = random_value<double>();
+    }
+  VectorType x_ref(x), r_ref(r);
+
+  const double alpha = 0.3;
+
+  x_ref.add(alpha, p);
+  r_ref.add(-alpha, v);
+  const double r_norm_ref = r_ref.norm_sqr();
+  const double r_dot_p    = r_ref * p;
+
+  double       *x_ptr = x.begin();
+  double       *r_ptr = r.begin();
+  const double *p_ptr = p.begin();
+  const double *v_ptr = v.begin();
+
+  const std::array<double, 2> result =
+    LinearAlgebra::distributed::fused_operation<2>(
+      r,
+      [&](const unsigned int     begin,
+          const unsigned int     end,
+          std::array<double, 2> &sums) {
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            x_ptr[i] += alpha * p_ptr[i];
+            r_ptr[i] -= alpha * v_ptr[i];
+            sums[0] += r_ptr[i] * r_ptr[i];
+            sums[1] += r_ptr[i] * p_ptr[i];
+          }
+      });
+
+  x -= x_ref;
+  r -= r_ref;
+  deallog << "size " << size << ": vectors "
+          << (x.linfty_norm() == 0. && r.linfty_norm() == 0. ? "OK" : "FAILED")
+          << ", sums "
+          << (std::abs(result[0] - r_norm_ref) <= 1e-12 * r_norm_ref &&
+                  std::abs(result[1] - r_dot_p) <= 1e-12 * r_norm_ref ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+}
+
+
+
+void
+test_bicgstab(const bool exact_residual)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  VectorType x(dim), b(dim), residual(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    b(i) = 1. + (i % 7);
+
+  SolverControl control(1000, 1e-10 * b.l2_norm());
+  SolverBicgstab<VectorType>::AdditionalData data;
+  data.exact_residual = exact_residual;
+  SolverBicgstab<VectorType> solver(control, data);
+  solver.solve(A, x, b, PreconditionIdentity());
+
+  A.vmult(residual, x);
+  residual -= b;
+  deallog << "Bicgstab exact_residual=" << exact_residual << ": "
+          << (residual.l2_norm() < 1e-8 * b.l2_norm() ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  for (const unsigned int size : {0, 1, 17, 4096, 10000, 100000})
+    test_operation(size);
+
+  test_bicgstab(true);
+  test_bicgstab(false);
+}
@@ -0,0 +1,161 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check the matrix-vector products of SlicedEllpackMatrix against the ones
+// of SparseMatrix for a matrix with varying row lengths
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sliced_ellpack_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <typename number>
+void
+test(const unsigned int m, const unsigned int n, const unsigned int sigma)
+{
+  // a matrix with a few entries per row, where the number of entries varies
+  // between the rows, and with some empty rows
+  DynamicSparsityPattern dsp(m, n);
+  for (unsigned int i = 0; i < m; ++i)
+    if (i % 11 != 5)
+      for (unsigned int k = 0; k < 1 + (i * 7) % 13; ++k)
+        dsp.add(i, Testing::rand() % n);
+  SparsityPattern sp;
+  sp.copy_from(dsp);
+
+  SparseMatrix<number> A(sp);
+  for (auto &entry : A)
+    entry.value() = random_value<number>(-1., 1.);
+
+  SlicedEllpackMatrix<number> B(A, sigma);
+  AssertThrow(B.m() == A.m(), ExcInternalError());
+  AssertThrow(B.n() == A.n(), ExcInternalError());
+  AssertThrow(B.n_nonzero_elements() == A.n_nonzero_elements(),
+              ExcInternalError());
+  AssertThrow(B.n_stored_elements() >= B.n_nonzero_elements(),
+              ExcInternalError());
+
+  Vector<number> src(n), src_t(m), dst1(m), dst2(m), dst_t1(n), dst_t2(n);
+  for (unsigned int i = 0; i < n; ++i)
+    src(i) = random_value<number>();
+  for (unsigned int i = 0; i < m; ++i)
+    src_t(i) = random_value<number>();
+
+  const number tolerance = std::is_same<number, float>::value ? 1e-5 : 1e-13;
+
+  A.vmult(dst1, src);
+  B.vmult(dst2, src);
+  dst2 -= dst1;
+  deallog << "vmult error:      "
+          << (dst2.linfty_norm() <= tolerance ? "OK" : "FAILED") << std::endl;
+
+  A.vmult_add(dst1, src);
+  B.vmult(dst2, src);
+  B.vmult_add(dst2, src);
+  dst2 -= dst1;
+  deallog << "vmult_add error:  "
+          << (dst2.linfty_norm() <= tolerance ? "OK" : "FAILED") << std::endl;
+
+  A.Tvmult(dst_t1, src_t);
+  B.Tvmult(dst_t2, src_t);
+  dst_t2 -= dst_t1;
+  deallog << "Tvmult error:     "
+          << (dst_t2.linfty_norm() <= tolerance ? "OK" : "FAILED")
+          << std::endl;
+
+  A.Tvmult_add(dst_t1, src_t);
+  B.Tvmult(dst_t2, src_t);
+  B.Tvmult_add(dst_t2, src_t);
+  dst_t2 -= dst_t1;
+  deallog << "Tvmult_add error: "
+          << (dst_t2.linfty_norm() <= tolerance ? "OK" : "FAILED")
+          << std::endl;
+
+  const number res1 = A.residual(dst1, src, src_t);
+  const number res2 = B.residual(dst2, src, src_t);
+  dst2 -= dst1;
+  deallog << "residual error:   "
+          << (dst2.linfty_norm() <= tolerance &&
+                  std::abs(res1 - res2) <= tolerance * res1 ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+
+  // change the values and check that copy_from picks them up
+  A *= number(2.);
+  B.copy_from(A);
+  A.vmult(dst1, src);
+  B.vmult(dst2, src);
+  dst2 -= dst1;
+  deallog << "copy_from error:  "
+          << (dst2.linfty_norm() <= tolerance ? "OK" : "FAILED") << std::endl;
+}
+
+
+// the products of an empty matrix must not touch any entries, both for a
+// default-constructed matrix and after clear()
+void
+test_empty()
+{
+  Vector<double> src, dst;
+
+  SlicedEllpackMatrix<double> A;
+  A.vmult(dst, src);
+  A.vmult_add(dst, src);
+  A.Tvmult(dst, src);
+  A.Tvmult_add(dst, src);
+
+  DynamicSparsityPattern dsp(3, 3);
+  for (unsigned int i = 0; i < 3; ++i)
+    dsp.add(i, i);
+  SparsityPattern sp;
+  sp.copy_from(dsp);
+  SparseMatrix<double> B(sp);
+  A.reinit(B);
+  A.clear();
+  A.vmult(dst, src);
+  A.vmult_add(dst, src);
+  A.Tvmult(dst, src);
+  A.Tvmult_add(dst, src);
+
+  deallog << "empty matrix: " << A.m() << "x" << A.n() << " OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test_empty();
+
+  for (const unsigned int sigma : {1, 32, 1000})
+    {
+      deallog.push("double sigma=" + std::to_string(sigma));
+      test<double>(37, 37, sigma);
+      test<double>(100, 43, sigma);
+      deallog.pop();
+      deallog.push("float sigma=" + std::to_string(sigma));
+      test<float>(37, 37, sigma);
+      test<float>(100, 43, sigma);
+      deallog.pop();
+    }
+}
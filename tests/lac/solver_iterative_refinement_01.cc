@@ -0,0 +1,89 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check SolverIterativeRefinement with an inner solver that works on a
+// SparseMatrix<float> copy of the system matrix, applied to double vectors
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_iterative_refinement.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A,
+     const SparseMatrix<float>  &A_float,
+     const PreconditionerType   &preconditioner)
+{
+  VectorType x, b, residual;
+  x.reinit(A.m());
+  b.reinit(A.m());
+  residual.reinit(A.m());
+  for (unsigned int i = 0; i < A.m(); ++i)
+    b(i) = 1. + (i % 7);
+
+  SolverControl                         control(100, 1e-10);
+  SolverIterativeRefinement<VectorType> solver(control);
+  check_solver_within_range(solver.solve(A, x, b, A_float, preconditioner),
+                            control.last_step(),
+                            3,
+                            12);
+
+  A.vmult(residual, x);
+  residual -= b;
+  deallog << "Residual " << (residual.l2_norm() < 1e-10 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  SparseMatrix<float> A_float(structure);
+  A_float.copy_from(A);
+
+  PreconditionJacobi<SparseMatrix<float>> jacobi;
+  jacobi.initialize(A_float);
+
+  deallog << "Vector<double>" << std::endl;
+  test<Vector<double>>(A, A_float, jacobi);
+
+  deallog << "LinearAlgebra::distributed::Vector<double>" << std::endl;
+  test<LinearAlgebra::distributed::Vector<double>>(A,
+                                                   A_float,
+                                                   PreconditionIdentity());
+}
@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that SolverPipelinedCG gives the same iterates as SolverCG up to
+// round-off, for both Vector and LinearAlgebra::distributed::Vector
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A, const PreconditionerType &preconditioner)
+{
+  VectorType b, x_cg, x_pipelined;
+  b.reinit(A.m());
+  x_cg.reinit(A.m());
+  x_pipelined.reinit(A.m());
+  for (unsigned int i = 0; i < A.m(); ++i)
+    b(i) = 1. + (i % 7);
+
+  SolverControl        control_cg(1000, 1e-8);
+  SolverCG<VectorType> solver_cg(control_cg);
+  solver_cg.solve(A, x_cg, b, preconditioner);
+
+  SolverControl                 control_pipelined(1000, 1e-8);
+  SolverPipelinedCG<VectorType> solver_pipelined(control_pipelined);
+  solver_pipelined.solve(A, x_pipelined, b, preconditioner);
+
+  deallog << "Iteration count "
+          << (std::abs(static_cast<int>(control_cg.last_step()) -
+                       static_cast<int>(control_pipelined.last_step())) <= 1 ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+
+  x_pipelined -= x_cg;
+  deallog << "Solution " << (x_pipelined.linfty_norm() < 1e-6 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  PreconditionJacobi<SparseMatrix<double>> jacobi;
+  jacobi.initialize(A);
+
+  deallog << "Vector<double>" << std::endl;
+  test<Vector<double>>(A, PreconditionIdentity());
+  test<Vector<double>>(A, jacobi);
+
+  deallog << "LinearAlgebra::distributed::Vector<double>" << std::endl;
+  test<LinearAlgebra::distributed::Vector<double>>(A, PreconditionIdentity());
+}
@@ -0,0 +1,164 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that SolverPipelinedCG gives the same iterates as SolverCG up to
+// round-off for LinearAlgebra::distributed::Vector distributed among several
+// MPI processes, where the inner products are summed with a non-blocking
+// reduction that overlaps with the matrix-vector product and its ghost
+// exchange
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// The five-point stencil of the Laplacian on an n x n grid plus a
+// varying positive diagonal, with the unknowns numbered row by row and
+// distributed contiguously among the MPI processes
+class Operator
+{
+public:
+  Operator(const unsigned int n)
+    : n(n)
+  {}
+
+  double
+  diagonal(const types::global_dof_index i) const
+  {
+    return 5. + 0.1 * (i % 7);
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    src.update_ghost_values();
+    for (const types::global_dof_index i : dst.locally_owned_elements())
+      {
+        const unsigned int ix  = i % n;
+        const unsigned int iy  = i / n;
+        double             sum = diagonal(i) * src(i);
+        if (ix > 0)
+          sum -= src(i - 1);
+        if (ix + 1 < n)
+          sum -= src(i + 1);
+        if (iy > 0)
+          sum -= src(i - n);
+        if (iy + 1 < n)
+          sum -= src(i + n);
+        dst(i) = sum;
+      }
+    src.zero_out_ghost_values();
+  }
+
+private:
+  const unsigned int n;
+};
+
+
+
+template <typename PreconditionerType>
+void
+test(const Operator           &A,
+     const VectorType         &b,
+     const PreconditionerType &preconditioner)
+{
+  VectorType x_cg, x_pipelined, residual;
+  x_cg.reinit(b);
+  x_pipelined.reinit(b);
+  residual.reinit(b);
+
+  SolverControl        control_cg(1000, 1e-10 * b.l2_norm());
+  SolverCG<VectorType> solver_cg(control_cg);
+  solver_cg.solve(A, x_cg, b, preconditioner);
+
+  SolverControl                 control_pipelined(1000, 1e-10 * b.l2_norm());
+  SolverPipelinedCG<VectorType> solver_pipelined(control_pipelined);
+  solver_pipelined.solve(A, x_pipelined, b, preconditioner);
+
+  deallog << "Iteration count "
+          << (std::abs(static_cast<int>(control_cg.last_step()) -
+                       static_cast<int>(control_pipelined.last_step())) <= 1 ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+
+  A.vmult(residual, x_pipelined);
+  residual -= b;
+  deallog << "Residual "
+          << (residual.l2_norm() < 1e-8 * b.l2_norm() ? "OK" : "FAILED")
+          << std::endl;
+
+  x_pipelined -= x_cg;
+  deallog << "Solution "
+          << (x_pipelined.linfty_norm() < 1e-8 * x_cg.linfty_norm() ? "OK" :
+                                                                      "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  mpi_initlog();
+  deallog.depth_file(1);
+
+  const unsigned int            n      = 40;
+  const types::global_dof_index n_dofs = n * n;
+
+  const IndexSet locally_owned =
+    Utilities::MPI::create_evenly_distributed_partitioning(MPI_COMM_WORLD,
+                                                           n_dofs);
+
+  // the unknowns of the rows of the grid below and above the contiguous
+  // locally owned range
+  IndexSet ghosts(n_dofs);
+  if (locally_owned.n_elements() > 0)
+    {
+      const types::global_dof_index begin = *locally_owned.begin();
+      const types::global_dof_index end = begin + locally_owned.n_elements();
+      ghosts.add_range(begin > n ? begin - n : 0, begin);
+      ghosts.add_range(end, std::min(end + n, n_dofs));
+    }
+
+  const Operator A(n);
+
+  VectorType b(locally_owned, ghosts, MPI_COMM_WORLD);
+  for (const types::global_dof_index i : locally_owned)
+    b(i) = 1. + (i % 13);
+
+  DiagonalMatrix<VectorType> jacobi;
+  jacobi.get_vector().reinit(b);
+  for (const types::global_dof_index i : locally_owned)
+    jacobi.get_vector()(i) = 1. / A.diagonal(i);
+
+  deallog << "Identity" << std::endl;
+  test(A, b, PreconditionIdentity());
+
+  deallog << "Jacobi" << std::endl;
+  test(A, b, jacobi);
+}
@@ -0,0 +1,99 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check SolverSStepGMRES with different block sizes and left and right
+// preconditioning on a non-symmetric matrix, for both Vector and
+// LinearAlgebra::distributed::Vector
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A,
+     const PreconditionerType   &preconditioner,
+     const unsigned int          block_size,
+     const bool                  right_preconditioning)
+{
+  deallog << "block_size=" << block_size
+          << (right_preconditioning ? " right" : " left") << std::endl;
+
+  VectorType x, b, residual;
+  x.reinit(A.m());
+  b.reinit(A.m());
+  residual.reinit(A.m());
+  for (unsigned int i = 0; i < A.m(); ++i)
+    b(i) = 1. + (i % 7);
+
+  SolverControl control(2000, 1e-8 * b.l2_norm());
+  typename SolverSStepGMRES<VectorType>::AdditionalData data(
+    20, block_size, right_preconditioning);
+  SolverSStepGMRES<VectorType> solver(control, data);
+  solver.solve(A, x, b, preconditioner);
+
+  // the residual of the unpreconditioned system is checked with a tolerance
+  // that accounts for the different residual measure for left
+  // preconditioning
+  A.vmult(residual, x);
+  residual -= b;
+  deallog << "Residual "
+          << (residual.l2_norm() < 1e-6 * b.l2_norm() ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+
+  deallog << "Vector<double>" << std::endl;
+  for (const unsigned int block_size : {1, 4, 5})
+    for (const bool right_preconditioning : {false, true})
+      test<Vector<double>>(A, ssor, block_size, right_preconditioning);
+
+  deallog << "LinearAlgebra::distributed::Vector<double>" << std::endl;
+  for (const unsigned int block_size : {1, 4})
+    test<LinearAlgebra::distributed::Vector<double>>(A,
+                                                     PreconditionIdentity(),
+                                                     block_size,
+                                                     false);
+}
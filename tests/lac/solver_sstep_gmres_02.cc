@@ -0,0 +1,172 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check SolverSStepGMRES with different block sizes and left and right
+// preconditioning on a non-symmetric operator for
+// LinearAlgebra::distributed::Vector distributed among several MPI
+// processes, where the inner products of a block are summed in a single
+// reduction, and compare the solution with the one of SolverGMRES
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// The five-point stencil of a convection-diffusion operator on an n x n
+// grid, with the unknowns numbered row by row and distributed contiguously
+// among the MPI processes
+class Operator
+{
+public:
+  Operator(const unsigned int n)
+    : n(n)
+  {}
+
+  double
+  diagonal(const types::global_dof_index i) const
+  {
+    return 4. + 0.1 * (i % 7);
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    src.update_ghost_values();
+    for (const types::global_dof_index i : dst.locally_owned_elements())
+      {
+        const unsigned int ix  = i % n;
+        const unsigned int iy  = i / n;
+        double             sum = diagonal(i) * src(i);
+        if (ix > 0)
+          sum -= 1.5 * src(i - 1);
+        if (ix + 1 < n)
+          sum -= 0.5 * src(i + 1);
+        if (iy > 0)
+          sum -= 1.2 * src(i - n);
+        if (iy + 1 < n)
+          sum -= 0.8 * src(i + n);
+        dst(i) = sum;
+      }
+    src.zero_out_ghost_values();
+  }
+
+private:
+  const unsigned int n;
+};
+
+
+
+template <typename PreconditionerType>
+void
+test(const Operator           &A,
+     const VectorType         &b,
+     const PreconditionerType &preconditioner,
+     const unsigned int        block_size,
+     const bool                right_preconditioning)
+{
+  deallog << "block_size=" << block_size
+          << (right_preconditioning ? " right" : " left") << std::endl;
+
+  VectorType x, x_gmres, residual;
+  x.reinit(b);
+  x_gmres.reinit(b);
+  residual.reinit(b);
+
+  SolverControl control(2000, 1e-10 * b.l2_norm());
+  typename SolverSStepGMRES<VectorType>::AdditionalData data(
+    20, block_size, right_preconditioning);
+  SolverSStepGMRES<VectorType> solver(control, data);
+  solver.solve(A, x, b, preconditioner);
+
+  SolverControl control_gmres(2000, 1e-10 * b.l2_norm());
+  typename SolverGMRES<VectorType>::AdditionalData data_gmres(
+    20, right_preconditioning);
+  SolverGMRES<VectorType> solver_gmres(control_gmres, data_gmres);
+  solver_gmres.solve(A, x_gmres, b, preconditioner);
+
+  // the residual of the unpreconditioned system is checked with a tolerance
+  // that accounts for the different residual measure for left
+  // preconditioning
+  A.vmult(residual, x);
+  residual -= b;
+  deallog << "Residual "
+          << (residual.l2_norm() < 1e-8 * b.l2_norm() ? "OK" : "FAILED")
+          << std::endl;
+
+  x -= x_gmres;
+  deallog << "Solution "
+          << (x.linfty_norm() < 1e-7 * x_gmres.linfty_norm() ? "OK" :
+                                                               "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  mpi_initlog();
+  deallog.depth_file(1);
+
+  const unsigned int            n      = 40;
+  const types::global_dof_index n_dofs = n * n;
+
+  const IndexSet locally_owned =
+    Utilities::MPI::create_evenly_distributed_partitioning(MPI_COMM_WORLD,
+                                                           n_dofs);
+
+  // the unknowns of the rows of the grid below and above the contiguous
+  // locally owned range
+  IndexSet ghosts(n_dofs);
+  if (locally_owned.n_elements() > 0)
+    {
+      const types::global_dof_index begin = *locally_owned.begin();
+      const types::global_dof_index end = begin + locally_owned.n_elements();
+      ghosts.add_range(begin > n ? begin - n : 0, begin);
+      ghosts.add_range(end, std::min(end + n, n_dofs));
+    }
+
+  const Operator A(n);
+
+  VectorType b(locally_owned, ghosts, MPI_COMM_WORLD);
+  for (const types::global_dof_index i : locally_owned)
+    b(i) = 1. + (i % 13);
+
+  DiagonalMatrix<VectorType> jacobi;
+  jacobi.get_vector().reinit(b);
+  for (const types::global_dof_index i : locally_owned)
+    jacobi.get_vector()(i) = 1. / A.diagonal(i);
+
+  deallog << "Identity" << std::endl;
+  for (const unsigned int block_size : {1, 4})
+    test(A, b, PreconditionIdentity(), block_size, false);
+
+  deallog << "Jacobi" << std::endl;
+  for (const unsigned int block_size : {1, 4, 5})
+    for (const bool right_preconditioning : {false, true})
+      test(A, b, jacobi, block_size, right_preconditioning);
+}
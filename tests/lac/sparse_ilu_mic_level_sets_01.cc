@@ -0,0 +1,105 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that SparseILU and SparseMIC, which process the rows of the level
+// sets of the matrix in parallel, give exactly the same result as the serial
+// factorization and substitution
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_mic.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <typename PreconditionerType>
+Vector<double>
+apply_preconditioner(const SparseMatrix<double> &A,
+                     const Vector<double>       &src,
+                     const unsigned int          n_threads)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  PreconditionerType preconditioner;
+  preconditioner.initialize(A);
+
+  Vector<double> dst(src.size());
+  preconditioner.vmult(dst, src);
+
+  return dst;
+}
+
+
+
+template <typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A, const std::string &name)
+{
+  Vector<double> src(A.m());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  const Vector<double> dst_serial =
+    apply_preconditioner<PreconditionerType>(A, src, 1);
+  const Vector<double> dst_parallel =
+    apply_preconditioner<PreconditionerType>(A, src, testing_max_num_threads());
+
+  bool identical = true;
+  for (unsigned int i = 0; i < src.size(); ++i)
+    if (dst_serial(i) != dst_parallel(i))
+      identical = false;
+
+  deallog << name << ": " << (identical ? "identical" : "different")
+          << " results, norm of result is "
+          << (dst_serial.l2_norm() > 0 ? "positive" : "zero") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // a symmetric M-matrix with random couplings, which has large level sets
+  const unsigned int     n = 20000;
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      dsp.add(i, i);
+      for (unsigned int k = 0; k < 3; ++k)
+        {
+          const unsigned int j = Testing::rand() % n;
+          dsp.add(i, j);
+          dsp.add(j, i);
+        }
+    }
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> A(sparsity);
+  for (unsigned int i = 0; i < n; ++i)
+    for (auto entry = A.begin(i); entry != A.end(i); ++entry)
+      entry->value() = entry->column() == i ? 2. * sparsity.row_length(i) : -1.;
+
+  test<SparseILU<double>>(A, "SparseILU");
+  test<SparseMIC<double>>(A, "SparseMIC");
+}
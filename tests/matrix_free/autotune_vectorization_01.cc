@@ -0,0 +1,147 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test MatrixFreeTools::autotune_vectorization() for a mass operator: all
+// SIMD widths must be measured, the results must be sorted by time, and the
+// operator must give the same result for all widths
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename Number>
+void
+test(const unsigned int fe_degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  const FE_Q<dim> fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<Number> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, Number>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_values | update_JxW_values;
+
+  std::vector<double> norms;
+
+  const auto results = MatrixFreeTools::autotune_vectorization<dim, Number>(
+    MappingQ1<dim>(),
+    dof_handler,
+    constraints,
+    QGauss<1>(fe_degree + 1),
+    additional_data,
+    [&](const auto &matrix_free) {
+      using VectorizedArrayType =
+        typename std::remove_reference_t<decltype(matrix_free)>::
+          vectorized_value_type;
+      using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+      auto src = std::make_shared<VectorType>();
+      auto dst = std::make_shared<VectorType>();
+      matrix_free.initialize_dof_vector(*src);
+      matrix_free.initialize_dof_vector(*dst);
+      for (unsigned int i = 0; i < src->locally_owned_size(); ++i)
+        src->local_element(i) = static_cast<Number>(i % 7);
+
+      const auto operation = [&matrix_free, src, dst]() {
+        matrix_free.template cell_loop<VectorType, VectorType>(
+          [](const auto &data, auto &dst, const auto &src, const auto cells) {
+            FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType> phi(data);
+            for (unsigned int cell = cells.first; cell < cells.second; ++cell)
+              {
+                phi.reinit(cell);
+                phi.gather_evaluate(src, EvaluationFlags::values);
+                for (const unsigned int q : phi.quadrature_point_indices())
+                  phi.submit_value(phi.get_value(q), q);
+                phi.integrate_scatter(EvaluationFlags::values, dst);
+              }
+          },
+          *dst,
+          *src,
+          true);
+      };
+
+      operation();
+      norms.push_back(dst->l2_norm());
+
+      return operation;
+    },
+    3);
+
+  bool sorted = true;
+  for (unsigned int i = 1; i < results.size(); ++i)
+    if (results[i].time < results[i - 1].time)
+      sorted = false;
+
+  std::set<unsigned int> lanes;
+  for (const auto &result : results)
+    lanes.insert(result.n_lanes);
+
+  bool all_widths = true;
+  for (unsigned int n_lanes = 1; n_lanes <= VectorizedArray<Number>::size();
+       n_lanes *= 2)
+    if ((n_lanes == 1 || n_lanes * sizeof(Number) >= 16) &&
+        lanes.count(n_lanes) == 0)
+      all_widths = false;
+
+  bool same_result = norms.size() == results.size();
+  for (const double norm : norms)
+    if (std::abs(norm - norms[0]) > 1e-5 * norms[0])
+      same_result = false;
+
+  deallog << "dim=" << dim << " degree=" << fe_degree << " "
+          << (sizeof(Number) == 4 ? "float" : "double") << std::endl;
+  deallog << "results sorted by time: " << (sorted ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "all SIMD widths measured: " << (all_widths ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "same result for all settings: "
+          << (same_result ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, double>(1);
+  test<2, double>(3);
+  test<3, double>(2);
+  test<2, float>(2);
+}
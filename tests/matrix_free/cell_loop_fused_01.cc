@@ -0,0 +1,176 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check the variant of MatrixFree::cell_loop that runs several cell
+// operations on different vectors and DoFHandler objects in one loop over
+// the cells, including the case where the same source vector is used by two
+// operations, against separate calls to cell_loop
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+template <int dim, int degree>
+void
+test()
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+  using Operation  = std::function<void(const MatrixFree<dim, double> &,
+                                       VectorType &,
+                                       const VectorType &,
+                                       const std::pair<unsigned int,
+                                                       unsigned int> &)>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FE_Q<dim> fe_1(degree);
+  const FE_Q<dim> fe_2(degree + 1);
+  DoFHandler<dim> dof_1(tria), dof_2(tria);
+  dof_1.distribute_dofs(fe_1);
+  dof_2.distribute_dofs(fe_2);
+
+  AffineConstraints<double> constraints_1, constraints_2;
+  DoFTools::make_hanging_node_constraints(dof_1, constraints_1);
+  DoFTools::make_hanging_node_constraints(dof_2, constraints_2);
+  constraints_1.close();
+  constraints_2.close();
+
+  MatrixFree<dim, double>                          matrix_free;
+  typename MatrixFree<dim, double>::AdditionalData data;
+  data.mapping_update_flags = update_values | update_gradients;
+  matrix_free.reinit(MappingQ1<dim>(),
+                     std::vector<const DoFHandler<dim> *>{&dof_1, &dof_2},
+                     std::vector<const AffineConstraints<double> *>{
+                       &constraints_1, &constraints_2},
+                     QGauss<1>(degree + 2),
+                     data);
+
+  // mass operator on the first DoFHandler, Laplace operator on the second
+  const Operation mass = [](const auto       &matrix_free,
+                            VectorType       &dst,
+                            const VectorType &src,
+                            const auto       &cells) {
+    FEEvaluation<dim, degree, degree + 2> phi(matrix_free, 0);
+    for (unsigned int cell = cells.first; cell < cells.second; ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src, EvaluationFlags::values);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          phi.submit_value(phi.get_value(q), q);
+        phi.integrate_scatter(EvaluationFlags::values, dst);
+      }
+  };
+  const Operation laplace = [](const auto       &matrix_free,
+                               VectorType       &dst,
+                               const VectorType &src,
+                               const auto       &cells) {
+    FEEvaluation<dim, degree + 1, degree + 2> phi(matrix_free, 1);
+    for (unsigned int cell = cells.first; cell < cells.second; ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src, EvaluationFlags::gradients);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          phi.submit_gradient(phi.get_gradient(q), q);
+        phi.integrate_scatter(EvaluationFlags::gradients, dst);
+      }
+  };
+  const Operation laplace_2 = [&](const auto       &matrix_free,
+                                  VectorType       &dst,
+                                  const VectorType &src,
+                                  const auto       &cells) {
+    laplace(matrix_free, dst, src, cells);
+    laplace(matrix_free, dst, src, cells);
+  };
+
+  VectorType src_1, src_2;
+  matrix_free.initialize_dof_vector(src_1, 0);
+  matrix_free.initialize_dof_vector(src_2, 1);
+  for (auto &entry : src_1)
+    entry = random_value<double>();
+  for (auto &entry : src_2)
+    entry = random_value<double>();
+  constraints_1.set_zero(src_1);
+  constraints_2.set_zero(src_2);
+
+  VectorType dst_1, dst_2, dst_3, ref_1, ref_2, ref_3;
+  matrix_free.initialize_dof_vector(dst_1, 0);
+  matrix_free.initialize_dof_vector(ref_1, 0);
+  matrix_free.initialize_dof_vector(dst_2, 1);
+  matrix_free.initialize_dof_vector(ref_2, 1);
+  matrix_free.initialize_dof_vector(dst_3, 1);
+  matrix_free.initialize_dof_vector(ref_3, 1);
+
+  matrix_free.cell_loop(mass, ref_1, src_1, true);
+  matrix_free.cell_loop(laplace, ref_2, src_2, true);
+  matrix_free.cell_loop(laplace_2, ref_3, src_2, true);
+
+  // fill the destination vectors with some content to check that they get
+  // zeroed
+  dst_1 = 1.;
+  dst_2 = 1.;
+  dst_3 = 1.;
+  matrix_free.template cell_loop<VectorType, VectorType>(
+    {mass, laplace, laplace_2},
+    {&dst_1, &dst_2, &dst_3},
+    {&src_1, &src_2, &src_2},
+    true);
+
+  dst_1 -= ref_1;
+  dst_2 -= ref_2;
+  dst_3 -= ref_3;
+  deallog << "dim=" << dim << " degree=" << degree << ": errors "
+          << (dst_1.linfty_norm() < 1e-12 * ref_1.linfty_norm() ? "OK" :
+                                                                  "FAILED")
+          << ' '
+          << (dst_2.linfty_norm() < 1e-12 * ref_2.linfty_norm() ? "OK" :
+                                                                  "FAILED")
+          << ' '
+          << (dst_3.linfty_norm() < 1e-12 * ref_3.linfty_norm() ? "OK" :
+                                                                  "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>();
+  test<2, 2>();
+  test<3, 1>();
+}
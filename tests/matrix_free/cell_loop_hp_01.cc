@@ -0,0 +1,198 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check MatrixFreeTools::cell_loop_hp, which dispatches the cell ranges of
+// an hp-adaptive MatrixFree object to kernels with the polynomial degree as
+// template argument, on a mesh with hanging nodes between cells of
+// different degrees against a sparse matrix
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/fe_values.h>
+#include <deal.II/hp/q_collection.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  using VectorType = Vector<double>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5 && cell->center()[1] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const unsigned int    max_degree = 4;
+  hp::FECollection<dim> fe_collection;
+  hp::QCollection<dim>  quadrature_collection;
+  hp::QCollection<1>    quadrature_collection_mf;
+  for (unsigned int degree = 1; degree <= max_degree; ++degree)
+    {
+      fe_collection.push_back(FE_Q<dim>(degree));
+      quadrature_collection.push_back(QGauss<dim>(degree + 1));
+      quadrature_collection_mf.push_back(QGauss<1>(degree + 1));
+    }
+
+  DoFHandler<dim> dof_handler(tria);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    cell->set_active_fe_index(Testing::rand() % max_degree);
+  dof_handler.distribute_dofs(fe_collection);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(dof_handler,
+                                           0,
+                                           Functions::ZeroFunction<dim>(),
+                                           constraints);
+  constraints.close();
+
+  MappingQ<dim>                                    mapping(1);
+  MatrixFree<dim, double>                          matrix_free;
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, double>::AdditionalData::none;
+  matrix_free.reinit(mapping,
+                     dof_handler,
+                     constraints,
+                     quadrature_collection_mf,
+                     additional_data);
+
+  // reference: sparse matrix of the Helmholtz operator
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+  SparseMatrix<double> system_matrix(sparsity_pattern);
+
+  hp::FEValues<dim> hp_fe_values(fe_collection,
+                                 quadrature_collection,
+                                 update_values | update_gradients |
+                                   update_JxW_values);
+  FullMatrix<double>                   cell_matrix;
+  std::vector<types::global_dof_index> dof_indices;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      hp_fe_values.reinit(cell);
+      const FEValues<dim> &fe_values = hp_fe_values.get_present_fe_values();
+      cell_matrix.reinit(fe_values.dofs_per_cell, fe_values.dofs_per_cell);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (const unsigned int i : fe_values.dof_indices())
+          for (const unsigned int j : fe_values.dof_indices())
+            cell_matrix(i, j) +=
+              (fe_values.shape_grad(i, q) * fe_values.shape_grad(j, q) +
+               fe_values.shape_value(i, q) * fe_values.shape_value(j, q)) *
+              fe_values.JxW(q);
+      dof_indices.resize(fe_values.dofs_per_cell);
+      cell->get_dof_indices(dof_indices);
+      constraints.distribute_local_to_global(cell_matrix,
+                                             dof_indices,
+                                             system_matrix);
+    }
+
+  VectorType src(dof_handler.n_dofs()), dst(src), dst_ref(src);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    if (constraints.is_constrained(i) == false)
+      src(i) = random_value<double>();
+
+  // the template degrees selected for the cell ranges; degree 4 is above
+  // the limit given to cell_loop_hp and uses the fallback
+  std::set<int> selected_degrees;
+  MatrixFreeTools::cell_loop_hp<3>(
+    matrix_free,
+    [&](const auto  degree,
+        const auto &matrix_free,
+        auto       &dst,
+        const auto &src,
+        const auto  cell_range) {
+      constexpr int fe_degree     = decltype(degree)::value;
+      constexpr int n_q_points_1d = fe_degree == -1 ? 0 : fe_degree + 1;
+      selected_degrees.insert(fe_degree);
+
+      FEEvaluation<dim, fe_degree, n_q_points_1d> phi(matrix_free,
+                                                      cell_range);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src,
+                              EvaluationFlags::values |
+                                EvaluationFlags::gradients);
+          for (const unsigned int q : phi.quadrature_point_indices())
+            {
+              phi.submit_value(phi.get_value(q), q);
+              phi.submit_gradient(phi.get_gradient(q), q);
+            }
+          phi.integrate_scatter(EvaluationFlags::values |
+                                  EvaluationFlags::gradients,
+                                dst);
+        }
+    },
+    dst,
+    src,
+    true);
+
+  deallog << "Selected template degrees:";
+  for (const int degree : selected_degrees)
+    deallog << " " << degree;
+  deallog << std::endl;
+
+  system_matrix.vmult(dst_ref, src);
+  constraints.set_zero(dst_ref);
+  constraints.set_zero(dst);
+  dst -= dst_ref;
+  deallog << "Error " << dim << "D: "
+          << (dst.linfty_norm() < 1e-12 * dst_ref.linfty_norm() ? "OK" :
+                                                                  "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,170 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that MatrixFree::AdditionalData::compute_geometry_on_the_fly gives
+// the same Jacobians, JxW values, quadrature points and operator evaluation
+// as the stored geometry on a curved mesh with two quadrature formulas, and
+// that less memory is used
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+template <int dim, int degree>
+void
+test()
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., dim == 2 ? 8 : 6);
+  tria.refine_global(1);
+
+  const MappingQ<dim> mapping(4);
+  const FE_Q<dim>     fe(degree);
+  DoFHandler<dim>     dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  const std::vector<QGauss<1>> quadratures = {QGauss<1>(degree + 1),
+                                              QGauss<1>(degree + 3)};
+
+  typename MatrixFree<dim, double>::AdditionalData data;
+  data.mapping_update_flags =
+    update_gradients | update_JxW_values | update_quadrature_points;
+
+  MatrixFree<dim, double> matrix_free, matrix_free_on_the_fly;
+  const std::vector<const DoFHandler<dim> *> dof_handlers = {&dof_handler};
+  const std::vector<const AffineConstraints<double> *> constraint_vector = {
+    &constraints};
+  matrix_free.reinit(
+    mapping, dof_handlers, constraint_vector, quadratures, data);
+  data.compute_geometry_on_the_fly = true;
+  matrix_free_on_the_fly.reinit(
+    mapping, dof_handlers, constraint_vector, quadratures, data);
+
+  deallog << "dim=" << dim << " degree=" << degree << std::endl;
+  deallog << "Memory reduced: "
+          << (matrix_free_on_the_fly.get_mapping_info().memory_consumption() <
+                  matrix_free.get_mapping_info().memory_consumption() ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  for (unsigned int quad_no = 0; quad_no < quadratures.size(); ++quad_no)
+    {
+      FEEvaluation<dim, -1, 0, 1, double> phi(matrix_free, 0, quad_no);
+      FEEvaluation<dim, -1, 0, 1, double> phi_on_the_fly(
+        matrix_free_on_the_fly, 0, quad_no);
+      double       max_error    = 0;
+      unsigned int n_on_the_fly = 0;
+      for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+        {
+          phi.reinit(cell);
+          phi_on_the_fly.reinit(cell);
+          n_on_the_fly +=
+            matrix_free_on_the_fly.get_mapping_info()
+              .cell_geometry_is_computed_on_the_fly(cell);
+          for (const unsigned int q : phi.quadrature_point_indices())
+            {
+              const auto jacobian =
+                phi.inverse_jacobian(q) - phi_on_the_fly.inverse_jacobian(q);
+              const auto point =
+                phi.quadrature_point(q) - phi_on_the_fly.quadrature_point(q);
+              const auto JxW = phi.JxW(q) - phi_on_the_fly.JxW(q);
+              for (unsigned int v = 0; v < VectorizedArray<double>::size();
+                   ++v)
+                {
+                  max_error = std::max(max_error, std::abs(JxW[v]));
+                  for (unsigned int d = 0; d < dim; ++d)
+                    {
+                      max_error = std::max(max_error, std::abs(point[d][v]));
+                      for (unsigned int e = 0; e < dim; ++e)
+                        max_error =
+                          std::max(max_error, std::abs(jacobian[d][e][v]));
+                    }
+                }
+            }
+        }
+      deallog << "Quadrature " << quad_no << ": geometry computed on the fly "
+              << (n_on_the_fly > 0 ? "yes" : "no") << ", error in geometry "
+              << (max_error < 1e-12 ? "OK" : "FAILED") << std::endl;
+    }
+
+  VectorType src, dst, dst_on_the_fly;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  matrix_free.initialize_dof_vector(dst_on_the_fly);
+  for (auto &entry : src)
+    entry = random_value<double>();
+
+  const auto laplace = [](const MatrixFree<dim, double>               &data,
+                          VectorType                                  &dst,
+                          const VectorType                            &src,
+                          const std::pair<unsigned int, unsigned int> &cells) {
+    FEEvaluation<dim, degree, degree + 3, 1, double> phi(data, 0, 1);
+    for (unsigned int cell = cells.first; cell < cells.second; ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src, EvaluationFlags::gradients);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          phi.submit_gradient(phi.get_gradient(q), q);
+        phi.integrate_scatter(EvaluationFlags::gradients, dst);
+      }
+  };
+  matrix_free.template cell_loop<VectorType, VectorType>(laplace,
+                                                         dst,
+                                                         src,
+                                                         true);
+  matrix_free_on_the_fly.template cell_loop<VectorType, VectorType>(
+    laplace, dst_on_the_fly, src, true);
+  dst_on_the_fly -= dst;
+  deallog << "Laplace operator: "
+          << (dst_on_the_fly.linfty_norm() < 1e-12 * dst.linfty_norm() ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 2>();
+  test<2, 4>();
+  test<3, 2>();
+  test<3, 3>();
+}
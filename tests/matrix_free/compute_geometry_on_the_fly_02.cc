@@ -0,0 +1,148 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that copies of an FEEvaluation object whose geometry is computed on
+// the fly keep their own geometry when one of them is reinitialized on
+// another cell batch, both for the copy constructor and the assignment
+// operator
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename Evaluator>
+double
+geometry_difference(const Evaluator &phi, const Evaluator &reference)
+{
+  double max_error = 0;
+  for (const unsigned int q : phi.quadrature_point_indices())
+    {
+      const auto jacobian =
+        phi.inverse_jacobian(q) - reference.inverse_jacobian(q);
+      const auto point =
+        phi.quadrature_point(q) - reference.quadrature_point(q);
+      const auto JxW = phi.JxW(q) - reference.JxW(q);
+      for (unsigned int v = 0; v < VectorizedArray<double>::size(); ++v)
+        {
+          max_error = std::max(max_error, std::abs(JxW[v]));
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              max_error = std::max(max_error, std::abs(point[d][v]));
+              for (unsigned int e = 0; e < dim; ++e)
+                max_error = std::max(max_error, std::abs(jacobian[d][e][v]));
+            }
+        }
+    }
+  return max_error;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., dim == 2 ? 8 : 6);
+  tria.refine_global(1);
+
+  const MappingQ<dim> mapping(3);
+  const FE_Q<dim>     fe(2);
+  DoFHandler<dim>     dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData data;
+  data.mapping_update_flags =
+    update_gradients | update_JxW_values | update_quadrature_points;
+
+  MatrixFree<dim, double> matrix_free, matrix_free_on_the_fly;
+  matrix_free.reinit(mapping, dof_handler, constraints, QGauss<1>(3), data);
+  data.compute_geometry_on_the_fly = true;
+  matrix_free_on_the_fly.reinit(
+    mapping, dof_handler, constraints, QGauss<1>(3), data);
+
+  const auto &mapping_info = matrix_free_on_the_fly.get_mapping_info();
+  AssertThrow(matrix_free.n_cell_batches() > 1, ExcInternalError());
+  AssertThrow(mapping_info.cell_geometry_is_computed_on_the_fly(0) &&
+                mapping_info.cell_geometry_is_computed_on_the_fly(1),
+              ExcInternalError());
+
+  deallog << "dim=" << dim << std::endl;
+
+  using Evaluator = FEEvaluation<dim, 2, 3, 1, double>;
+  Evaluator reference_0(matrix_free), reference_1(matrix_free);
+  reference_0.reinit(0);
+  reference_1.reinit(1);
+
+  {
+    Evaluator phi(matrix_free_on_the_fly);
+    phi.reinit(0);
+    Evaluator copy(phi);
+    phi.reinit(1);
+    deallog << "Copy constructor: original "
+            << (geometry_difference<dim>(phi, reference_1) < 1e-12 ? "OK" :
+                                                                     "FAILED")
+            << ", copy "
+            << (geometry_difference<dim>(copy, reference_0) < 1e-12 ?
+                  "OK" :
+                  "FAILED")
+            << std::endl;
+  }
+
+  {
+    Evaluator phi(matrix_free_on_the_fly), copy(matrix_free_on_the_fly);
+    phi.reinit(0);
+    copy.reinit(1);
+    copy = phi;
+    copy.reinit(1);
+    deallog << "Assignment: original "
+            << (geometry_difference<dim>(phi, reference_0) < 1e-12 ? "OK" :
+                                                                     "FAILED")
+            << ", copy "
+            << (geometry_difference<dim>(copy, reference_1) < 1e-12 ?
+                  "OK" :
+                  "FAILED")
+            << std::endl;
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,186 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check MatrixFreeTools::compute_matrix on a mesh with hanging nodes and
+// Dirichlet boundary conditions against the matrix-free operator, and check
+// that repeated calls with several threads give the same matrix
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/sparse_matrix.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim, int fe_degree>
+void
+test(const unsigned int n_threads)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  using Number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+  using FEEvalType = FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FE_Q<dim> fe(fe_degree);
+  MappingQ<dim>   mapping(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<Number> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(
+    mapping, dof_handler, 0, Functions::ZeroFunction<dim>(), constraints);
+  constraints.close();
+
+  typename MatrixFree<dim, Number>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_values | update_gradients;
+
+  MatrixFree<dim, Number> matrix_free;
+  matrix_free.reinit(mapping,
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     additional_data);
+
+  const auto cell_operation = [](FEEvalType &phi) {
+    phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+    for (const unsigned int q : phi.quadrature_point_indices())
+      {
+        phi.submit_value(phi.get_value(q), q);
+        phi.submit_gradient(phi.get_gradient(q), q);
+      }
+    phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+  };
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+  SparseMatrix<Number> matrix(sparsity_pattern);
+
+  const auto compute = [&](SparseMatrix<Number> &matrix) {
+    MatrixFreeTools::compute_matrix<dim,
+                                    fe_degree,
+                                    fe_degree + 1,
+                                    1,
+                                    Number,
+                                    VectorizedArray<Number>,
+                                    SparseMatrix<Number>>(matrix_free,
+                                                          constraints,
+                                                          matrix,
+                                                          cell_operation);
+  };
+  compute(matrix);
+
+  VectorType src, dst, dst_matrix;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  matrix_free.initialize_dof_vector(dst_matrix);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<Number>();
+  constraints.set_zero(src);
+
+  matrix_free.template cell_loop<VectorType, VectorType>(
+    [&](const auto &, auto &dst, const auto &src, const auto range) {
+      FEEvalType phi(matrix_free, range);
+      for (unsigned int cell = range.first; cell < range.second; ++cell)
+        {
+          phi.reinit(cell);
+          phi.read_dof_values(src);
+          cell_operation(phi);
+          phi.distribute_local_to_global(dst);
+        }
+    },
+    dst,
+    src,
+    true);
+
+  matrix.vmult(dst_matrix, src);
+  constraints.set_zero(dst_matrix);
+
+  dst_matrix -= dst;
+  deallog << fe.get_name() << ": error "
+          << (dst_matrix.linfty_norm() < 1e-12 * dst.linfty_norm() ? "OK" :
+                                                                     "FAILED")
+          << std::endl;
+
+  // constrained rows must get a positive entry on the diagonal
+  bool diagonal_ok = true;
+  for (unsigned int i = 0; i < dof_handler.n_dofs(); ++i)
+    if (constraints.is_constrained(i) && matrix.diag_element(i) <= 0)
+      diagonal_ok = false;
+  deallog << "positive diagonal for constrained rows: "
+          << (diagonal_ok ? "OK" : "FAILED") << std::endl;
+
+  // the cell batches are distributed to the threads differently in each
+  // call, which must not change the result up to roundoff in the order of
+  // the additions into the matrix
+  if (n_threads > 1)
+    {
+      bool same_matrix = true;
+      for (unsigned int repetition = 0; repetition < 10; ++repetition)
+        {
+          SparseMatrix<Number> other_matrix(sparsity_pattern);
+          compute(other_matrix);
+          other_matrix.add(-1., matrix);
+          if (other_matrix.frobenius_norm() > 1e-12 * matrix.frobenius_norm())
+            same_matrix = false;
+        }
+      deallog << "same matrix in repeated calls with " << n_threads
+              << " threads: " << (same_matrix ? "OK" : "FAILED") << std::endl;
+    }
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>(1);
+  test<2, 3>(1);
+  test<3, 2>(1);
+  test<3, 2>(4);
+}
@@ -0,0 +1,199 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check for which combinations of degree and number of quadrature points
+// FEEvaluation and FEFaceEvaluation with degree -1 select the pre-compiled
+// kernels, and that the pre-compiled kernels for over-integration with
+// degree 7 give the same result as the kernels with the degree given as
+// template argument for a DG operator with cell and face integrals
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+print_supported()
+{
+  for (unsigned int degree = 1; degree < 10; ++degree)
+    {
+      deallog << "degree " << degree << ":";
+      for (const unsigned int n_q_points_1d :
+           {degree, degree + 1, degree + 2, (3 * degree) / 2 + 1})
+        deallog << " " << n_q_points_1d << " "
+                << (FEEvaluation<dim, -1>::fast_evaluation_supported(
+                      degree, n_q_points_1d) ?
+                      "yes" :
+                      "no")
+                << "/"
+                << (FEFaceEvaluation<dim, -1>::fast_evaluation_supported(
+                      degree, n_q_points_1d) ?
+                      "yes" :
+                      "no");
+      deallog << std::endl;
+    }
+}
+
+
+
+template <int dim, int fe_degree, int n_q_points_1d, typename VectorType>
+void
+apply_operator(const MatrixFree<dim, double> &matrix_free,
+               VectorType                    &dst,
+               const VectorType              &src)
+{
+  matrix_free.template loop<VectorType, VectorType>(
+    [](const auto &data, auto &dst, const auto &src, const auto range) {
+      FEEvaluation<dim, fe_degree, n_q_points_1d, 1, double> phi(data);
+      for (unsigned int cell = range.first; cell < range.second; ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src,
+                              EvaluationFlags::values |
+                                EvaluationFlags::gradients);
+          for (const unsigned int q : phi.quadrature_point_indices())
+            {
+              phi.submit_gradient(phi.get_gradient(q) * phi.get_value(q), q);
+              phi.submit_value(phi.get_value(q), q);
+            }
+          phi.integrate_scatter(EvaluationFlags::values |
+                                  EvaluationFlags::gradients,
+                                dst);
+        }
+    },
+    [](const auto &data, auto &dst, const auto &src, const auto range) {
+      FEFaceEvaluation<dim, fe_degree, n_q_points_1d, 1, double> phi_m(data,
+                                                                       true);
+      FEFaceEvaluation<dim, fe_degree, n_q_points_1d, 1, double> phi_p(data,
+                                                                       false);
+      for (unsigned int face = range.first; face < range.second; ++face)
+        {
+          phi_m.reinit(face);
+          phi_p.reinit(face);
+          phi_m.gather_evaluate(src,
+                                EvaluationFlags::values |
+                                  EvaluationFlags::gradients);
+          phi_p.gather_evaluate(src,
+                                EvaluationFlags::values |
+                                  EvaluationFlags::gradients);
+          for (const unsigned int q : phi_m.quadrature_point_indices())
+            {
+              const auto jump = phi_m.get_value(q) - phi_p.get_value(q);
+              const auto flux =
+                0.5 * (phi_m.get_normal_derivative(q) +
+                       phi_p.get_normal_derivative(q)) *
+                  phi_m.get_value(q) +
+                jump;
+              phi_m.submit_value(flux, q);
+              phi_p.submit_value(-flux, q);
+              phi_m.submit_normal_derivative(jump, q);
+              phi_p.submit_normal_derivative(jump, q);
+            }
+          phi_m.integrate_scatter(EvaluationFlags::values |
+                                    EvaluationFlags::gradients,
+                                  dst);
+          phi_p.integrate_scatter(EvaluationFlags::values |
+                                    EvaluationFlags::gradients,
+                                  dst);
+        }
+    },
+    [](const auto &, auto &, const auto &, const auto) {},
+    dst,
+    src,
+    true,
+    MatrixFree<dim, double>::DataAccessOnFaces::gradients,
+    MatrixFree<dim, double>::DataAccessOnFaces::gradients);
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test_overintegration()
+{
+  constexpr int n_q_points_1d = (3 * fe_degree) / 2 + 1;
+  using VectorType            = LinearAlgebra::distributed::Vector<double>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  GridTools::distort_random(0.1, tria, true);
+
+  const FE_DGQ<dim> fe(fe_degree);
+  MappingQ<dim>     mapping(1);
+  DoFHandler<dim>   dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_values | update_gradients;
+  additional_data.mapping_update_flags_inner_faces =
+    update_values | update_gradients;
+
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(mapping,
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(n_q_points_1d),
+                     additional_data);
+
+  VectorType src, dst, dst_ref;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  matrix_free.initialize_dof_vector(dst_ref);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  apply_operator<dim, fe_degree, n_q_points_1d>(matrix_free, dst_ref, src);
+  apply_operator<dim, -1, 0>(matrix_free, dst, src);
+
+  dst -= dst_ref;
+  deallog << fe.get_name() << " with " << n_q_points_1d
+          << " points: difference between templated and pre-compiled kernels "
+          << (dst.linfty_norm() < 1e-12 * dst_ref.linfty_norm() ? "OK" :
+                                                                  "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  print_supported<2>();
+  print_supported<3>();
+
+  test_overintegration<2, 7>();
+  test_overintegration<3, 8>();
+}
@@ -0,0 +1,243 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that PreconditionChebyshev with MatrixFreeOperators::LaplaceOperator,
+// which merges the vector updates of the Chebyshev iteration into the cell
+// loop, gives the same result as with the same operator wrapped into a class
+// that only provides the plain vmult() function. This is tested on the active
+// mesh with hanging node and Dirichlet constraints and on the finest
+// multigrid level with refinement edge indices, with and without thread
+// parallelism in the cell loop.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/multigrid/mg_constrained_dofs.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+
+// a wrapper around an operator that hides the vmult() function with
+// additional operations, such that PreconditionChebyshev applies the vector
+// updates separately from the matrix-vector product
+template <typename OperatorType>
+class PlainOperator : public Subscriptor
+{
+public:
+  using value_type = typename OperatorType::value_type;
+  using size_type  = typename OperatorType::size_type;
+
+  PlainOperator(const OperatorType &op)
+    : op(op)
+  {}
+
+  size_type
+  m() const
+  {
+    return op.m();
+  }
+
+  size_type
+  n() const
+  {
+    return op.n();
+  }
+
+  value_type
+  el(const size_type row, const size_type col) const
+  {
+    return op.el(row, col);
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+private:
+  const OperatorType &op;
+};
+
+
+
+template <typename OperatorType>
+void
+compare(const OperatorType &op, const std::string &name)
+{
+  using ChebyshevType =
+    PreconditionChebyshev<OperatorType, VectorType, DiagonalMatrix<VectorType>>;
+  using PlainChebyshevType = PreconditionChebyshev<PlainOperator<OperatorType>,
+                                                   VectorType,
+                                                   DiagonalMatrix<VectorType>>;
+
+  typename ChebyshevType::AdditionalData data;
+  data.preconditioner      = op.get_matrix_diagonal_inverse();
+  data.degree              = 4;
+  data.smoothing_range     = 20.;
+  data.eig_cg_n_iterations = 0;
+  data.max_eigenvalue      = 2.;
+
+  typename PlainChebyshevType::AdditionalData plain_data;
+  plain_data.preconditioner      = data.preconditioner;
+  plain_data.degree              = data.degree;
+  plain_data.smoothing_range     = data.smoothing_range;
+  plain_data.eig_cg_n_iterations = data.eig_cg_n_iterations;
+  plain_data.max_eigenvalue      = data.max_eigenvalue;
+
+  ChebyshevType chebyshev;
+  chebyshev.initialize(op, data);
+
+  const PlainOperator<OperatorType> plain_op(op);
+  PlainChebyshevType                plain_chebyshev;
+  plain_chebyshev.initialize(plain_op, plain_data);
+
+  VectorType src, dst, ref;
+  op.initialize_dof_vector(src);
+  op.initialize_dof_vector(dst);
+  op.initialize_dof_vector(ref);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    src.local_element(i) = random_value<double>();
+
+  chebyshev.vmult(dst, src);
+  plain_chebyshev.vmult(ref, src);
+  dst -= ref;
+  deallog << name << " vmult: "
+          << (dst.linfty_norm() < 1e-12 * ref.linfty_norm() ? "OK" : "FAILED")
+          << std::endl;
+
+  // step() with a non-zero initial guess
+  dst = ref;
+  chebyshev.step(dst, src);
+  plain_chebyshev.step(ref, src);
+  dst -= ref;
+  deallog << name << " step:  "
+          << (dst.linfty_norm() < 1e-12 * ref.linfty_norm() ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const typename MatrixFree<dim, double>::AdditionalData::TasksParallelScheme
+       scheme)
+{
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  dof.distribute_mg_dofs();
+
+  using LaplaceOperatorType = MatrixFreeOperators::
+    LaplaceOperator<dim, fe_degree, fe_degree + 1, 1, VectorType>;
+
+  const MappingQ1<dim> mapping;
+  const QGauss<1>      quad(fe_degree + 1);
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme = scheme;
+  additional_data.tasks_block_size      = 2;
+  additional_data.mapping_update_flags  = update_gradients | update_JxW_values;
+
+  // active mesh
+  {
+    AffineConstraints<double> constraints;
+    DoFTools::make_hanging_node_constraints(dof, constraints);
+    VectorTools::interpolate_boundary_values(dof,
+                                             0,
+                                             Functions::ZeroFunction<dim>(),
+                                             constraints);
+    constraints.close();
+
+    auto mf_data = std::make_shared<MatrixFree<dim, double>>();
+    mf_data->reinit(mapping, dof, constraints, quad, additional_data);
+
+    LaplaceOperatorType laplace;
+    laplace.initialize(mf_data);
+    laplace.compute_diagonal();
+
+    compare(laplace, "active");
+  }
+
+  // finest multigrid level, which contains refinement edges
+  {
+    MGConstrainedDoFs mg_constrained_dofs;
+    mg_constrained_dofs.initialize(dof);
+    mg_constrained_dofs.make_zero_boundary_constraints(dof, {0});
+
+    const unsigned int level = tria.n_global_levels() - 1;
+
+    AffineConstraints<double> level_constraints;
+    level_constraints.add_lines(
+      mg_constrained_dofs.get_boundary_indices(level));
+    level_constraints.close();
+
+    additional_data.mg_level = level;
+    auto mf_data             = std::make_shared<MatrixFree<dim, double>>();
+    mf_data->reinit(mapping, dof, level_constraints, quad, additional_data);
+
+    LaplaceOperatorType laplace;
+    laplace.initialize(mf_data, mg_constrained_dofs, level);
+    laplace.compute_diagonal();
+
+    compare(laplace, "level");
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog << "Serial cell loop" << std::endl;
+  test<2, 2>(MatrixFree<2, double>::AdditionalData::none);
+  test<3, 1>(MatrixFree<3, double>::AdditionalData::none);
+
+  deallog << "Threaded cell loop" << std::endl;
+  test<2, 2>(MatrixFree<2, double>::AdditionalData::partition_color);
+}
@@ -0,0 +1,166 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// The cell batches that read ghost data are processed as the ghost data of
+// the individual processes arrives. For DG elements, the indices of the cells
+// themselves are all locally owned, but a cell worker that accesses its face
+// neighbors through FEFaceEvaluation::reinit(cell, face) reads ghost data of
+// the neighbors. Check on four processes that MatrixFree::loop_cell_centric()
+// and MatrixFree::cell_loop() with such a cell worker give the same result as
+// when the ghost values of the source vector are updated before the loop.
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  using Number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+  using MF         = MatrixFree<dim, Number>;
+
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 5 : 3);
+
+  FE_DGQ<dim>     fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  MF mf_data;
+  {
+    typename MF::AdditionalData data;
+    data.tasks_parallel_scheme = MF::AdditionalData::none;
+    data.mapping_update_flags  = update_gradients | update_JxW_values;
+    data.mapping_update_flags_inner_faces    = update_JxW_values;
+    data.mapping_update_flags_boundary_faces = update_JxW_values;
+    data.mapping_update_flags_faces_by_cells = update_JxW_values;
+    data.hold_all_faces_to_owned_cells       = true;
+    // all lanes of a cell batch have the same kind of face (interior or
+    // boundary) at the same position
+    MatrixFreeTools::categorize_by_boundary_ids(tria, data);
+    mf_data.reinit(
+      MappingQ1<dim>{}, dof, constraints, QGauss<1>(fe_degree + 1), data);
+  }
+
+  const auto cell_operation = [](const MF         &data,
+                                 VectorType       &dst,
+                                 const VectorType &src,
+                                 const auto        cell_range) {
+    FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number>     phi(data);
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_m(data,
+                                                                     true);
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_p(data,
+                                                                     false);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src, EvaluationFlags::gradients);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          phi.submit_gradient(phi.get_gradient(q), q);
+        phi.integrate(EvaluationFlags::gradients);
+
+        for (const unsigned int face : GeometryInfo<dim>::face_indices())
+          {
+            phi_m.reinit(cell, face);
+            phi_m.gather_evaluate(src, EvaluationFlags::values);
+            if (data.get_faces_by_cells_boundary_id(cell, face)[0] ==
+                numbers::internal_face_boundary_id)
+              {
+                phi_p.reinit(cell, face);
+                phi_p.gather_evaluate(src, EvaluationFlags::values);
+                for (const unsigned int q : phi_m.quadrature_point_indices())
+                  phi_m.submit_value(0.7 * phi_m.get_value(q) -
+                                       0.4 * phi_p.get_value(q),
+                                     q);
+              }
+            else
+              for (const unsigned int q : phi_m.quadrature_point_indices())
+                phi_m.submit_value(1.23 * phi_m.get_value(q), q);
+            phi_m.integrate(EvaluationFlags::values);
+            for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+              phi.begin_dof_values()[i] += phi_m.begin_dof_values()[i];
+          }
+        phi.distribute_local_to_global(dst);
+      }
+  };
+
+  VectorType src, dst, dst_ref;
+  mf_data.initialize_dof_vector(src);
+  mf_data.initialize_dof_vector(dst);
+  mf_data.initialize_dof_vector(dst_ref);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    src.local_element(i) = random_value<double>();
+
+  // the ghost values are updated before the loop, so the loop does not
+  // communicate
+  src.update_ghost_values();
+  mf_data.template loop_cell_centric<VectorType, VectorType>(
+    cell_operation, dst_ref, src, true, MF::DataAccessOnFaces::values);
+  src.zero_out_ghost_values();
+  const double tolerance = 1e-12 * dst_ref.linfty_norm();
+
+  // the ghost exchange is interleaved with the cell work
+  mf_data.template loop_cell_centric<VectorType, VectorType>(
+    cell_operation, dst, src, true, MF::DataAccessOnFaces::values);
+  dst -= dst_ref;
+  deallog << "loop_cell_centric compared to ghost values updated before: "
+          << (dst.linfty_norm() < tolerance ? "OK" : "FAILED") << std::endl;
+
+  mf_data.template cell_loop<VectorType, VectorType>(cell_operation,
+                                                     dst,
+                                                     src,
+                                                     true);
+  dst -= dst_ref;
+  deallog << "cell_loop compared to ghost values updated before: "
+          << (dst.linfty_norm() < tolerance ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+
+  mpi_initlog();
+
+  test<2, 2>();
+  test<3, 2>();
+}
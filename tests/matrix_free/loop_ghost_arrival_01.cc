@@ -0,0 +1,271 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// In the serial schedule, MatrixFree::loop() runs the work on the cells
+// that read ghost data as the data from the individual processes arrives,
+// followed by the work on the faces and the operation after the loop. Check
+// on four processes, each of which receives ghost data from several other
+// processes, that a loop with cell, face and boundary work and with
+// operations before and after the loop gives the same result as when the
+// ghost values of the source vector are updated before the loop, and as the
+// same operations run one after the other.
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree, typename Number>
+class Operator
+{
+public:
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  Operator(const MatrixFree<dim, Number> &data)
+    : data(data)
+  {}
+
+  // run the loop, with the operation before the loop scaling the entries of
+  // the vector aux and setting dst to zero, and the operation after the
+  // loop adding aux to the result
+  void
+  vmult_merged(VectorType &dst, const VectorType &src, VectorType &aux) const
+  {
+    data.loop(
+      &Operator::local_cell,
+      &Operator::local_face,
+      &Operator::local_boundary,
+      this,
+      dst,
+      src,
+      [&](const unsigned int start_range, const unsigned int end_range) {
+        for (unsigned int i = start_range; i < end_range; ++i)
+          {
+            aux.local_element(i) *= 0.5;
+            dst.local_element(i) = 0;
+          }
+      },
+      [&](const unsigned int start_range, const unsigned int end_range) {
+        for (unsigned int i = start_range; i < end_range; ++i)
+          dst.local_element(i) += 1.3 * aux.local_element(i);
+      });
+  }
+
+  // the same operations one after the other
+  void
+  vmult_basic(VectorType &dst, const VectorType &src, VectorType &aux) const
+  {
+    aux *= 0.5;
+    dst = 0;
+    data.loop(&Operator::local_cell,
+              &Operator::local_face,
+              &Operator::local_boundary,
+              this,
+              dst,
+              src);
+    dst.add(1.3, aux);
+  }
+
+private:
+  void
+  local_cell(const MatrixFree<dim, Number>               &data,
+             VectorType                                  &dst,
+             const VectorType                            &src,
+             const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src,
+                            EvaluationFlags::values |
+                              EvaluationFlags::gradients);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          {
+            phi.submit_value(phi.get_value(q), q);
+            phi.submit_gradient(phi.get_gradient(q), q);
+          }
+        phi.integrate_scatter(EvaluationFlags::values |
+                                EvaluationFlags::gradients,
+                              dst);
+      }
+  }
+
+  void
+  local_face(const MatrixFree<dim, Number>               &data,
+             VectorType                                  &dst,
+             const VectorType                            &src,
+             const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_m(data,
+                                                                     true);
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_p(data,
+                                                                     false);
+    for (unsigned int face = face_range.first; face < face_range.second;
+         ++face)
+      {
+        phi_m.reinit(face);
+        phi_p.reinit(face);
+        phi_m.gather_evaluate(src, EvaluationFlags::values);
+        phi_p.gather_evaluate(src, EvaluationFlags::values);
+        for (const unsigned int q : phi_m.quadrature_point_indices())
+          {
+            const auto flux =
+              0.7 * phi_m.get_value(q) - 0.4 * phi_p.get_value(q);
+            phi_m.submit_value(flux, q);
+            phi_p.submit_value(-flux, q);
+          }
+        phi_m.integrate_scatter(EvaluationFlags::values, dst);
+        phi_p.integrate_scatter(EvaluationFlags::values, dst);
+      }
+  }
+
+  void
+  local_boundary(const MatrixFree<dim, Number>               &data,
+                 VectorType                                  &dst,
+                 const VectorType                            &src,
+                 const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data, true);
+    for (unsigned int face = face_range.first; face < face_range.second;
+         ++face)
+      {
+        phi.reinit(face);
+        phi.gather_evaluate(src, EvaluationFlags::values);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          phi.submit_value(1.23 * phi.get_value(q), q);
+        phi.integrate_scatter(EvaluationFlags::values, dst);
+      }
+  }
+
+  const MatrixFree<dim, Number> &data;
+};
+
+
+
+template <int dim, int fe_degree>
+void
+test(const FiniteElement<dim> &fe)
+{
+  using Number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 5 : 3);
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  MatrixFree<dim, Number> mf_data;
+  {
+    typename MatrixFree<dim, Number>::AdditionalData data;
+    data.tasks_parallel_scheme = MatrixFree<dim, Number>::AdditionalData::none;
+    data.mapping_update_flags  = update_gradients | update_JxW_values;
+    data.mapping_update_flags_inner_faces    = update_JxW_values;
+    data.mapping_update_flags_boundary_faces = update_JxW_values;
+    mf_data.reinit(
+      MappingQ1<dim>{}, dof, constraints, QGauss<1>(fe_degree + 1), data);
+  }
+
+  // the processes are arranged around the center of the cube, so each of
+  // them needs ghost data from more than one other process
+  const unsigned int n_ghost_targets =
+    mf_data.get_vector_partitioner()->ghost_targets().size();
+  deallog << "Ghost data from several processes on all processes: "
+          << (Utilities::MPI::min(n_ghost_targets, MPI_COMM_WORLD) > 1 ? "yes" :
+                                                                         "no")
+          << std::endl;
+
+  Operator<dim, fe_degree, Number> op(mf_data);
+
+  VectorType src, dst, aux;
+  mf_data.initialize_dof_vector(src);
+  mf_data.initialize_dof_vector(dst);
+  mf_data.initialize_dof_vector(aux);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    {
+      src.local_element(i) = random_value<double>();
+      aux.local_element(i) = random_value<double>();
+    }
+
+  // the ghost exchange is interleaved with the cell work
+  VectorType aux_merged = aux;
+  op.vmult_merged(dst, src, aux_merged);
+
+  // the ghost values are updated before the loop, so the loop does not
+  // communicate
+  VectorType dst_ghosts_before, aux_ghosts_before = aux;
+  dst_ghosts_before.reinit(dst);
+  src.update_ghost_values();
+  op.vmult_merged(dst_ghosts_before, src, aux_ghosts_before);
+  src.zero_out_ghost_values();
+
+  VectorType dst_basic, aux_basic = aux;
+  dst_basic.reinit(dst);
+  op.vmult_basic(dst_basic, src, aux_basic);
+
+  const double tolerance = 1e-12 * dst_basic.linfty_norm();
+
+  dst_ghosts_before -= dst;
+  deallog << "Compared to ghost values updated before the loop: "
+          << (dst_ghosts_before.linfty_norm() < tolerance ? "OK" : "FAILED")
+          << std::endl;
+
+  dst_basic -= dst;
+  aux_basic -= aux_merged;
+  deallog << "Compared to separate operations: "
+          << (dst_basic.linfty_norm() < tolerance &&
+                  aux_basic.linfty_norm() == 0. ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+
+  mpi_initlog();
+
+  test<2, 2>(FE_Q<2>(2));
+  test<2, 2>(FE_DGQ<2>(2));
+  test<3, 2>(FE_Q<3>(2));
+  test<3, 2>(FE_DGQ<3>(2));
+}
@@ -0,0 +1,291 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check MatrixFreeOperators::Base::vmult() with operations before and after
+// the product for an operator derived from Base that does not implement
+// apply_add_with_operations(), as well as MatrixFree::cell_loop() with
+// operations before and after the loop, on a mesh with hanging node and
+// Dirichlet constraints and on a multigrid level with refinement edges. The
+// results are compared to the ones of the operations run one after the
+// other, with the constrained entries of the destination set to the ones of
+// the source before the operation after the loop.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/multigrid/mg_constrained_dofs.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+
+template <int dim, int fe_degree>
+class HelmholtzOperator : public MatrixFreeOperators::Base<dim, VectorType>
+{
+public:
+  using Base = MatrixFreeOperators::Base<dim, VectorType>;
+
+  void
+  compute_diagonal() override
+  {
+    AssertThrow(false, ExcNotImplemented());
+  }
+
+  void
+  local_apply_cell(
+    const MatrixFree<dim, double>               &data,
+    VectorType                                  &dst,
+    const VectorType                            &src,
+    const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, fe_degree> phi(data);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src,
+                            EvaluationFlags::values |
+                              EvaluationFlags::gradients);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          {
+            phi.submit_value(0.3 * phi.get_value(q), q);
+            phi.submit_gradient(phi.get_gradient(q), q);
+          }
+        phi.integrate_scatter(EvaluationFlags::values |
+                                EvaluationFlags::gradients,
+                              dst);
+      }
+  }
+
+protected:
+  void
+  apply_add(VectorType &dst, const VectorType &src) const override
+  {
+    Base::data->cell_loop(&HelmholtzOperator::local_apply_cell,
+                          this,
+                          dst,
+                          src);
+  }
+};
+
+
+
+// the operation before the loop sets the destination to zero and scales
+// the auxiliary vector, the operation after the loop combines the result
+// with the auxiliary vector, reading the constrained entries of the result
+void
+operation_before(VectorType        &dst,
+                 VectorType        &aux,
+                 const unsigned int begin,
+                 const unsigned int end)
+{
+  for (unsigned int i = begin; i < end; ++i)
+    {
+      dst.local_element(i) = 0.;
+      aux.local_element(i) *= 0.5;
+    }
+}
+
+
+
+void
+operation_after(VectorType        &dst,
+                const VectorType  &aux,
+                const unsigned int begin,
+                const unsigned int end)
+{
+  for (unsigned int i = begin; i < end; ++i)
+    dst.local_element(i) =
+      0.63 * dst.local_element(i) - 1.3 * aux.local_element(i);
+}
+
+
+
+template <int dim, int fe_degree>
+void
+compare(const HelmholtzOperator<dim, fe_degree> &op,
+        const std::vector<unsigned int>         &constrained_dofs,
+        const std::string                       &name)
+{
+  VectorType src, aux, dst, ref, aux_ref;
+  op.initialize_dof_vector(src);
+  op.initialize_dof_vector(aux);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    {
+      src.local_element(i) = random_value<double>();
+      aux.local_element(i) = random_value<double>();
+    }
+  dst.reinit(src);
+  ref.reinit(src);
+  aux_ref = aux;
+
+  const unsigned int n = src.locally_owned_size();
+
+  // Base::vmult() with operations, which goes through the default
+  // implementation of apply_add_with_operations()
+  op.vmult(
+    dst,
+    src,
+    [&](const unsigned int begin, const unsigned int end) {
+      operation_before(dst, aux, begin, end);
+    },
+    [&](const unsigned int begin, const unsigned int end) {
+      operation_after(dst, aux, begin, end);
+    });
+
+  operation_before(ref, aux_ref, 0, n);
+  op.vmult(ref, src);
+  operation_after(ref, aux_ref, 0, n);
+
+  dst -= ref;
+  deallog << name << " Base::vmult with operations: "
+          << (dst.linfty_norm() < 1e-12 * ref.linfty_norm() ? "OK" : "FAILED")
+          << std::endl;
+
+  // MatrixFree::cell_loop() with operations
+  const MatrixFree<dim, double> &matrix_free = *op.get_matrix_free();
+  matrix_free.cell_loop(
+    &HelmholtzOperator<dim, fe_degree>::local_apply_cell,
+    &op,
+    dst,
+    src,
+    [&](const unsigned int begin, const unsigned int end) {
+      operation_before(dst, aux, begin, end);
+    },
+    [&](const unsigned int begin, const unsigned int end) {
+      operation_after(dst, aux, begin, end);
+    });
+
+  operation_before(ref, aux_ref, 0, n);
+  matrix_free.cell_loop(
+    &HelmholtzOperator<dim, fe_degree>::local_apply_cell, &op, ref, src);
+  for (const unsigned int i : constrained_dofs)
+    ref.local_element(i) = src.local_element(i);
+  operation_after(ref, aux_ref, 0, n);
+
+  dst -= ref;
+  deallog << name << " MatrixFree::cell_loop with operations: "
+          << (dst.linfty_norm() < 1e-12 * ref.linfty_norm() ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const typename MatrixFree<dim, double>::AdditionalData::TasksParallelScheme
+       scheme)
+{
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  dof.distribute_mg_dofs();
+
+  const MappingQ1<dim> mapping;
+  const QGauss<1>      quad(fe_degree + 1);
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme = scheme;
+  additional_data.tasks_block_size      = 2;
+  additional_data.mapping_update_flags =
+    update_values | update_gradients | update_JxW_values;
+
+  // active mesh
+  {
+    AffineConstraints<double> constraints;
+    DoFTools::make_hanging_node_constraints(dof, constraints);
+    VectorTools::interpolate_boundary_values(dof,
+                                             0,
+                                             Functions::ZeroFunction<dim>(),
+                                             constraints);
+    constraints.close();
+
+    auto mf_data = std::make_shared<MatrixFree<dim, double>>();
+    mf_data->reinit(mapping, dof, constraints, quad, additional_data);
+
+    HelmholtzOperator<dim, fe_degree> op;
+    op.initialize(mf_data);
+
+    compare(op, mf_data->get_constrained_dofs(), "active");
+  }
+
+  // finest multigrid level, which contains refinement edges
+  {
+    MGConstrainedDoFs mg_constrained_dofs;
+    mg_constrained_dofs.initialize(dof);
+    mg_constrained_dofs.make_zero_boundary_constraints(dof, {0});
+
+    const unsigned int level = tria.n_global_levels() - 1;
+
+    AffineConstraints<double> level_constraints;
+    level_constraints.add_lines(
+      mg_constrained_dofs.get_boundary_indices(level));
+    level_constraints.close();
+
+    additional_data.mg_level = level;
+    auto mf_data             = std::make_shared<MatrixFree<dim, double>>();
+    mf_data->reinit(mapping, dof, level_constraints, quad, additional_data);
+
+    HelmholtzOperator<dim, fe_degree> op;
+    op.initialize(mf_data, mg_constrained_dofs, level);
+
+    compare(op, mf_data->get_constrained_dofs(), "level");
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog << "Serial cell loop" << std::endl;
+  test<2, 2>(MatrixFree<2, double>::AdditionalData::none);
+  test<3, 1>(MatrixFree<3, double>::AdditionalData::none);
+
+  deallog << "Threaded cell loop" << std::endl;
+  test<2, 2>(MatrixFree<2, double>::AdditionalData::partition_color);
+}
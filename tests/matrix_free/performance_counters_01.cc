@@ -0,0 +1,152 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the counters of MatrixFreeTools::PerformanceCounters for a
+// cell_loop of a Laplace operator on a Cartesian mesh
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/performance_counters.h>
+
+#include "../tests.h"
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  using Number     = double;
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 3 : 2);
+
+  const FE_Q<dim> fe(fe_degree);
+  MappingQ<dim>   mapping(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<Number> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, Number>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, Number>::AdditionalData::none;
+  additional_data.mapping_update_flags = update_gradients;
+
+  MatrixFree<dim, Number> matrix_free;
+  matrix_free.reinit(mapping,
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     additional_data);
+
+  VectorType src, dst;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  src = 1.;
+
+  const auto cell_operation = [&](const auto &,
+                                  auto       &dst,
+                                  const auto &src,
+                                  const auto  range) {
+    FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(matrix_free);
+    for (unsigned int cell = range.first; cell < range.second; ++cell)
+      {
+        phi.reinit(cell);
+        phi.read_dof_values(src);
+        phi.evaluate(EvaluationFlags::gradients);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          phi.submit_gradient(phi.get_gradient(q), q);
+        phi.integrate(EvaluationFlags::gradients);
+        phi.distribute_local_to_global(dst);
+      }
+  };
+
+  // nothing is counted before the counters are enabled
+  matrix_free.template cell_loop<VectorType, VectorType>(cell_operation,
+                                                         dst,
+                                                         src,
+                                                         true);
+
+  MatrixFreeTools::PerformanceCounters::reset();
+  MatrixFreeTools::PerformanceCounters::enable();
+  const unsigned int n_loops = 3;
+  for (unsigned int i = 0; i < n_loops; ++i)
+    matrix_free.template cell_loop<VectorType, VectorType>(cell_operation,
+                                                         dst,
+                                                         src,
+                                                         true);
+  MatrixFreeTools::PerformanceCounters::disable();
+
+  // the counters of the kernels are per lane, so divide by the number of
+  // cells to get numbers independent of the SIMD width
+  using Phase         = MatrixFreeTools::PerformanceCounters::Phase;
+  const auto   data    = MatrixFreeTools::PerformanceCounters::get_data();
+  const double n_cells = n_loops * tria.n_active_cells();
+  deallog << fe.get_name() << std::endl;
+  for (unsigned int p = 0; p < MatrixFreeTools::PerformanceCounters::n_phases;
+       ++p)
+    {
+      const Phase phase = static_cast<Phase>(p);
+      deallog << MatrixFreeTools::PerformanceCounters::get_phase_name(phase);
+      if (phase == Phase::loop)
+        deallog << " calls: " << data[p].n_calls << std::endl;
+      else
+        deallog << " cells: "
+                << data[p].n_calls * VectorizedArray<Number>::size()
+                << " flops/cell: " << data[p].flops / n_cells
+                << " bytes/cell: " << data[p].bytes / n_cells << std::endl;
+    }
+
+  std::ostringstream report;
+  MatrixFreeTools::PerformanceCounters::print_report(report, 100., 10.);
+  deallog << "Report contains summary: "
+          << (report.str().find("sum of kernels") != std::string::npos ? "yes" :
+                                                                           "no")
+          << std::endl;
+
+  MatrixFreeTools::PerformanceCounters::reset();
+  const auto zero_data = MatrixFreeTools::PerformanceCounters::get_data();
+  double     sum       = 0;
+  for (const auto &d : zero_data)
+    sum += d.n_calls + d.flops + d.bytes + d.time;
+  deallog << "Sum after reset: " << sum << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>();
+  test<2, 3>();
+  test<3, 2>();
+}
@@ -0,0 +1,216 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test MatrixFreeTools::TensorProductBlockJacobi on meshes of rectangular
+// cells where the blocks cover the whole system: the preconditioner applied
+// to the result of the operator must give back the original vector
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// apply mass_factor * M + laplace_factor * L, with the terms of the
+// symmetric interior penalty method on the boundary for DG elements
+template <int dim>
+void
+apply_operator(const MatrixFree<dim, double> &matrix_free,
+               const double                   mass_factor,
+               const double                   laplace_factor,
+               const Point<dim>              &extent,
+               VectorType                    &dst,
+               const VectorType              &src)
+{
+  const FiniteElement<dim> &fe        = matrix_free.get_dof_handler().get_fe();
+  const unsigned int        fe_degree = fe.tensor_degree();
+  const bool                is_dg     = fe.n_dofs_per_vertex() == 0;
+  const EvaluationFlags::EvaluationFlags flags =
+    EvaluationFlags::values | EvaluationFlags::gradients;
+
+  matrix_free.template loop<VectorType, VectorType>(
+    [&](const auto &, auto &dst, const auto &src, const auto cells) {
+      FEEvaluation<dim, -1, 0, 1, double> phi(matrix_free);
+      for (unsigned int cell = cells.first; cell < cells.second; ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src, flags);
+          for (const unsigned int q : phi.quadrature_point_indices())
+            {
+              phi.submit_value(mass_factor * phi.get_value(q), q);
+              phi.submit_gradient(laplace_factor * phi.get_gradient(q), q);
+            }
+          phi.integrate_scatter(flags, dst);
+        }
+    },
+    [](const auto &, auto &, const auto &, const auto) {},
+    [&](const auto &, auto &dst, const auto &src, const auto faces) {
+      if (is_dg == false)
+        return;
+
+      FEFaceEvaluation<dim, -1, 0, 1, double> phi(matrix_free, true);
+      for (unsigned int face = faces.first; face < faces.second; ++face)
+        {
+          phi.reinit(face);
+          phi.gather_evaluate(src, flags);
+          double h = 0;
+          for (unsigned int d = 0; d < dim; ++d)
+            if (std::abs(phi.normal_vector(0)[d][0]) > 0.5)
+              h = extent[d];
+          const double sigma = 2. * (fe_degree + 1) * (fe_degree + 1) / h;
+          for (const unsigned int q : phi.quadrature_point_indices())
+            {
+              const auto value = phi.get_value(q);
+              phi.submit_value(laplace_factor *
+                                 (sigma * value - phi.get_normal_derivative(q)),
+                               q);
+              phi.submit_normal_derivative(-laplace_factor * value, q);
+            }
+          phi.integrate_scatter(flags, dst);
+        }
+    },
+    dst,
+    src,
+    true);
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe,
+     const unsigned int        n_refinements,
+     const typename MatrixFreeTools::TensorProductBlockJacobi<dim, double>::
+       AdditionalData::PatchType patch_type,
+     const double                mass_factor,
+     const double                laplace_factor)
+{
+  // a rectangle with different cell extents in each direction
+  Point<dim> upper_right;
+  for (unsigned int d = 0; d < dim; ++d)
+    upper_right[d] = 1. + 0.5 * d;
+  Triangulation<dim> tria;
+  GridGenerator::hyper_rectangle(tria, Point<dim>(), upper_right);
+  tria.refine_global(n_refinements);
+
+  Point<dim> extent;
+  for (unsigned int d = 0; d < dim; ++d)
+    extent[d] = upper_right[d] / (1 << n_refinements);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  if (fe.n_dofs_per_vertex() > 0)
+    DoFTools::make_zero_boundary_constraints(dof_handler, constraints);
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags =
+    update_values | update_gradients | update_JxW_values;
+  additional_data.mapping_update_flags_boundary_faces =
+    update_values | update_gradients | update_JxW_values |
+    update_normal_vectors;
+
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(MappingQ1<dim>(),
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe.degree + 1),
+                     additional_data);
+
+  MatrixFreeTools::TensorProductBlockJacobi<dim, double> block_jacobi;
+  block_jacobi.initialize(
+    matrix_free,
+    typename MatrixFreeTools::TensorProductBlockJacobi<dim, double>::
+      AdditionalData(patch_type, mass_factor, laplace_factor, 1., {0}));
+
+  VectorType solution, rhs, result;
+  matrix_free.initialize_dof_vector(solution);
+  matrix_free.initialize_dof_vector(rhs);
+  matrix_free.initialize_dof_vector(result);
+  for (unsigned int i = 0; i < solution.locally_owned_size(); ++i)
+    solution.local_element(i) = random_value<double>();
+  constraints.set_zero(solution);
+
+  apply_operator(matrix_free, mass_factor, laplace_factor, extent, rhs, solution);
+  block_jacobi.vmult(result, rhs);
+  result -= solution;
+
+  deallog << fe.get_name() << " "
+          << (patch_type == std::decay_t<decltype(patch_type)>::cell ?
+                "cell" :
+                "vertex patch")
+          << " blocks: " << block_jacobi.n_blocks() << ", error "
+          << (result.linfty_norm() < 1e-10 * solution.linfty_norm() ? "OK" :
+                                                                      "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  using PatchType = MatrixFreeTools::TensorProductBlockJacobi<2, double>::
+    AdditionalData::PatchType;
+  using PatchType3 = MatrixFreeTools::TensorProductBlockJacobi<3, double>::
+    AdditionalData::PatchType;
+
+  // DG mass matrix, exactly block diagonal
+  test<2>(FE_DGQ<2>(2), 2, PatchType::cell, 1., 0.);
+  test<3>(FE_DGQ<3>(3), 1, PatchType3::cell, 1., 0.);
+
+  // DG Helmholtz operator on a single cell with penalty terms on the
+  // boundary
+  test<2>(FE_DGQ<2>(3), 0, PatchType::cell, 0., 1.);
+  test<2>(FE_DGQ<2>(4), 0, PatchType::cell, 2., 1.);
+  test<3>(FE_DGQ<3>(2), 0, PatchType3::cell, 1., 1.);
+
+  // continuous elements on a single cell with Dirichlet boundary
+  test<2>(FE_Q<2>(4), 0, PatchType::cell, 0., 1.);
+  test<3>(FE_Q<3>(3), 0, PatchType3::cell, 1., 1.);
+
+  // continuous elements with a single vertex patch covering all unknowns
+  test<2>(FE_Q<2>(1), 1, PatchType::vertex_patch, 0., 1.);
+  test<2>(FE_Q<2>(3), 1, PatchType::vertex_patch, 0., 1.);
+  test<2>(FE_Q<2>(4), 1, PatchType::vertex_patch, 1., 1.);
+  test<3>(FE_Q<3>(2), 1, PatchType3::vertex_patch, 0., 1.);
+  test<3>(FE_Q<3>(3), 1, PatchType3::vertex_patch, 1., 2.);
+}
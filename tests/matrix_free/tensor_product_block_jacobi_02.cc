@@ -0,0 +1,392 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test MatrixFreeTools::TensorProductBlockJacobi with cell blocks on
+// tensor-product meshes with cells of different sizes, where the separable
+// approximation of the blocks is exact: The preconditioner must be the sum
+// over all cells of the inverses of the diagonal blocks of the assembled
+// operator. This checks the interior penalty terms on faces between cells
+// of different sizes for DG elements and the contribution of the neighbors
+// to the diagonal entries of the unknowns on the cell boundary for
+// continuous elements. Furthermore, check that the preconditioner reduces
+// the number of CG iterations.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// the operator mass_factor * M + laplace_factor * L, with the symmetric
+// interior penalty method on interior faces and on the boundary for DG
+// elements, using the penalty parameter (k+1)^2 (0.5/h^- + 0.5/h^+) on
+// interior faces and 2 (k+1)^2/h on boundary faces, with h the extent of
+// the cells normal to the face
+template <int dim>
+class Operator
+{
+public:
+  Operator(const MatrixFree<dim, double> &matrix_free,
+           const double                   mass_factor,
+           const double                   laplace_factor)
+    : matrix_free(matrix_free)
+    , mass_factor(mass_factor)
+    , laplace_factor(laplace_factor)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    const FiniteElement<dim> &fe = matrix_free.get_dof_handler().get_fe();
+    const double penalty = (fe.tensor_degree() + 1) * (fe.tensor_degree() + 1);
+    const bool   is_dg   = fe.n_dofs_per_vertex() == 0;
+    const EvaluationFlags::EvaluationFlags flags =
+      EvaluationFlags::values | EvaluationFlags::gradients;
+
+    // the extent normal to the face of the cells on either side of a batch
+    // of faces
+    const auto face_extent = [&](const unsigned int face, const bool interior) {
+      VectorizedArray<double> h = 1.;
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_face_batch(face);
+           ++v)
+        {
+          const auto cell_and_face =
+            matrix_free.get_face_iterator(face, v, interior);
+          h[v] =
+            cell_and_face.first->extent_in_direction(cell_and_face.second / 2);
+        }
+      return h;
+    };
+
+    matrix_free.template loop<VectorType, VectorType>(
+      [&](const auto &, auto &dst, const auto &src, const auto cells) {
+        FEEvaluation<dim, -1, 0, 1, double> phi(matrix_free);
+        for (unsigned int cell = cells.first; cell < cells.second; ++cell)
+          {
+            phi.reinit(cell);
+            phi.gather_evaluate(src, flags);
+            for (const unsigned int q : phi.quadrature_point_indices())
+              {
+                phi.submit_value(mass_factor * phi.get_value(q), q);
+                phi.submit_gradient(laplace_factor * phi.get_gradient(q), q);
+              }
+            phi.integrate_scatter(flags, dst);
+          }
+      },
+      [&](const auto &, auto &dst, const auto &src, const auto faces) {
+        if (is_dg == false)
+          return;
+
+        FEFaceEvaluation<dim, -1, 0, 1, double> phi_m(matrix_free, true);
+        FEFaceEvaluation<dim, -1, 0, 1, double> phi_p(matrix_free, false);
+        for (unsigned int face = faces.first; face < faces.second; ++face)
+          {
+            phi_m.reinit(face);
+            phi_p.reinit(face);
+            phi_m.gather_evaluate(src, flags);
+            phi_p.gather_evaluate(src, flags);
+            const VectorizedArray<double> sigma =
+              penalty * (0.5 / face_extent(face, true) +
+                         0.5 / face_extent(face, false));
+            for (const unsigned int q : phi_m.quadrature_point_indices())
+              {
+                const auto jump = phi_m.get_value(q) - phi_p.get_value(q);
+                const auto average_normal_derivative =
+                  0.5 * (phi_m.get_normal_derivative(q) +
+                         phi_p.get_normal_derivative(q));
+                const auto value_flux =
+                  laplace_factor * (sigma * jump - average_normal_derivative);
+                phi_m.submit_value(value_flux, q);
+                phi_p.submit_value(-value_flux, q);
+                phi_m.submit_normal_derivative(-0.5 * laplace_factor * jump,
+                                               q);
+                phi_p.submit_normal_derivative(-0.5 * laplace_factor * jump,
+                                               q);
+              }
+            phi_m.integrate_scatter(flags, dst);
+            phi_p.integrate_scatter(flags, dst);
+          }
+      },
+      [&](const auto &, auto &dst, const auto &src, const auto faces) {
+        if (is_dg == false)
+          return;
+
+        FEFaceEvaluation<dim, -1, 0, 1, double> phi(matrix_free, true);
+        for (unsigned int face = faces.first; face < faces.second; ++face)
+          {
+            phi.reinit(face);
+            phi.gather_evaluate(src, flags);
+            const VectorizedArray<double> sigma =
+              2. * penalty / face_extent(face, true);
+            for (const unsigned int q : phi.quadrature_point_indices())
+              {
+                const auto value = phi.get_value(q);
+                phi.submit_value(laplace_factor *
+                                   (sigma * value -
+                                    phi.get_normal_derivative(q)),
+                                 q);
+                phi.submit_normal_derivative(-laplace_factor * value, q);
+              }
+            phi.integrate_scatter(flags, dst);
+          }
+      },
+      dst,
+      src,
+      true);
+  }
+
+private:
+  const MatrixFree<dim, double> &matrix_free;
+  const double                   mass_factor;
+  const double                   laplace_factor;
+};
+
+
+
+template <int dim>
+void
+setup(const FiniteElement<dim>               &fe,
+      const std::vector<std::vector<double>> &step_sizes,
+      Triangulation<dim>                     &tria,
+      DoFHandler<dim>                        &dof_handler,
+      AffineConstraints<double>              &constraints,
+      MatrixFree<dim, double>                &matrix_free)
+{
+  Point<dim> upper_right;
+  for (unsigned int d = 0; d < dim; ++d)
+    for (const double step : step_sizes[d])
+      upper_right[d] += step;
+  GridGenerator::subdivided_hyper_rectangle(tria,
+                                            step_sizes,
+                                            Point<dim>(),
+                                            upper_right);
+
+  dof_handler.reinit(tria);
+  dof_handler.distribute_dofs(fe);
+
+  constraints.clear();
+  if (fe.n_dofs_per_vertex() > 0)
+    DoFTools::make_zero_boundary_constraints(dof_handler, constraints);
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags =
+    update_values | update_gradients | update_JxW_values;
+  additional_data.mapping_update_flags_inner_faces =
+    update_values | update_gradients | update_JxW_values |
+    update_normal_vectors;
+  additional_data.mapping_update_flags_boundary_faces =
+    additional_data.mapping_update_flags_inner_faces;
+  matrix_free.reinit(MappingQ1<dim>(),
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe.degree + 1),
+                     additional_data);
+}
+
+
+
+template <int dim>
+void
+test_blocks(const FiniteElement<dim>               &fe,
+            const std::vector<std::vector<double>> &step_sizes,
+            const double                            mass_factor,
+            const double                            laplace_factor)
+{
+  using BlockJacobi = MatrixFreeTools::TensorProductBlockJacobi<dim, double>;
+
+  Triangulation<dim>        tria;
+  DoFHandler<dim>           dof_handler;
+  AffineConstraints<double> constraints;
+  MatrixFree<dim, double>   matrix_free;
+  setup(fe, step_sizes, tria, dof_handler, constraints, matrix_free);
+
+  const Operator<dim> op(matrix_free, mass_factor, laplace_factor);
+  BlockJacobi         block_jacobi;
+  block_jacobi.initialize(matrix_free,
+                          typename BlockJacobi::AdditionalData(
+                            BlockJacobi::AdditionalData::PatchType::cell,
+                            mass_factor,
+                            laplace_factor,
+                            1.,
+                            {0}));
+
+  // assemble the operator and the preconditioner column by column
+  const unsigned int n_dofs = dof_handler.n_dofs();
+  FullMatrix<double> system_matrix(n_dofs, n_dofs);
+  FullMatrix<double> preconditioner(n_dofs, n_dofs);
+  VectorType         src, dst;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  for (unsigned int j = 0; j < n_dofs; ++j)
+    {
+      if (constraints.is_constrained(j))
+        continue;
+      src    = 0.;
+      src(j) = 1.;
+      op.vmult(dst, src);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        system_matrix(i, j) = dst(i);
+      block_jacobi.vmult(dst, src);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        preconditioner(i, j) = dst(i);
+    }
+
+  // the sum of the inverses of the diagonal blocks of the cells, without
+  // the constrained unknowns
+  FullMatrix<double>                   reference(n_dofs, n_dofs);
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(dof_indices);
+      std::vector<types::global_dof_index> block_indices;
+      for (const types::global_dof_index i : dof_indices)
+        if (constraints.is_constrained(i) == false)
+          block_indices.push_back(i);
+
+      FullMatrix<double> block(block_indices.size(), block_indices.size());
+      block.extract_submatrix_from(system_matrix, block_indices, block_indices);
+      block.gauss_jordan();
+      for (unsigned int i = 0; i < block_indices.size(); ++i)
+        for (unsigned int j = 0; j < block_indices.size(); ++j)
+          reference(block_indices[i], block_indices[j]) += block(i, j);
+    }
+
+  double max_entry = 0, max_error = 0;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    for (unsigned int j = 0; j < n_dofs; ++j)
+      {
+        max_entry = std::max(max_entry, std::abs(reference(i, j)));
+        max_error =
+          std::max(max_error, std::abs(preconditioner(i, j) - reference(i, j)));
+      }
+
+  deallog << fe.get_name() << " cell blocks: " << block_jacobi.n_blocks()
+          << ", comparison with the diagonal blocks of the operator "
+          << (max_error < 1e-10 * max_entry ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_solver(const FiniteElement<dim>               &fe,
+            const std::vector<std::vector<double>> &step_sizes,
+            const unsigned int                      min_iterations_identity,
+            const unsigned int                      max_iterations_identity,
+            const unsigned int                      min_iterations_jacobi,
+            const unsigned int                      max_iterations_jacobi)
+{
+  using BlockJacobi = MatrixFreeTools::TensorProductBlockJacobi<dim, double>;
+
+  Triangulation<dim>        tria;
+  DoFHandler<dim>           dof_handler;
+  AffineConstraints<double> constraints;
+  MatrixFree<dim, double>   matrix_free;
+  setup(fe, step_sizes, tria, dof_handler, constraints, matrix_free);
+
+  const Operator<dim> op(matrix_free, 0., 1.);
+  BlockJacobi         block_jacobi;
+  block_jacobi.initialize(matrix_free,
+                          typename BlockJacobi::AdditionalData(
+                            BlockJacobi::AdditionalData::PatchType::cell,
+                            0.,
+                            1.,
+                            1.,
+                            {0}));
+
+  VectorType solution, rhs;
+  matrix_free.initialize_dof_vector(solution);
+  matrix_free.initialize_dof_vector(rhs);
+  for (unsigned int i = 0; i < rhs.locally_owned_size(); ++i)
+    rhs.local_element(i) = random_value<double>();
+  constraints.set_zero(rhs);
+
+  deallog << fe.get_name() << " with " << tria.n_active_cells()
+          << " cells" << std::endl;
+
+  SolverControl        control(1000, 1e-10 * rhs.l2_norm());
+  SolverCG<VectorType> solver(control);
+
+  deallog << "Identity" << std::endl;
+  check_solver_within_range(solver.solve(op,
+                                         solution,
+                                         rhs,
+                                         PreconditionIdentity()),
+                            control.last_step(),
+                            min_iterations_identity,
+                            max_iterations_identity);
+
+  solution = 0.;
+  deallog << "Block Jacobi" << std::endl;
+  check_solver_within_range(solver.solve(op, solution, rhs, block_jacobi),
+                            control.last_step(),
+                            min_iterations_jacobi,
+                            max_iterations_jacobi);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const std::vector<std::vector<double>> steps_2d = {{0.3, 0.5, 0.2},
+                                                     {0.4, 0.25, 0.6}};
+  const std::vector<std::vector<double>> steps_3d = {{0.3, 0.5, 0.2},
+                                                     {0.4, 0.25},
+                                                     {0.7, 0.35}};
+
+  test_blocks<2>(FE_DGQ<2>(2), steps_2d, 0., 1.);
+  test_blocks<2>(FE_DGQ<2>(3), steps_2d, 1.5, 1.);
+  test_blocks<3>(FE_DGQ<3>(2), steps_3d, 1., 1.);
+  test_blocks<2>(FE_Q<2>(2), steps_2d, 0., 1.);
+  test_blocks<2>(FE_Q<2>(4), steps_2d, 2., 1.);
+  test_blocks<3>(FE_Q<3>(2), steps_3d, 1., 1.);
+
+  // graded meshes for the convergence check
+  std::vector<std::vector<double>> steps_graded(2);
+  for (unsigned int d = 0; d < 2; ++d)
+    for (unsigned int i = 0; i < 8; ++i)
+      steps_graded[d].push_back(std::pow(1.2 + 0.1 * d, i));
+
+  test_solver<2>(FE_DGQ<2>(4), steps_graded, 420, 460, 180, 200);
+  test_solver<2>(FE_Q<2>(4), steps_graded, 255, 280, 95, 105);
+}
@@ -0,0 +1,129 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark for the adaptive refinement and coarsening of a
+// large three-dimensional mesh. The cells close to a spherical front are
+// refined and the cells behind the front are coarsened as the front moves
+// through the domain, and the time spent in
+// Triangulation::execute_coarsening_and_refinement() is measured. The same
+// sequence of adaptation steps runs with a single thread and with all
+// threads, which shows the gain of the parts of the refinement that run in
+// parallel, i.e., the setup of the neighbor links and of the vertex index
+// cache of the cells.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+
+/**
+ * Run the adaptation steps on a mesh with the given number of global
+ * refinements and return the accumulated wall time of the refinement and
+ * coarsening steps, respectively.
+ */
+std::pair<double, double>
+run(const unsigned int n_global_refinements, const unsigned int n_threads)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  Triangulation<3> triangulation;
+  GridGenerator::hyper_cube(triangulation, -1., 1.);
+  triangulation.refine_global(n_global_refinements);
+
+  Timer  timer;
+  double time_refine  = 0;
+  double time_coarsen = 0;
+
+  constexpr unsigned int n_steps = 4;
+  for (unsigned int step = 0; step < n_steps; ++step)
+    {
+      // refine the cells close to a spherical front around the origin
+      const double radius = 0.3 + 0.2 * step;
+      for (const auto &cell : triangulation.active_cell_iterators())
+        if (std::abs(cell->center().norm() - radius) < cell->diameter())
+          cell->set_refine_flag();
+
+      timer.restart();
+      triangulation.execute_coarsening_and_refinement();
+      time_refine += timer.wall_time();
+
+      // coarsen the cells the front has passed
+      for (const auto &cell : triangulation.active_cell_iterators())
+        if (cell->level() > static_cast<int>(n_global_refinements) &&
+            cell->center().norm() < radius - 0.1)
+          cell->set_coarsen_flag();
+
+      timer.restart();
+      triangulation.execute_coarsening_and_refinement();
+      time_coarsen += timer.wall_time();
+
+      debug_output << "Step " << step << " with " << n_threads
+                   << " thread(s): " << triangulation.n_active_cells()
+                   << " cells" << std::endl;
+    }
+
+  MultithreadInfo::set_thread_limit();
+
+  return {time_refine, time_coarsen};
+}
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"refine (1 thread)",
+           "coarsen (1 thread)",
+           "refine (all threads)",
+           "coarsen (all threads)"}};
+}
+
+
+Measurement
+perform_single_measurement()
+{
+  unsigned int n_global_refinements = 5;
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        break;
+      case TestingEnvironment::medium:
+        n_global_refinements += 1;
+        break;
+      case TestingEnvironment::heavy:
+        n_global_refinements += 2;
+        break;
+    }
+
+  const auto serial   = run(n_global_refinements, 1);
+  const auto parallel = run(n_global_refinements, MultithreadInfo::n_cores());
+
+  return {serial.first, serial.second, parallel.first, parallel.second};
+}
@@ -0,0 +1,179 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that FEEvaluation on simplex meshes with QGaussCollapsedSimplex,
+// where the gradients are computed by sum factorization in the collapsed
+// coordinates, gives the same result as a matrix-based operator assembled
+// with FEValues and the same quadrature formula.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_simplex_p_bubbles.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe, const unsigned int n_points_1d)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube_with_simplices(tria, dim == 2 ? 4 : 2);
+  GridTools::distort_random(0.1, tria, false);
+
+  MappingFE<dim>                    mapping(FE_SimplexP<dim>(1));
+  const QGaussCollapsedSimplex<dim> quad(n_points_1d);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_gradients | update_values;
+
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(mapping, dof_handler, constraints, quad, additional_data);
+
+  deallog << fe.get_name() << " with " << n_points_1d
+          << " points per direction, sum factorization: "
+          << (matrix_free.get_shape_info().n_q_points_1d_collapsed > 0 ? "yes" :
+                                                                         "no")
+          << std::endl;
+
+  // matrix-based reference operator assembled with FEValues
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+  SparseMatrix<double> laplace_matrix(sparsity_pattern);
+  SparseMatrix<double> mass_matrix(sparsity_pattern);
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          quad,
+                          update_values | update_gradients |
+                            update_JxW_values);
+  FullMatrix<double> cell_laplace(fe.n_dofs_per_cell(), fe.n_dofs_per_cell());
+  FullMatrix<double> cell_mass(fe.n_dofs_per_cell(), fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell_laplace = 0;
+      cell_mass    = 0;
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (const unsigned int i : fe_values.dof_indices())
+          for (const unsigned int j : fe_values.dof_indices())
+            {
+              cell_laplace(i, j) += fe_values.shape_grad(i, q) *
+                                    fe_values.shape_grad(j, q) *
+                                    fe_values.JxW(q);
+              cell_mass(i, j) += fe_values.shape_value(i, q) *
+                                 fe_values.shape_value(j, q) * fe_values.JxW(q);
+            }
+      cell->get_dof_indices(dof_indices);
+      constraints.distribute_local_to_global(cell_laplace,
+                                             dof_indices,
+                                             laplace_matrix);
+      constraints.distribute_local_to_global(cell_mass,
+                                             dof_indices,
+                                             mass_matrix);
+    }
+
+  Vector<double> src(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  for (const EvaluationFlags::EvaluationFlags flags :
+       {EvaluationFlags::gradients,
+        EvaluationFlags::values | EvaluationFlags::gradients})
+    {
+      Vector<double> dst(dof_handler.n_dofs()), dst_ref(dof_handler.n_dofs());
+      matrix_free.template cell_loop<Vector<double>, Vector<double>>(
+        [&](const auto &, auto &dst, const auto &src, const auto cells) {
+          FEEvaluation<dim, -1, 0, 1, double> phi(matrix_free);
+          for (unsigned int cell = cells.first; cell < cells.second; ++cell)
+            {
+              phi.reinit(cell);
+              phi.gather_evaluate(src, flags);
+              for (const unsigned int q : phi.quadrature_point_indices())
+                {
+                  if (flags & EvaluationFlags::values)
+                    phi.submit_value(phi.get_value(q), q);
+                  phi.submit_gradient(phi.get_gradient(q), q);
+                }
+              phi.integrate_scatter(flags, dst);
+            }
+        },
+        dst,
+        src,
+        true);
+
+      laplace_matrix.vmult(dst_ref, src);
+      if (flags & EvaluationFlags::values)
+        mass_matrix.vmult_add(dst_ref, src);
+
+      const double norm = dst_ref.l2_norm();
+      dst_ref -= dst;
+      deallog << (flags & EvaluationFlags::values ? "Helmholtz" : "Laplace")
+              << " operator: relative error "
+              << (dst_ref.l2_norm() < 1e-12 * norm ? "OK" : "FAILED")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    {
+      test<2>(FE_SimplexP<2>(degree), degree + 1);
+      test<3>(FE_SimplexP<3>(degree), degree + 1);
+    }
+
+  // the bubble enrichment increases the polynomial degree, so we need more
+  // points per direction for sum factorization
+  test<2>(FE_SimplexP_Bubbles<2>(2), 3);
+  test<2>(FE_SimplexP_Bubbles<2>(2), 4);
+  test<3>(FE_SimplexP_Bubbles<3>(2), 4);
+  test<3>(FE_SimplexP_Bubbles<3>(2), 5);
+
+  // too few points per direction for sum factorization
+  test<2>(FE_SimplexP<2>(2), 2);
+}